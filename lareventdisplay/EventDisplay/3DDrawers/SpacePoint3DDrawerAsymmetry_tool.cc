@@ -6,6 +6,7 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/ISpacePoints3D.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 
@@ -16,6 +17,8 @@
 #include "TMath.h"
 #include "TPolyMarker3D.h"
 
+#include <limits>
+
 namespace evdb_tool {
 
   class SpacePoint3DDrawerHitAsymmetry : public ISpacePoints3D {
@@ -68,25 +71,31 @@ namespace evdb_tool {
     // Get services.
     art::ServiceHandle<evd::ColorDrawingOptions const> cst;
 
-    using HitPosition = std::array<double, 6>;
+    using HitPosition = std::array<double, 3>;
     std::map<int, std::vector<HitPosition>> colorToHitMap;
 
     // Get the scale factor
     float asymmetryScale((cst->fRecoQHigh[geo::kCollection] - cst->fRecoQLow[geo::kCollection]) /
                          (fMaxAsymmetry - fMinAsymmetry));
 
+    // Space points sharing a cell of the view are merged, averaging their
+    // asymmetry; those out of range are skipped
+    std::vector<float> hitAsymmetryVec;
+    hitAsymmetryVec.reserve(hitsVec.size());
+
     for (const auto& spacePoint : hitsVec) {
       float hitAsymmetry = spacePoint->ErrXYZ()[3] - fMinAsymmetry;
 
-      if (std::abs(hitAsymmetry) <= fMaxAsymmetry - fMinAsymmetry) {
-        float chgFactor = cst->fRecoQLow[geo::kCollection] + asymmetryScale * hitAsymmetry;
-        int chargeColorIdx = cst->CalQ(geo::kCollection).GetColor(chgFactor);
-        const double* pos = spacePoint->XYZ();
-        const double* err = spacePoint->ErrXYZ();
+      hitAsymmetryVec.push_back(std::abs(hitAsymmetry) <= fMaxAsymmetry - fMinAsymmetry ?
+                                  hitAsymmetry :
+                                  std::numeric_limits<float>::quiet_NaN());
+    }
+
+    for (const auto& point : evd::SpacePointLOD::Instance().Decimate(hitsVec, hitAsymmetryVec)) {
+      float chgFactor = cst->fRecoQLow[geo::kCollection] + asymmetryScale * point.value;
+      int chargeColorIdx = cst->CalQ(geo::kCollection).GetColor(chgFactor);
 
-        colorToHitMap[chargeColorIdx].push_back(
-          HitPosition() = {{pos[0], pos[1], pos[2], err[2], err[2], err[5]}});
-      }
+      colorToHitMap[chargeColorIdx].push_back(HitPosition() = {{point.x, point.y, point.z}});
     }
 
     for (auto& hitPair : colorToHitMap) {
@@ -6,6 +6,7 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/ISpacePoints3D.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 
@@ -60,7 +61,7 @@ namespace evdb_tool {
     // Get services.
     art::ServiceHandle<evd::ColorDrawingOptions const> cst;
 
-    using HitPosition = std::array<double, 6>;
+    using HitPosition = std::array<double, 3>;
     std::map<int, std::vector<HitPosition>> colorToHitMap;
 
     float minHitChiSquare(0.);
@@ -68,21 +69,24 @@ namespace evdb_tool {
     float hitChiSqScale((cst->fRecoQHigh[geo::kCollection] - cst->fRecoQLow[geo::kCollection]) /
                         (maxHitChiSquare - minHitChiSquare));
 
-    for (const auto& spacePoint : hitsVec) {
-      const double* pos = spacePoint->XYZ();
-      const double* err = spacePoint->ErrXYZ();
+    // Space points sharing a cell of the view are merged, averaging their chi square
+    std::vector<float> hitChiSqVec;
+    hitChiSqVec.reserve(hitsVec.size());
 
-      int chargeColorIdx(0);
+    for (const auto& spacePoint : hitsVec) {
       float spacePointChiSq(spacePoint->Chisq());
 
-      float hitChiSq = std::max(minHitChiSquare, std::min(maxHitChiSquare, spacePointChiSq));
+      hitChiSqVec.push_back(std::max(minHitChiSquare, std::min(maxHitChiSquare, spacePointChiSq)));
+    }
+
+    for (const auto& point : evd::SpacePointLOD::Instance().Decimate(hitsVec, hitChiSqVec)) {
+      int chargeColorIdx(0);
 
-      float chgFactor = cst->fRecoQHigh[geo::kCollection] - hitChiSqScale * hitChiSq;
+      float chgFactor = cst->fRecoQHigh[geo::kCollection] - hitChiSqScale * point.value;
 
       chargeColorIdx = cst->CalQ(geo::kCollection).GetColor(chgFactor);
 
-      colorToHitMap[chargeColorIdx].push_back(
-        HitPosition() = {{pos[0], pos[1], pos[2], err[3], err[3], err[5]}});
+      colorToHitMap[chargeColorIdx].push_back(HitPosition() = {{point.x, point.y, point.z}});
     }
 
     for (auto& hitPair : colorToHitMap) {
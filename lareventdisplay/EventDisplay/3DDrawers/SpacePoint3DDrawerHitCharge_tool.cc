@@ -7,6 +7,7 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/ISpacePoints3D.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 
@@ -17,6 +18,8 @@
 #include "TMath.h"
 #include "TPolyMarker3D.h"
 
+#include <limits>
+
 namespace evdb_tool {
 
   class SpacePoint3DDrawerHitCharge : public ISpacePoints3D {
@@ -75,7 +78,7 @@ namespace evdb_tool {
     // Get services.
     art::ServiceHandle<evd::ColorDrawingOptions const> cst;
 
-    using HitPosition = std::array<double, 6>;
+    using HitPosition = std::array<double, 3>;
     std::map<int, std::vector<HitPosition>> colorToHitMap;
 
     float minHitCharge(std::numeric_limits<float>::max());
@@ -102,18 +105,23 @@ namespace evdb_tool {
       float hitChiSqScale((cst->fRecoQHigh[geo::kCollection] - cst->fRecoQLow[geo::kCollection]) /
                           (maxHitCharge - minHitCharge));
 
+      // Space points sharing a cell of the view are merged, averaging their
+      // charge; those without charge are skipped
+      std::vector<float> hitChargeVec;
+      hitChargeVec.reserve(hitsVec.size());
+
       for (const auto& spacePoint : hitsVec) {
         float hitCharge = getSpacePointCharge(spacePoint, hitAssnVec);
 
-        if (hitCharge > 0.) {
-          float chgFactor = cst->fRecoQLow[geo::kCollection] + hitChiSqScale * hitCharge;
-          int chargeColorIdx = cst->CalQ(geo::kCollection).GetColor(chgFactor);
-          const double* pos = spacePoint->XYZ();
-          const double* err = spacePoint->ErrXYZ();
+        hitChargeVec.push_back(hitCharge > 0. ? hitCharge :
+                                                std::numeric_limits<float>::quiet_NaN());
+      }
+
+      for (const auto& point : evd::SpacePointLOD::Instance().Decimate(hitsVec, hitChargeVec)) {
+        float chgFactor = cst->fRecoQLow[geo::kCollection] + hitChiSqScale * point.value;
+        int chargeColorIdx = cst->CalQ(geo::kCollection).GetColor(chgFactor);
 
-          colorToHitMap[chargeColorIdx].push_back(
-            HitPosition() = {{pos[0], pos[1], pos[2], err[3], err[3], err[5]}});
-        }
+        colorToHitMap[chargeColorIdx].push_back(HitPosition() = {{point.x, point.y, point.z}});
       }
 
       for (auto& hitPair : colorToHitMap) {
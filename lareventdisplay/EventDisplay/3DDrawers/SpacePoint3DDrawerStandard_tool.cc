@@ -6,6 +6,7 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/ISpacePoints3D.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 
@@ -67,33 +68,30 @@ namespace evdb_tool {
     // having a single collection with color inherited from the prong
     // (specified by the argument color).
 
-    std::map<int, std::vector<const recob::SpacePoint*>> spmap; // Indexed by color.
-    int spcolor = color;
+    // Space points sharing a cell of the view are merged, averaging their
+    // chi square; the map is indexed by color.
+    std::vector<float> chisq(spts.size(), 0.f);
+    if (recoOpt->fColorSpacePointsByChisq) {
+      for (size_t s = 0; s < spts.size(); ++s)
+        chisq[s] = spts[s]->Chisq();
+    }
 
-    for (auto& pspt : spts) {
-      //std::cout<<pspt<<std::endl;
-      //if(pspt == 0) throw cet::exception("RecoBaseDrawer:DrawSpacePoint3D") << "space point is null\n";
+    std::map<int, std::vector<evd::SpacePointLOD::Point_t>> spmap;
+    int spcolor = color;
 
+    for (auto const& point : evd::SpacePointLOD::Instance().Decimate(spts, chisq)) {
       // For rainbow effect, choose root colors in range [51,100].
       // We are using 100=best (red), 51=worst (blue).
-
-      //        if (pspt->Chisq() > -100.) continue;
-
-      spcolor = 12;
-
-      if (pspt->Chisq() < -100.) spcolor = 16;
-
       if (recoOpt->fColorSpacePointsByChisq) {
-        spcolor = 100 - 2.5 * pspt->Chisq();
+        spcolor = 100 - 2.5 * point.value;
 
         if (spcolor < 51) spcolor = 51;
         if (spcolor > 100) spcolor = 100;
       }
       else
         spcolor = color;
-      //if (pspt->Chisq() < -1.) spcolor += 6;
 
-      spmap[spcolor].push_back(&*pspt);
+      spmap[spcolor].push_back(point);
     }
 
     // Loop over colors.
@@ -106,12 +104,8 @@ namespace evdb_tool {
 
       TPolyMarker3D& pm = view->AddPolyMarker3D(psps.size(), spcolor, marker, size);
 
-      for (size_t s = 0; s < psps.size(); ++s) {
-        const recob::SpacePoint& spt = *psps[s];
-
-        const double* xyz = spt.XYZ();
-        pm.SetPoint(s, xyz[0], xyz[1], xyz[2]);
-      }
+      for (size_t s = 0; s < psps.size(); ++s)
+        pm.SetPoint(s, psps[s].x, psps[s].y, psps[s].z);
     }
 
     return;
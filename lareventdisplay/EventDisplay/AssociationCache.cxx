@@ -0,0 +1,37 @@
+/**
+ * @file   AssociationCache.cxx
+ * @brief  Per-event cache of the association finders used by the drawers
+ * @see    AssociationCache.h
+ */
+
+#include "lareventdisplay/EventDisplay/AssociationCache.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  AssociationCache& AssociationCache::Instance()
+  {
+    static AssociationCache cache;
+    return cache;
+  } // AssociationCache::Instance()
+
+  //----------------------------------------------------------------------------
+  void AssociationCache::Clear()
+  {
+    fEntries.clear();
+    fEvent.clear();
+  } // AssociationCache::Clear()
+
+  //----------------------------------------------------------------------------
+  void AssociationCache::UpdateEvent(art::Event const& evt)
+  {
+    if (!fEvent.update(util::EventChangeTracker_t(evt))) return;
+    MF_LOG_DEBUG("AssociationCache")
+      << "Dropping " << fEntries.size() << " association finders for " << fEvent;
+    fEntries.clear();
+  } // AssociationCache::UpdateEvent()
+
+} // namespace evd
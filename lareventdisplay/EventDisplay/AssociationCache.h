@@ -0,0 +1,182 @@
+/**
+ * @file   AssociationCache.h
+ * @brief  Per-event cache of the association finders used by the drawers
+ * @see    AssociationCache.cxx
+ *
+ * Several drawers (`RecoBaseDrawer::Cluster2D()`, `Prong2D()`,
+ * `PFParticle3D()`...) look up the same associations for each plane and view
+ * they draw, and `art::FindMany` and `art::FindManyP` scan the whole
+ * association each time they are constructed. `AssociationCache` builds each
+ * finder once per event, for the whole source data product, and shares it.
+ */
+
+#ifndef EVD_ASSOCIATIONCACHE_H
+#define EVD_ASSOCIATIONCACHE_H
+
+// LArSoft libraries
+#include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::EventChangeTracker_t
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/FindMany.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <memory> // std::unique_ptr
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <utility> // std::forward(), std::move()
+#include <vector>
+
+namespace evd {
+
+  /**
+   * @brief Shares association finders among drawers for the current event
+   *
+   * Each finder covers a whole `std::vector<Source>` data product, and it is
+   * looked up by the key of the source element (`art::Ptr::key()` or the
+   * index in the collection), exactly as a finder built from a collection of
+   * pointers to all the elements of the product in order.
+   *
+   * Finders are identified by their type (which includes the associated
+   * type), by the source data product and by the input tag of the
+   * association. The source product can be specified either by its input tag
+   * or by its product ID (e.g. from an `art::Ptr`): both resolve to the same
+   * finder. All the finders are dropped when the event changes, and a finder
+   * is rebuilt if its source data product is reloaded.
+   *
+   * Example:
+   *
+   *     auto const& hitAssns
+   *       = AssociationCache::FindMany<recob::Cluster, recob::Hit>(evt, which, which);
+   *     std::vector<recob::Hit const*> hits = hitAssns.at(cluster.key());
+   *
+   * The cache is meant to be used by the drawers in the main thread only.
+   */
+  class AssociationCache {
+  public:
+    /// Returns a `art::FindManyP<Target>` for all the `Source` in `sourceTag`
+    template <typename Source, typename Target>
+    static art::FindManyP<Target> const& FindManyP(art::Event const& evt,
+                                                   art::InputTag const& sourceTag,
+                                                   art::InputTag const& assnsTag)
+    {
+      return Instance().Get<art::FindManyP<Target>>(
+        evt, evt.getHandle<std::vector<Source>>(sourceTag), assnsTag);
+    }
+
+    /// Returns a `art::FindManyP<Target>` for all the `Source` in `sourceID`
+    template <typename Source, typename Target>
+    static art::FindManyP<Target> const& FindManyP(art::Event const& evt,
+                                                   art::ProductID const& sourceID,
+                                                   art::InputTag const& assnsTag)
+    {
+      return Instance().Get<art::FindManyP<Target>>(
+        evt, GetHandle<Source>(evt, sourceID), assnsTag);
+    }
+
+    /// Returns a `art::FindMany<Target>` for all the `Source` in `sourceTag`
+    template <typename Source, typename Target>
+    static art::FindMany<Target> const& FindMany(art::Event const& evt,
+                                                 art::InputTag const& sourceTag,
+                                                 art::InputTag const& assnsTag)
+    {
+      return Instance().Get<art::FindMany<Target>>(
+        evt, evt.getHandle<std::vector<Source>>(sourceTag), assnsTag);
+    }
+
+    /// Returns a `art::FindMany<Target>` for all the `Source` in `sourceID`
+    template <typename Source, typename Target>
+    static art::FindMany<Target> const& FindMany(art::Event const& evt,
+                                                 art::ProductID const& sourceID,
+                                                 art::InputTag const& assnsTag)
+    {
+      return Instance().Get<art::FindMany<Target>>(
+        evt, GetHandle<Source>(evt, sourceID), assnsTag);
+    }
+
+    /// Removes all the cached finders
+    void Clear();
+
+    /// Returns the cache instance shared by all drawers
+    static AssociationCache& Instance();
+
+  private:
+    /// Base of the cached finders, recording the source they were built from
+    struct EntryBase_t {
+      void const* source = nullptr; ///< address of the source data product
+
+      virtual ~EntryBase_t() = default;
+    }; // EntryBase_t
+
+    /// A cached finder
+    template <typename Finder>
+    struct Entry_t : EntryBase_t {
+      Finder finder;
+
+      template <typename... Args>
+      Entry_t(Args&&... args) : finder(std::forward<Args>(args)...)
+      {}
+    }; // Entry_t
+
+    /// Finder type, source product and association tag
+    using Key_t = std::tuple<std::type_index, art::ProductID, std::string>;
+
+    util::EventChangeTracker_t fEvent;                      ///< event of the finders
+    std::map<Key_t, std::unique_ptr<EntryBase_t>> fEntries; ///< cached finders
+
+    /// Drops all the finders if `evt` is not the cached event
+    void UpdateEvent(art::Event const& evt);
+
+    /// Returns the cached finder, building it first if needed
+    template <typename Finder, typename Source>
+    Finder const& Get(art::Event const& evt,
+                      art::Handle<std::vector<Source>> const& sources,
+                      art::InputTag const& assnsTag);
+
+    /// Returns a handle to the source product with the specified ID
+    template <typename Source>
+    static art::Handle<std::vector<Source>> GetHandle(art::Event const& evt,
+                                                      art::ProductID const& sourceID)
+    {
+      art::Handle<std::vector<Source>> handle;
+      if (sourceID.isValid()) evt.get(sourceID, handle);
+      return handle;
+    }
+
+  }; // class AssociationCache
+
+} // namespace evd
+
+//------------------------------------------------------------------------------
+template <typename Finder, typename Source>
+Finder const& evd::AssociationCache::Get(art::Event const& evt,
+                                         art::Handle<std::vector<Source>> const& sources,
+                                         art::InputTag const& assnsTag)
+{
+  UpdateEvent(evt);
+
+  bool const valid = sources.isValid();
+  void const* sourceProduct = valid ? sources.product() : nullptr;
+  Key_t key{std::type_index(typeid(Finder)),
+            valid ? sources.id() : art::ProductID(),
+            assnsTag.encode()};
+
+  auto& entry = fEntries[std::move(key)];
+  if (!entry || (entry->source != sourceProduct)) {
+    // the finder of a missing source product is built on an empty collection
+    entry = valid ? std::make_unique<Entry_t<Finder>>(sources, evt, assnsTag) :
+                    std::make_unique<Entry_t<Finder>>(
+                      std::vector<art::Ptr<Source>>{}, evt, assnsTag);
+    entry->source = sourceProduct;
+  }
+  return static_cast<Entry_t<Finder> const&>(*entry).finder;
+} // evd::AssociationCache::Get()
+
+#endif // EVD_ASSOCIATIONCACHE_H
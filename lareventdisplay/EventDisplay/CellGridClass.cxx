@@ -0,0 +1,119 @@
+/**
+ * @file   CellGridClass.cxx
+ * @brief  Division of the (wire, tick) space into cells matching the pad
+ * @author Gianluca Petrillo (petrillo@fnal.gov)
+ * @date   August 19th, 2015
+ * @see    CellGridClass.h
+ */
+
+#include "lareventdisplay/EventDisplay/CellGridClass.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <cmath>     // std::isnormal(), std::floor(), std::ceil()
+
+namespace evd {
+  namespace details {
+
+    //--------------------------------------------------------------------------
+    //--- GridAxisClass
+    //---
+    std::ptrdiff_t GridAxisClass::GetCell(float coord) const
+    {
+      return std::ptrdiff_t((coord - min) / cell_size); // truncate
+    }                                                   // GridAxisClass::GetCell()
+
+    //--------------------------------------------------------------------------
+    bool GridAxisClass::Init(size_t nDiv, float new_min, float new_max)
+    {
+
+      n_cells = std::max(nDiv, size_t(1));
+      return SetLimits(new_min, new_max);
+
+    } // GridAxisClass::Init()
+
+    //--------------------------------------------------------------------------
+    bool GridAxisClass::SetLimits(float new_min, float new_max)
+    {
+      min = new_min;
+      max = new_max;
+      cell_size = Length() / float(n_cells);
+
+      return std::isnormal(cell_size);
+    } // GridAxisClass::SetLimits()
+
+    //--------------------------------------------------------------------------
+    bool GridAxisClass::SetMinCellSize(float min_size)
+    {
+      if (cell_size >= min_size) return false;
+
+      // n_cells gets truncated
+      n_cells = (size_t)std::max(std::floor(Length() / min_size), 1.0F);
+
+      // reevaluate cell size, that might be different than min_size
+      // because of n_cells truncation or minimum value
+      cell_size = Length() / float(n_cells);
+      return true;
+    } // GridAxisClass::SetMinCellSize()
+
+    //--------------------------------------------------------------------------
+    bool GridAxisClass::SetMaxCellSize(float max_size)
+    {
+      if (cell_size <= max_size) return false;
+
+      // n_cells gets rounded up
+      n_cells = (size_t)std::max(std::ceil(Length() / max_size), 1.0F);
+
+      // reevaluate cell size, that might be different than max_size
+      // because of n_cells rounding or minimum value
+      cell_size = Length() / float(n_cells);
+      return true;
+    } // GridAxisClass::SetMaxCellSize()
+
+    //--------------------------------------------------------------------------
+    //--- CellGridClass
+    //---
+    CellGridClass::CellGridClass(unsigned int nWires, unsigned int nTDC)
+      : wire_axis((size_t)nWires, 0., float(nWires)), tdc_axis((size_t)nTDC, 0., float(nTDC))
+    {} // CellGridClass::CellGridClass(int, int)
+
+    //--------------------------------------------------------------------------
+    CellGridClass::CellGridClass(float min_wire,
+                                 float max_wire,
+                                 unsigned int nWires,
+                                 float min_tdc,
+                                 float max_tdc,
+                                 unsigned int nTDC)
+      : wire_axis((size_t)nWires, min_wire, max_wire), tdc_axis((size_t)nTDC, min_tdc, max_tdc)
+    {} // CellGridClass::CellGridClass({ float, float, int } x 2)
+
+    //--------------------------------------------------------------------------
+    std::ptrdiff_t CellGridClass::GetCell(float wire, float tick) const
+    {
+      std::ptrdiff_t iWireCell = wire_axis.GetCell(wire);
+      if (!wire_axis.hasCell(iWireCell)) return std::ptrdiff_t(-1);
+      std::ptrdiff_t iTDCCell = tdc_axis.GetCell(tick);
+      if (!tdc_axis.hasCell(iTDCCell)) return std::ptrdiff_t(-1);
+      return iWireCell * TDCAxis().NCells() + iTDCCell;
+    } // CellGridClass::GetCell()
+
+    //--------------------------------------------------------------------------
+    std::tuple<float, float, float, float> CellGridClass::GetCellBox(std::ptrdiff_t iCell) const
+    {
+      // { w1, t1, w2, t2 }
+      size_t const nTDCCells = TDCAxis().NCells();
+      std::ptrdiff_t iWireCell = (std::ptrdiff_t)(iCell / nTDCCells),
+                     iTDCCell = (std::ptrdiff_t)(iCell % nTDCCells);
+
+      return std::tuple<float, float, float, float>(WireAxis().LowerEdge(iWireCell),
+                                                    TDCAxis().LowerEdge(iTDCCell),
+                                                    WireAxis().UpperEdge(iWireCell),
+                                                    TDCAxis().UpperEdge(iTDCCell));
+    } // CellGridClass::GetCellBox()
+
+    //--------------------------------------------------------------------------
+
+  } // namespace details
+} // namespace evd
+
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,257 @@
+/**
+ * @file   CellGridClass.h
+ * @brief  Division of the (wire, tick) space into cells matching the pad
+ * @author Gianluca Petrillo (petrillo@fnal.gov)
+ * @date   August 19th, 2015
+ * @see    CellGridClass.cxx
+ *
+ * These classes were originally private to RawDataDrawer; they are shared
+ * with RecoBaseDrawer so that both raw digits and calibrated wires are
+ * aggregated at the resolution of the drawing pad.
+ */
+
+#ifndef EVD_CELLGRIDCLASS_H
+#define EVD_CELLGRIDCLASS_H
+
+// C/C++ standard libraries
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <tuple>
+
+namespace evd {
+  namespace details {
+
+    /// Manages a cell-like division of a coordinate
+    class GridAxisClass {
+    public:
+      /// Default constructor: an invalid range
+      GridAxisClass() { Init(0, 0., 0.); }
+
+      /// Constructor: sets the limits and the number of cells
+      GridAxisClass(size_t nDiv, float new_min, float new_max) { Init(nDiv, new_min, new_max); }
+
+      //@{
+      /// Returns the index of the specified cell
+      std::ptrdiff_t GetCell(float coord) const;
+      std::ptrdiff_t operator()(float coord) const { return GetCell(coord); }
+      //@}
+
+      /// Returns whether the cell is present or not
+      bool hasCell(std::ptrdiff_t iCell) const
+      {
+        return (iCell >= 0) && ((size_t)iCell < NCells());
+      }
+
+      /// Returns whether the coordinate is included in the range or not
+      bool hasCoord(float coord) const { return (coord >= Min()) && (coord < Max()); }
+
+      //@{
+      /// Returns the extremes of the axis
+      float Min() const { return min; }
+      float Max() const { return max; }
+      //@}
+
+      /// Returns the length of the axis
+      float Length() const { return max - min; }
+
+      /// Returns the length of the axis
+      size_t NCells() const { return n_cells; }
+
+      /// Returns whether minimum and maximum match
+      bool isEmpty() const { return max == min; }
+
+      /// Returns the cell size
+      float CellSize() const { return cell_size; }
+
+      /// Returns the lower edge of the cell
+      float LowerEdge(std::ptrdiff_t iCell) const { return Min() + CellSize() * iCell; }
+
+      /// Returns the upper edge of the cell
+      float UpperEdge(std::ptrdiff_t iCell) const { return LowerEdge(iCell + 1); }
+
+      /// Initialize the axis, returns whether cell size is finite
+      bool Init(size_t nDiv, float new_min, float new_max);
+
+      /// Initialize the axis limits, returns whether cell size is finite
+      bool SetLimits(float new_min, float new_max);
+
+      /// Expands the cell (at fixed range) to meet minimum cell size
+      /// @return Whether the cell size was changed
+      bool SetMinCellSize(float min_size);
+
+      /// Expands the cell (at fixed range) to meet maximum cell size
+      /// @return Whether the cell size was changed
+      bool SetMaxCellSize(float max_size);
+
+      /// Expands the cell (at fixed range) to meet maximum cell size
+      /// @return Whether the cell size was changed
+      bool SetCellSizeBoundary(float min_size, float max_size)
+      {
+        return SetMinCellSize(min_size) || SetMaxCellSize(max_size);
+      }
+
+      /// Returns whether the two axes have the same range and cells
+      bool operator==(GridAxisClass const& other) const
+      {
+        return (n_cells == other.n_cells) && (min == other.min) && (max == other.max) &&
+               (cell_size == other.cell_size);
+      }
+
+      /// Returns whether the two axes differ in range or cells
+      bool operator!=(GridAxisClass const& other) const { return !(*this == other); }
+
+      template <typename Stream>
+      void Dump(Stream&& out) const;
+
+    private:
+      size_t n_cells; ///< number of cells in the axis
+      float min, max; ///< extremes of the axis
+
+      float cell_size; ///< size of each cell
+
+    }; // GridAxisClass
+
+    /// Manages a grid-like division of 2D space
+    class CellGridClass {
+    public:
+      /// Default constructor: invalid ranges
+      CellGridClass() : wire_axis(), tdc_axis() {}
+
+      /// Constructor: sets the extremes and assumes one cell for each element
+      CellGridClass(unsigned int nWires, unsigned int nTDC);
+
+      /// Constructor: sets the wire and TDC ranges in detail
+      CellGridClass(float min_wire,
+                    float max_wire,
+                    unsigned int nWires,
+                    float min_tdc,
+                    float max_tdc,
+                    unsigned int nTDC);
+
+      /// Returns the total number of cells in the grid
+      size_t NCells() const { return wire_axis.NCells() * tdc_axis.NCells(); }
+
+      /// Return the information about the wires
+      GridAxisClass const& WireAxis() const { return wire_axis; }
+
+      /// Return the information about the TDCs
+      GridAxisClass const& TDCAxis() const { return tdc_axis; }
+
+      /// Returns the index of specified cell, or -1 if out of range
+      std::ptrdiff_t GetCell(float wire, float tick) const;
+
+      /// Returns the coordinates { w1, t1, w2, t2 } of specified cell
+      std::tuple<float, float, float, float> GetCellBox(std::ptrdiff_t iCell) const;
+
+      //@{
+      /// Returns whether the range includes the specified wire
+      bool hasWire(float wire) const { return wire_axis.hasCoord(wire); }
+      bool hasWire(int wire) const { return hasWire((float)wire); }
+      //@}
+
+      //@{
+      /// Returns whether the range includes the specified wire
+      bool hasTick(float tick) const { return tdc_axis.hasCoord(tick); }
+      bool hasTick(int tick) const { return hasTick((float)tick); }
+      //@}
+
+      /// Increments the specified cell of cont with the value v
+      /// @return whether there was such a cell
+      template <typename CONT>
+      bool Add(CONT& cont, float wire, float tick, typename CONT::value_type v)
+      {
+        std::ptrdiff_t cell = GetCell(wire, tick);
+        if (cell < 0) return false;
+        cont[(size_t)cell] += v;
+        return true;
+      } // Add()
+
+      /// @name Setters
+      /// @{
+      /// Sets a simple wire range: all the wires, one cell per wire
+      void SetWireRange(unsigned int nWires) { SetWireRange(0., (float)nWires, nWires); }
+
+      /// Sets the wire range, leaving the number of wire cells unchanged
+      void SetWireRange(float min_wire, float max_wire) { wire_axis.SetLimits(min_wire, max_wire); }
+
+      /// Sets the complete wire range
+      void SetWireRange(float min_wire, float max_wire, unsigned int nWires)
+      {
+        wire_axis.Init(nWires, min_wire, max_wire);
+      }
+
+      /// Sets the complete wire range, with minimum cell size
+      void SetWireRange(float min_wire, float max_wire, unsigned int nWires, float min_size)
+      {
+        wire_axis.Init(nWires, min_wire, max_wire);
+        wire_axis.SetMinCellSize(min_size);
+      }
+
+      /// Sets a simple TDC range: all the ticks, one cell per tick
+      void SetTDCRange(unsigned int nTDC) { SetTDCRange(0., (float)nTDC, nTDC); }
+
+      /// Sets the complete TDC range
+      void SetTDCRange(float min_tdc, float max_tdc, unsigned int nTDC)
+      {
+        tdc_axis.Init(nTDC, min_tdc, max_tdc);
+      }
+
+      /// Sets the TDC range, leaving the number of ticks unchanged
+      void SetTDCRange(float min_tdc, float max_tdc) { tdc_axis.SetLimits(min_tdc, max_tdc); }
+
+      /// Sets the complete TDC range, with minimum cell size
+      void SetTDCRange(float min_tdc, float max_tdc, unsigned int nTDC, float min_size)
+      {
+        tdc_axis.Init(nTDC, min_tdc, max_tdc);
+        tdc_axis.SetMinCellSize(min_size);
+      }
+
+      /// @}
+
+      /// Sets the minimum size for wire cells
+      bool SetMinWireCellSize(float min_size) { return wire_axis.SetMinCellSize(min_size); }
+
+      /// Sets the minimum size for TDC cells
+      bool SetMinTDCCellSize(float min_size) { return tdc_axis.SetMinCellSize(min_size); }
+
+      /// Returns whether the two grids have the same axes
+      bool operator==(CellGridClass const& other) const
+      {
+        return (wire_axis == other.wire_axis) && (tdc_axis == other.tdc_axis);
+      }
+
+      /// Returns whether the two grids differ in any axis
+      bool operator!=(CellGridClass const& other) const { return !(*this == other); }
+
+      /// Prints the current axes on the specified stream
+      template <typename Stream>
+      void Dump(Stream&& out) const;
+
+    private:
+      GridAxisClass wire_axis;
+      GridAxisClass tdc_axis;
+    }; // CellGridClass
+
+    //--------------------------------------------------------------------------
+    //--- template implementation
+    //---
+    template <typename Stream>
+    void GridAxisClass::Dump(Stream&& out) const
+    {
+      out << NCells() << " cells from " << Min() << " to " << Max() << " (length: " << Length()
+          << ")";
+    } // GridAxisClass::Dump()
+
+    //--------------------------------------------------------------------------
+    template <typename Stream>
+    void CellGridClass::Dump(Stream&& out) const
+    {
+      out << "Wire axis: ";
+      WireAxis().Dump(out);
+      out << "; time axis: ";
+      TDCAxis().Dump(out);
+    } // CellGridClass::Dump()
+
+  } // namespace details
+} // namespace evd
+
+#endif // EVD_CELLGRIDCLASS_H
@@ -17,6 +17,7 @@
 #include "canvas/Utilities/InputTag.h"
 
 // C/C++ standard libraries
+#include <cstddef>     // std::size_t
 #include <ostream>
 #include <string>      // std::to_string()
 #include <type_traits> // std::enable_if_t
@@ -234,6 +235,12 @@ namespace util {
     /// Returns the current plane ID
     geo::PlaneID const& planeID() const { return state.plane_id; }
 
+    /// Returns whether we are in the same event (the rest could differ)
+    bool sameEvent(PlaneDataChangeTracker_t const& as) const
+    {
+      return DataProductChangeTracker_t::sameEvent(as);
+    }
+
     /// Returns whether we are in the same event (the rest could differ)
     bool sameProduct(PlaneDataChangeTracker_t const& as) const
     {
@@ -311,6 +318,108 @@ namespace util {
     return out;
   }
 
+  /** **************************************************************************
+   * @brief Detects a change of the input of a layer of graphic objects
+   *
+   * The state of this class describes what a layer of a wire plane view was
+   * drawn from: the event (by its ID), a hash of the identity of the data
+   * products it was read from, the wire plane and a hash of all the options
+   * and settings the drawing of the layer depends on.
+   *
+   * The event ID alone does not tell a new event from the same event loaded
+   * again (e.g. from a different file, or after a different processing): the
+   * identity of the data products (product ID and address in memory) does.
+   */
+  class DrawLayerChangeTracker_t : private EventChangeTracker_t {
+  public:
+    /// Default constructor: no current layer input
+    DrawLayerChangeTracker_t() = default;
+
+    /// Constructor: specifies current event, data products, plane and options
+    DrawLayerChangeTracker_t(art::Event const& evt,
+                             std::size_t products_hash,
+                             geo::PlaneID const& pid,
+                             std::size_t options_hash)
+      : EventChangeTracker_t(evt), state{products_hash, pid, options_hash}
+    {}
+
+    /// @name State query
+    /// @{
+    /// Returns the hash of the identity of the current data products
+    std::size_t productsHash() const { return state.products_hash; }
+
+    /// Returns the current plane ID
+    geo::PlaneID const& planeID() const { return state.plane_id; }
+
+    /// Returns the hash of the current options
+    std::size_t optionsHash() const { return state.options_hash; }
+
+    /// Returns whether we are in the same event with the same data products
+    bool sameEvent(DrawLayerChangeTracker_t const& as) const
+    {
+      return EventChangeTracker_t::same(as) && (productsHash() == as.productsHash());
+    }
+
+    /// Returns whether we have the same event, products, plane and options as "as"
+    bool same(DrawLayerChangeTracker_t const& as) const
+    {
+      return sameEvent(as) && (planeID() == as.planeID()) && (optionsHash() == as.optionsHash());
+    }
+
+    /// Returns whether there is a current event and plane
+    bool isValid() const { return EventChangeTracker_t::isValid() && planeID().isValid; }
+
+    /// Returns whether event, products, plane and options are the same as in "as"
+    bool operator==(DrawLayerChangeTracker_t const& as) const { return same(as); }
+
+    /// Returns whether event, products, plane or options are different than in "than"
+    bool operator!=(DrawLayerChangeTracker_t const& than) const { return !same(than); }
+    /// @}
+
+    /// @name State change
+    /// @{
+    /// Forget the current input
+    void clear()
+    {
+      EventChangeTracker_t::clear();
+      state = LocalState_t();
+    }
+
+    /// Update to a new input, return true if it has changed
+    bool update(DrawLayerChangeTracker_t const& new_input)
+    {
+      if (same(new_input)) return false;
+      *this = new_input;
+      return true;
+    }
+
+    /// @}
+
+    /// Returns a string representation of event, products, plane and options hash
+    operator std::string() const
+    {
+      return EventChangeTracker_t::operator std::string() + " P:" +
+             std::to_string(productsHash()) + " " + std::string(planeID()) +
+             " O:" + std::to_string(optionsHash());
+    }
+
+  private:
+    struct LocalState_t {
+      std::size_t products_hash = 0;
+      geo::PlaneID plane_id;
+      std::size_t options_hash = 0;
+    }; // LocalState_t
+
+    LocalState_t state;
+
+  }; // DrawLayerChangeTracker_t
+
+  inline std::ostream& operator<<(std::ostream& out, DrawLayerChangeTracker_t const& trk)
+  {
+    out << std::string(trk);
+    return out;
+  }
+
 } // namespace util
 
 #endif // UTIL_CHANGETRACKERS_H
@@ -4,11 +4,15 @@
 /// \author  brebel@fnal.gov
 
 // Framework includes
+#include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 /// LArSoft includes
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
 
+#include <functional> // std::hash
+#include <string>
+
 namespace evd {
 
   //......................................................................
@@ -122,6 +126,7 @@ namespace evd {
   //......................................................................
   void ColorDrawingOptions::reconfigure(fhicl::ParameterSet const& pset)
   {
+    fConfigHash = std::hash<std::string>{}(pset.id().to_string());
     fColorOrGray = pset.get<int>("ColorOrGrayScale");
     fRawDiv = pset.get<std::vector<int>>("RawDiv");
     fRecoDiv = pset.get<std::vector<int>>("RecoDiv");
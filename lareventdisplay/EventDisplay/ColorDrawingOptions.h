@@ -7,6 +7,9 @@
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
+#include <cstddef> // std::size_t
+#include <vector>
+
 #include "nuevdb/EventDisplayBase/ColorScale.h"
 #include "nuevdb/EventDisplayBase/Reconfigurable.h"
 
@@ -36,6 +39,8 @@ namespace evd {
     std::vector<double> fRecoQLow;  ///< low  edge of ADC values for drawing raw digits
     std::vector<double> fRecoQHigh; ///< high edge of ADC values for drawing raw digits
 
+    std::size_t fConfigHash; ///< hash of the configuration last applied by `reconfigure()`
+
   private:
     void CheckInputVectorSizes();
 
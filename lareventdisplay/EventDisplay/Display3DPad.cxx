@@ -3,17 +3,20 @@
 /// \brief   Drawing pad showing a 3D rendering of the detector
 /// \author  messier@indiana.edu
 ///
+#include "TList.h"
 #include "TPad.h"
 #include "TView3D.h"
 
 #include "larcore/Geometry/Geometry.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/I3DDrawer.h"
 #include "lareventdisplay/EventDisplay/Display3DPad.h"
+#include "lareventdisplay/EventDisplay/DrawTimer.h"
 #include "lareventdisplay/EventDisplay/ExptDrawers/IExperimentDrawer.h"
 #include "lareventdisplay/EventDisplay/RecoBaseDrawer.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/SimDrawers/ISim3DDrawer.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
 #include "nuevdb/EventDisplayBase/EventHolder.h"
 #include "nuevdb/EventDisplayBase/View3D.h"
 
@@ -21,6 +24,24 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Utilities/make_tool.h"
 
+#include <algorithm>
+
+namespace {
+
+  /// Range of the 3D view when it is first drawn
+  void DefaultViewRange(geo::GeometryCore const& geom, double* rmin, double* rmax)
+  {
+    auto const& tpc = geom.TPC({0, 0});
+    rmin[0] = -2.1 * tpc.HalfWidth();
+    rmin[1] = -2.1 * tpc.HalfHeight();
+    rmin[2] = -0.5 * tpc.Length();
+    rmax[0] = 2.1 * tpc.HalfWidth();
+    rmax[1] = 2.1 * tpc.HalfHeight();
+    rmax[2] = 0.5 * tpc.Length();
+  }
+
+} // local namespace
+
 namespace evd {
 
   ///
@@ -57,6 +78,7 @@ namespace evd {
         drawSim3DTools.get<fhicl::ParameterSet>(draw3DTool);
 
       fSim3DDrawerVec.push_back(art::make_tool<evdb_tool::ISim3DDrawer>(draw3DToolParamSet));
+      fSim3DDrawerNames.push_back(draw3DTool);
     }
 
     // Set up the 3D drawing tools for the reconstruction
@@ -70,6 +92,7 @@ namespace evd {
         drawReco3DTools.get<fhicl::ParameterSet>(draw3DTool);
 
       fReco3DDrawerVec.push_back(art::make_tool<evdb_tool::I3DDrawer>(draw3DToolParamSet));
+      fReco3DDrawerNames.push_back(draw3DTool);
     }
   }
 
@@ -91,41 +114,91 @@ namespace evd {
 
     // grab the event from the singleton
     const art::Event* evt = evdb::EventHolder::Instance()->GetEvent();
+    DrawTimer timer("Display3DPad", evt);
 
     if (evt) {
+      art::ServiceHandle<evd::RecoDrawingOptions const> recoOpt;
+      SpacePointLOD::Instance().Update(*evt,
+                                       SpacePointCellSize(recoOpt->fSpacePoint3DCellPixels),
+                                       recoOpt->fSpacePoint3DMaxPerCell);
+
       GeometryDraw()->DetOutline3D(fView);
+      timer.Lap("DetOutline3D");
       RecoBaseDraw()->PFParticle3D(*evt, fView);
+      timer.Lap("PFParticle3D");
       RecoBaseDraw()->Edge3D(*evt, fView);
+      timer.Lap("Edge3D");
       RecoBaseDraw()->SpacePoint3D(*evt, fView);
+      timer.Lap("SpacePoint3D");
       RecoBaseDraw()->Prong3D(*evt, fView);
+      timer.Lap("Prong3D");
       RecoBaseDraw()->Seed3D(*evt, fView);
+      timer.Lap("Seed3D");
       RecoBaseDraw()->Vertex3D(*evt, fView);
+      timer.Lap("Vertex3D");
       RecoBaseDraw()->Event3D(*evt, fView);
+      timer.Lap("Event3D");
       RecoBaseDraw()->Slice3D(*evt, fView);
+      timer.Lap("Slice3D");
 
       // Call the 3D simulation drawing tools
-      for (auto& draw3D : fSim3DDrawerVec)
-        draw3D->Draw(*evt, fView);
+      for (std::size_t iTool = 0; iTool < fSim3DDrawerVec.size(); ++iTool) {
+        fSim3DDrawerVec[iTool]->Draw(*evt, fView);
+        timer.Lap(fSim3DDrawerNames[iTool]);
+      }
 
       // Call the 3D reco drawing tools
-      for (auto& draw3D : fReco3DDrawerVec)
-        draw3D->Draw(*evt, fView);
+      for (std::size_t iTool = 0; iTool < fReco3DDrawerVec.size(); ++iTool) {
+        fReco3DDrawerVec[iTool]->Draw(*evt, fView);
+        timer.Lap(fReco3DDrawerNames[iTool]);
+      }
     }
 
     Pad()->Clear();
     Pad()->cd();
     if (fPad->GetView() == nullptr) {
-      auto const& tpc = geo->TPC({0, 0});
-      double rmin[] = {-2.1 * tpc.HalfWidth(), -2.1 * tpc.HalfHeight(), -0.5 * tpc.Length()};
-      double rmax[] = {2.1 * tpc.HalfWidth(), 2.1 * tpc.HalfHeight(), 0.5 * tpc.Length()};
+      double rmin[3], rmax[3];
+      DefaultViewRange(*geo, rmin, rmax);
       int irep;
       TView3D* v = new TView3D(1, rmin, rmax);
       v->SetPerspective();
       v->SetView(0.0, 260.0, 270.0, irep);
       fPad->SetView(v); // ROOT takes ownership of object *v
     }
+    timer.Lap("pad setup");
     fView->Draw();
     fPad->Update();
+    timer.Lap("View3D::Draw");
+    if (timer.isEnabled()) timer.SetPrimitives(fPad->GetListOfPrimitives()->GetSize());
+  }
+
+  //......................................................................
+  ///
+  /// Returns the side [cm] of a cell `pixels` wide in the current view
+  ///
+  /// The extent of the view range is spread on the shorter side of the pad,
+  /// so that zooming the view or enlarging the window makes the cells
+  /// smaller. It returns 0 if `pixels` is not positive or the pad is not
+  /// mapped on the screen.
+  ///
+  double Display3DPad::SpacePointCellSize(double pixels) const
+  {
+    if (pixels <= 0.) return 0.;
+    double const padPixels = std::min(fPad->UtoPixel(1.), fPad->VtoPixel(0.));
+    if (padPixels <= 0.) return 0.;
+
+    double rmin[3], rmax[3];
+    if (TView* view = fPad->GetView()) {
+      std::copy_n(view->GetRmin(), 3, rmin);
+      std::copy_n(view->GetRmax(), 3, rmax);
+    }
+    else
+      DefaultViewRange(*art::ServiceHandle<geo::Geometry const>(), rmin, rmax);
+
+    double extent = 0.;
+    for (int i = 0; i < 3; ++i)
+      extent = std::max(extent, rmax[i] - rmin[i]);
+    return pixels * extent / padPixels;
   }
 
 } //namespace
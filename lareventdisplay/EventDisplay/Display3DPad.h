@@ -7,6 +7,7 @@
 #define EVD_DISPLAY3DPAD_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "lareventdisplay/EventDisplay/DrawingPad.h"
@@ -32,10 +33,15 @@ namespace evd {
     void UpdateSeedCurve();
 
   private:
+    double SpacePointCellSize(double pixels) const;
+
     evdb::View3D* fView; ///< Collection of graphics objects to render
 
     std::vector<std::unique_ptr<evdb_tool::ISim3DDrawer>> fSim3DDrawerVec;
     std::vector<std::unique_ptr<evdb_tool::I3DDrawer>> fReco3DDrawerVec;
+
+    std::vector<std::string> fSim3DDrawerNames;  ///< labels of the simulation tools
+    std::vector<std::string> fReco3DDrawerNames; ///< labels of the reconstruction tools
   };
 }
 
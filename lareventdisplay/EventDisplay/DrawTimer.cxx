@@ -0,0 +1,117 @@
+/**
+ * @file   DrawTimer.cxx
+ * @brief  Measurement of the time spent by each drawer in a redraw
+ * @see    DrawTimer.h
+ */
+
+#include "lareventdisplay/EventDisplay/DrawTimer.h"
+
+// LArSoft libraries
+#include "lareventdisplay/EventDisplay/EvdLayoutOptions.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <utility> // std::move()
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  DrawTimer::DrawTimer(std::string pad, art::Event const* evt)
+  {
+    art::ServiceHandle<evd::EvdLayoutOptions const> evdlayoutopt;
+    fEnabled = evdlayoutopt->fDrawTiming;
+    if (!fEnabled) return;
+    fPad = std::move(pad);
+    if (evt) fEventID = evt->id();
+    fCSVfile = evdlayoutopt->fDrawTimingFile;
+    fStart = fLast = Clock_t::now();
+  } // DrawTimer::DrawTimer()
+
+  //----------------------------------------------------------------------------
+  DrawTimer::~DrawTimer()
+  {
+    try {
+      Report();
+    }
+    catch (...) {
+      // timing is not worth an exception during stack unwinding
+    }
+  } // DrawTimer::~DrawTimer()
+
+  //----------------------------------------------------------------------------
+  void DrawTimer::Lap(std::string const& drawer)
+  {
+    if (!fEnabled) return;
+    Clock_t::time_point const now = Clock_t::now();
+    fLaps.emplace_back(drawer, std::chrono::duration<double, std::milli>(now - fLast).count());
+    fLast = now;
+  } // DrawTimer::Lap()
+
+  //----------------------------------------------------------------------------
+  void DrawTimer::SetPrimitives(std::size_t n)
+  {
+    fPrimitives = static_cast<long long>(n);
+  } // DrawTimer::SetPrimitives()
+
+  //----------------------------------------------------------------------------
+  void DrawTimer::Report()
+  {
+    if (!fEnabled) return;
+    fEnabled = false; // report only once
+
+    double const total =
+      std::chrono::duration<double, std::milli>(Clock_t::now() - fStart).count();
+
+    mf::LogInfo log("DrawTimer");
+    log << "Redraw of " << fPad;
+    if (fEventID.isValid()) log << " for " << fEventID;
+    log << " took " << std::fixed << std::setprecision(2) << total << " ms";
+    if (fPrimitives >= 0) log << " for " << fPrimitives << " graphic primitives";
+    for (auto const& [drawer, time] : fLaps) {
+      log << "\n  " << std::left << std::setw(32) << drawer << std::right << std::setw(10)
+          << time << " ms" << std::setw(7) << std::setprecision(1)
+          << (total > 0. ? 100. * time / total : 0.) << "%" << std::setprecision(2);
+    }
+
+    if (!fCSVfile.empty()) WriteCSV(total);
+  } // DrawTimer::Report()
+
+  //----------------------------------------------------------------------------
+  void DrawTimer::WriteCSV(double total) const
+  {
+    // pads are drawn on the main thread, but the file is shared by all of them
+    static std::mutex csvMutex;
+    std::lock_guard<std::mutex> lock(csvMutex);
+
+    bool const newFile = !std::ifstream(fCSVfile).good();
+    std::ofstream csv(fCSVfile, std::ios::app);
+    if (!csv) {
+      mf::LogWarning("DrawTimer") << "Can't write timing information into '" << fCSVfile << "'";
+      return;
+    }
+    if (newFile) csv << "run,subrun,event,pad,drawer,time_ms,primitives\n";
+
+    auto const writeRow = [this, &csv](std::string const& drawer, double time) {
+      if (fEventID.isValid())
+        csv << fEventID.run() << "," << fEventID.subRun() << "," << fEventID.event();
+      else
+        csv << ",,";
+      csv << ",\"" << fPad << "\",\"" << drawer << "\"," << time << ",";
+    };
+    for (auto const& [drawer, time] : fLaps) {
+      writeRow(drawer, time);
+      csv << "\n";
+    }
+    writeRow("total", total);
+    if (fPrimitives >= 0) csv << fPrimitives;
+    csv << "\n";
+  } // DrawTimer::WriteCSV()
+
+} // namespace evd
@@ -0,0 +1,88 @@
+/**
+ * @file   DrawTimer.h
+ * @brief  Measurement of the time spent by each drawer in a redraw
+ * @see    DrawTimer.cxx
+ *
+ * The timing is enabled by the `DrawTiming` parameter of `EvdLayoutOptions`.
+ * A table for each redraw is written to the message logger (category
+ * `DrawTimer`) and, if `DrawTimingFile` is set, appended to that CSV file.
+ */
+
+#ifndef EVD_DRAWTIMER_H
+#define EVD_DRAWTIMER_H
+
+// framework libraries
+#include "art/Framework/Principal/fwd.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+namespace evd {
+
+  /**
+   * @brief Records the time spent by the drawers of one redraw of a pad
+   *
+   * The time is measured in laps: each call to `Lap()` assigns to the
+   * specified drawer the time elapsed since the previous lap (or since the
+   * construction of the timer). The table is reported when the timer is
+   * destroyed, or on an explicit `Report()`.
+   *
+   * Example:
+   *
+   *     DrawTimer timer("TWireProjPad plane 0", evtPtr);
+   *     RawDataDraw()->RawDigit2D(evt, detProp, fView, fPlane);
+   *     timer.Lap("RawDigit2D");
+   *     RecoBaseDraw()->Wire2D(evt, fView, fPlane);
+   *     timer.Lap("Wire2D");
+   *
+   * When the timing is not enabled, the timer does nothing.
+   */
+  class DrawTimer {
+  public:
+    /// Starts timing the redraw of the specified pad for an event (may be null)
+    DrawTimer(std::string pad, art::Event const* evt);
+
+    /// Reports the measurements, if not done yet
+    ~DrawTimer();
+
+    DrawTimer(DrawTimer const&) = delete;
+    DrawTimer& operator=(DrawTimer const&) = delete;
+
+    /// Returns whether the timing is enabled
+    bool isEnabled() const { return fEnabled; }
+
+    /// Assigns to `drawer` the time elapsed since the last lap
+    void Lap(std::string const& drawer);
+
+    /// Records the number of graphic primitives of the redraw
+    void SetPrimitives(std::size_t n);
+
+    /// Writes the measurements to the configured destinations
+    void Report();
+
+  private:
+    using Clock_t = std::chrono::steady_clock;
+
+    bool fEnabled;              ///< whether to measure anything at all
+    std::string fPad;           ///< name of the pad being drawn
+    art::EventID fEventID;      ///< event being drawn
+    std::string fCSVfile;       ///< path of the CSV output (empty if none)
+    Clock_t::time_point fStart; ///< start of the redraw
+    Clock_t::time_point fLast;  ///< end of the last lap
+
+    std::vector<std::pair<std::string, double>> fLaps; ///< time by drawer [ms]
+    long long fPrimitives = -1; ///< graphic primitives (negative if unknown)
+
+    /// Appends the measurements to the CSV file
+    void WriteCSV(double total) const;
+
+  }; // class DrawTimer
+
+} // namespace evd
+
+#endif // EVD_DRAWTIMER_H
@@ -2,26 +2,45 @@
 /// \file EVD_module.cc
 ///
 /// \author  jpaley@anl.gov
+///
+/// With a `Batch` configuration table the module opens no window: the
+/// configured views are drawn on offscreen canvases for each event and saved
+/// into image files. See `evd_batch.fcl` for the configuration.
 
 // Framework includes
 #include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 //LArSoft includes
+#include "larcore/Geometry/WireReadout.h"
 #include "lareventdisplay/EventDisplay/CalorView.h"
+#include "lareventdisplay/EventDisplay/Display3DPad.h"
 #include "lareventdisplay/EventDisplay/Display3DView.h"
+#include "lareventdisplay/EventDisplay/HeaderPad.h"
+#include "lareventdisplay/EventDisplay/Ortho3DPad.h"
 #include "lareventdisplay/EventDisplay/Ortho3DView.h"
 #include "lareventdisplay/EventDisplay/TWQMultiTPCProjection.h"
 #include "lareventdisplay/EventDisplay/TWQProjectionView.h"
+#include "lareventdisplay/EventDisplay/TWireProjPad.h"
 #include "nuevdb/EventDisplayBase/DisplayWindow.h"
+#include "nuevdb/EventDisplayBase/EventHolder.h"
 
-// Framework includes
-namespace art {
-  class Event;
-}
-namespace fhicl {
-  class ParameterSet;
-}
+// ROOT includes
+#include "TCanvas.h"
+#include "TROOT.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #if defined __clang__
 #pragma clang diagnostic push
@@ -41,9 +60,46 @@ namespace evd {
 
     void analyze(art::Event const& evt);
     void beginJob();
+    void endJob();
 
   private:
+    /// An offscreen canvas with the pads of one of the views, for batch mode
+    struct Snapshot_t {
+      std::string name;                                  ///< view name, used in the file names
+      std::unique_ptr<TCanvas> canvas;                   ///< the offscreen canvas
+      std::unique_ptr<HeaderPad> header;                 ///< event header (wire views)
+      std::vector<std::unique_ptr<TWireProjPad>> planes; ///< time vs wire pads
+      std::vector<std::unique_ptr<Ortho3DPad>> ortho;    ///< orthographic projection pads
+      std::unique_ptr<Display3DPad> display3D;           ///< 3D display pad
+      double drawTime = 0.;                              ///< total drawing time [ms]
+      double saveTime = 0.;                              ///< total time writing files [ms]
+    };
+
     bool fWindowsDrawn; ///< flag for whether windows are already drawn
+
+    bool fBatch;                          ///< whether to draw offscreen, without windows
+    std::vector<std::string> fBatchViews; ///< views to be drawn in batch mode
+    std::vector<std::string> fFormats;    ///< extensions of the files of each view
+    std::string fOutputDir;               ///< directory for the files
+    std::string fFilePrefix;              ///< prefix of the file names
+    unsigned int fCanvasWidth;            ///< width of the offscreen canvases [pixel]
+    unsigned int fCanvasHeight;           ///< height of the offscreen canvases [pixel]
+    unsigned int fShards;                 ///< number of processes sharing the events
+    unsigned int fShard;                  ///< events of this process (event number modulo)
+    std::vector<Snapshot_t> fSnapshots;   ///< the offscreen views
+    unsigned int fNEvents = 0;            ///< events drawn in batch mode
+    double fEventTime = 0.;               ///< total time of drawing and writing events [ms]
+
+    /// Creates the offscreen canvas and the pads of the view `name`
+    Snapshot_t MakeSnapshot(std::string const& name) const;
+
+    /// Draws `snapshot` for the current event
+    void DrawSnapshot(Snapshot_t& snapshot) const;
+
+    /// Returns the path of the file for `snapshot` of `evt` with extension `format`
+    std::string SnapshotPath(Snapshot_t const& snapshot,
+                             art::Event const& evt,
+                             std::string const& format) const;
   };
 }
 
@@ -86,7 +142,24 @@ static evdb::Canvas* mk_calor_canvas(TGMainFrame* mf)
 namespace evd {
 
   //----------------------------------------------------
-  EVD::EVD(fhicl::ParameterSet const& pset) : EDAnalyzer(pset), fWindowsDrawn(false) {}
+  EVD::EVD(fhicl::ParameterSet const& pset)
+    : EDAnalyzer(pset), fWindowsDrawn(false), fBatch(pset.has_key("Batch"))
+  {
+    fhicl::ParameterSet const batch = pset.get<fhicl::ParameterSet>("Batch", {});
+    fBatchViews = batch.get<std::vector<std::string>>("Views", {"TWQProjection"});
+    fFormats = batch.get<std::vector<std::string>>("Formats", {"png"});
+    fOutputDir = batch.get<std::string>("OutputDir", ".");
+    fFilePrefix = batch.get<std::string>("FilePrefix", "evd");
+    fCanvasWidth = batch.get<unsigned int>("CanvasWidth", 1200);
+    fCanvasHeight = batch.get<unsigned int>("CanvasHeight", 900);
+    fShards = batch.get<unsigned int>("Shards", 1);
+    fShard = batch.get<unsigned int>("Shard", 0);
+
+    if (fShards == 0 || fShard >= fShards) {
+      throw cet::exception("EVD") << "Batch.Shard (" << fShard
+                                  << ") must be smaller than Batch.Shards (" << fShards << ")\n";
+    }
+  }
 
   //----------------------------------------------------
   EVD::~EVD() {}
@@ -94,6 +167,13 @@ namespace evd {
   //----------------------------------------------------
   void EVD::beginJob()
   {
+    if (fBatch) {
+      gROOT->SetBatch(kTRUE);
+      for (std::string const& name : fBatchViews)
+        fSnapshots.push_back(MakeSnapshot(name));
+      return;
+    }
+
     // Register the list of windows used by the event display
     evdb::DisplayWindow::Register("Time vs Wire, Charge View",
                                   "Time vs Wire, Charge View",
@@ -124,7 +204,135 @@ namespace evd {
   }
 
   //----------------------------------------------------
-  void EVD::analyze(const art::Event& /*evt*/) {}
+  void EVD::analyze(const art::Event& evt)
+  {
+    if (!fBatch) return;
+    if (evt.event() % fShards != fShard) return;
+
+    using Clock_t = std::chrono::steady_clock;
+    auto const ms = [](Clock_t::duration d) {
+      return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    // the drawers find the event here, as when the display service sets it;
+    // the per-event caches of the drawers are then shared by all the views
+    evdb::EventHolder::Instance()->SetEvent(&evt);
+
+    auto const eventStart = Clock_t::now();
+    for (Snapshot_t& snapshot : fSnapshots) {
+      auto const drawStart = Clock_t::now();
+      DrawSnapshot(snapshot);
+      auto const saveStart = Clock_t::now();
+      for (std::string const& format : fFormats)
+        snapshot.canvas->SaveAs(SnapshotPath(snapshot, evt, format).c_str());
+      auto const saveEnd = Clock_t::now();
+      snapshot.drawTime += ms(saveStart - drawStart);
+      snapshot.saveTime += ms(saveEnd - saveStart);
+    }
+    fEventTime += ms(Clock_t::now() - eventStart);
+    ++fNEvents;
+
+    evdb::EventHolder::Instance()->SetEvent(nullptr);
+  }
+
+  //----------------------------------------------------
+  void EVD::endJob()
+  {
+    if (!fBatch) return;
+
+    mf::LogInfo log("EVD");
+    log << "Batch snapshots of " << fNEvents << " events (shard " << fShard << "/" << fShards
+        << "): " << std::fixed << std::setprecision(2)
+        << (fEventTime > 0. ? fNEvents / (fEventTime / 1000.) : 0.) << " events/s";
+    for (Snapshot_t const& snapshot : fSnapshots) {
+      log << "\n  " << std::setw(16) << std::left << snapshot.name << std::right
+          << " draw: " << std::setw(10) << (fNEvents ? snapshot.drawTime / fNEvents : 0.)
+          << " ms/event, write: " << std::setw(10)
+          << (fNEvents ? snapshot.saveTime / fNEvents : 0.) << " ms/event";
+    }
+
+    fSnapshots.clear();
+  }
+
+  //----------------------------------------------------
+  EVD::Snapshot_t EVD::MakeSnapshot(std::string const& name) const
+  {
+    Snapshot_t snapshot;
+    snapshot.name = name;
+    snapshot.canvas = std::make_unique<TCanvas>(
+      ("EVD" + name).c_str(), name.c_str(), (int)fCanvasWidth, (int)fCanvasHeight);
+    snapshot.canvas->cd();
+
+    if (name == "TWQProjection") {
+      // same arrangement as in TWQProjectionView: planes stacked from the bottom
+      snapshot.header =
+        std::make_unique<HeaderPad>("fHeaderPad", "Header", 0.0, 0.93, 1.0, 1.0, "");
+      unsigned int const nplanes = art::ServiceHandle<geo::WireReadout const>()->Get().Nplanes();
+      for (unsigned int i = 0; i < nplanes; ++i) {
+        double const y1 = 0.93 * i / nplanes;
+        double const y2 = 0.93 * (i + 1) / nplanes;
+        TString padname = "fWireProjP";
+        padname += i;
+        TString padtitle = "Plane";
+        padtitle += i;
+        snapshot.canvas->cd();
+        snapshot.planes.push_back(
+          std::make_unique<TWireProjPad>(padname, padtitle, 0.0, y1, 1.0, y2, i));
+      }
+    }
+    else if (name == "Ortho3D") {
+      // same projections as in Ortho3DView
+      snapshot.ortho.push_back(
+        std::make_unique<Ortho3DPad>("Ortho3DPadXZ", "XZ View", kXZ, 0.0, 0.5, 1.0, 1.0));
+      snapshot.canvas->cd();
+      snapshot.ortho.push_back(
+        std::make_unique<Ortho3DPad>("Ortho3DPadYZ", "YZ View", kYZ, 0.0, 0.0, 1.0, 0.5));
+    }
+    else if (name == "Display3D") {
+      snapshot.display3D =
+        std::make_unique<Display3DPad>("fDisplay3DPad", "3D Display", 0.0, 0.0, 1.0, 1.0);
+    }
+    else {
+      throw cet::exception("EVD") << "Unsupported batch view '" << name
+                                  << "' (supported: TWQProjection, Ortho3D, Display3D)\n";
+    }
+
+    return snapshot;
+  }
+
+  //----------------------------------------------------
+  void EVD::DrawSnapshot(Snapshot_t& snapshot) const
+  {
+    snapshot.canvas->cd();
+    if (snapshot.header) snapshot.header->Draw();
+    if (!snapshot.planes.empty()) {
+      std::vector<TWireProjPad*> planes;
+      for (auto const& plane : snapshot.planes)
+        planes.push_back(plane.get());
+      TWireProjPad::PrepareDraw(planes);
+      for (TWireProjPad* plane : planes) {
+        plane->Draw();
+        plane->Pad()->Update();
+      }
+    }
+    for (auto const& pad : snapshot.ortho) {
+      pad->Draw();
+      pad->Pad()->Update();
+    }
+    if (snapshot.display3D) snapshot.display3D->Draw();
+    snapshot.canvas->Update();
+  }
+
+  //----------------------------------------------------
+  std::string EVD::SnapshotPath(Snapshot_t const& snapshot,
+                                art::Event const& evt,
+                                std::string const& format) const
+  {
+    std::ostringstream path;
+    path << fOutputDir << "/" << fFilePrefix << "_" << snapshot.name << "_r" << evt.run() << "_s"
+         << evt.subRun() << "_e" << evt.event() << "." << format;
+    return path.str();
+  }
 
 } //namespace
 
@@ -33,6 +33,8 @@ namespace evd {
     fDrawGrid = pset.get<bool>("DrawGrid", true);
     fDrawAxes = pset.get<bool>("DrawAxes", true);
     fDrawBadChannels = pset.get<bool>("DrawBadChannels", true);
+    fDrawTiming = pset.get<bool>("DrawTiming", false);
+    fDrawTimingFile = pset.get<std::string>("DrawTimingFile", "");
 
     fDisplayName = pset.get<std::string>("DisplayName", "LArSoft");
   }
@@ -41,6 +41,9 @@ namespace evd {
     bool fDrawAxes;        ///< true to draw coordinate axes
     bool fDrawBadChannels; ///< true to draw bad channels
 
+    bool fDrawTiming;            ///< true to report the time spent by each drawer
+    std::string fDrawTimingFile; ///< CSV file to append the drawer times to (empty: none)
+
     std::string fDisplayName; ///< Name to apply to 2D display
   };
 } //namespace
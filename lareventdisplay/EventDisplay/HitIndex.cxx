@@ -0,0 +1,305 @@
+/**
+ * @file   HitIndex.cxx
+ * @brief  Per-event index of reconstructed hits by wire plane and by channel
+ * @see    HitIndex.h
+ */
+
+#include "lareventdisplay/EventDisplay/HitIndex.h"
+
+// LArSoft libraries
+#include "larcore/Geometry/WireReadout.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::stable_sort(), std::equal_range(), std::clamp()
+#include <cmath>     // std::isnan(), std::ceil(), std::floor()
+#include <iterator>  // std::prev()
+#include <limits>
+#include <utility>   // std::pair
+
+namespace {
+
+  /// Peak time used for sorting; hits with invalid time are moved at the end
+  float SortTime(recob::Hit const& hit)
+  {
+    float const time = hit.PeakTime();
+    return std::isnan(time) ? std::numeric_limits<float>::max() : time;
+  }
+
+  /// @{
+  /// Keys for the heterogeneous look-ups in the index
+  geo::WireID const& wireIDof(evd::HitIndex::HitEntry_t const& entry)
+  {
+    return entry.wireID;
+  }
+  geo::WireID const& wireIDof(geo::WireID const& wireID)
+  {
+    return wireID;
+  }
+  raw::ChannelID_t channelOf(evd::HitIndex::HitEntry_t const& entry)
+  {
+    return entry.hit->Channel();
+  }
+  raw::ChannelID_t channelOf(raw::ChannelID_t channel)
+  {
+    return channel;
+  }
+  /// @}
+
+  using WireNo_t = geo::WireID::WireID_t;
+
+  /// Returns the valid wire number closest to the integral `wire`
+  WireNo_t ClampedWire(double wire)
+  {
+    constexpr double maxWire = std::numeric_limits<WireNo_t>::max();
+    return static_cast<WireNo_t>(std::clamp(wire, 0.0, maxWire));
+  }
+
+  /// Returns the first entry in [`first`, `last`) not before `wire` and `time`;
+  /// the entries must be on the same plane, hence sorted by wire and time
+  evd::HitIndex::const_iterator LowerBound(evd::HitIndex::const_iterator first,
+                                           evd::HitIndex::const_iterator last,
+                                           WireNo_t wire,
+                                           float time)
+  {
+    using Key_t = std::pair<WireNo_t, float>;
+    return std::lower_bound(
+      first, last, Key_t{wire, time}, [](evd::HitIndex::HitEntry_t const& entry, Key_t const& key) {
+        return Key_t{entry.wireID.Wire, SortTime(*entry.hit)} < key;
+      });
+  }
+
+  /// Returns the product of the handle, or nullptr if not valid
+  std::vector<recob::Hit> const* ProductOf(art::Handle<std::vector<recob::Hit>> const& handle)
+  {
+    return handle.isValid() ? handle.product() : nullptr;
+  }
+
+} // local namespace
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  HitIndex::Range_t HitIndex::Plane(geo::PlaneID const& pid) const
+  {
+    auto const iRange = fPlaneRanges.find(pid);
+    if (iRange == fPlaneRanges.end()) return {};
+    return {fByPlane.begin() + iRange->second.first, fByPlane.begin() + iRange->second.second};
+  } // HitIndex::Plane()
+
+  //----------------------------------------------------------------------------
+  HitIndex::Range_t HitIndex::Wire(geo::WireID const& wid) const
+  {
+    Range_t const planeHits = Plane(wid.planeID());
+    auto const range = std::equal_range(
+      planeHits.begin(), planeHits.end(), wid, [](auto const& a, auto const& b) {
+        return wireIDof(a) < wireIDof(b);
+      });
+    return {range.first, range.second};
+  } // HitIndex::Wire()
+
+  //----------------------------------------------------------------------------
+  HitIndex::Range_t HitIndex::Channel(raw::ChannelID_t channel) const
+  {
+    auto const range = std::equal_range(
+      fByChannel.begin(), fByChannel.end(), channel, [](auto const& a, auto const& b) {
+        return channelOf(a) < channelOf(b);
+      });
+    return {range.first, range.second};
+  } // HitIndex::Channel()
+
+  //----------------------------------------------------------------------------
+  std::vector<HitIndex::HitEntry_t const*> HitIndex::InWindow(geo::PlaneID const& pid,
+                                                              double wireMin,
+                                                              double wireMax,
+                                                              double timeMin,
+                                                              double timeMax) const
+  {
+    std::vector<HitEntry_t const*> entries;
+    if ((wireMax < 0.0) || (wireMax < wireMin) || (timeMax < timeMin)) return entries;
+
+    WireNo_t const lastWire = ClampedWire(std::floor(wireMax));
+    Range_t const planeHits = Plane(pid);
+    auto iEntry = planeHits.begin();
+    auto const end = planeHits.end();
+
+    WireNo_t wire = ClampedWire(std::ceil(wireMin));
+    while (true) {
+      iEntry = LowerBound(iEntry, end, wire, timeMin);
+      if ((iEntry == end) || (iEntry->wireID.Wire > lastWire)) break;
+      if (iEntry->wireID.Wire != wire) { // no hit in the window on this wire
+        wire = iEntry->wireID.Wire;
+        continue;
+      }
+      for (; (iEntry != end) && (iEntry->wireID.Wire == wire); ++iEntry) {
+        if (SortTime(*iEntry->hit) > timeMax) break;
+        entries.push_back(&*iEntry);
+      }
+      if (wire == lastWire) break;
+      ++wire;
+    } // while
+
+    return entries;
+  } // HitIndex::InWindow()
+
+  //----------------------------------------------------------------------------
+  HitIndex::HitEntry_t const* HitIndex::Closest(geo::PlaneID const& pid,
+                                                double wire,
+                                                double time,
+                                                double wireScale,
+                                                double timeScale) const
+  {
+    Range_t const planeHits = Plane(pid);
+    auto const begin = planeHits.begin();
+    auto const end = planeHits.end();
+    constexpr float anyTime = std::numeric_limits<float>::lowest();
+
+    HitEntry_t const* closest = nullptr;
+    double minDist2 = std::numeric_limits<double>::max();
+
+    // distance from the point along the wire direction
+    auto const wireDist = [wire, wireScale](const_iterator iEntry) {
+      double const d = (iEntry->wireID.Wire - wire) * wireScale;
+      return d * d;
+    };
+
+    // checks the hits of one wire immediately before and after the point time
+    auto const checkWire = [&](const_iterator first, const_iterator last) {
+      auto const iAfter = LowerBound(first, last, first->wireID.Wire, time);
+      for (auto const iEntry : {iAfter, (iAfter == first) ? last : std::prev(iAfter)}) {
+        if (iEntry == last) continue;
+        double const dt = (SortTime(*iEntry->hit) - time) * timeScale;
+        double const dist2 = wireDist(iEntry) + dt * dt;
+        if (dist2 < minDist2) {
+          minDist2 = dist2;
+          closest = &*iEntry;
+        }
+      } // for
+    };
+
+    // visit the wires outward from the point, nearest first: the ones on the
+    // right start at iRight, the ones on the left end at iLeft
+    auto iRight = LowerBound(begin, end, ClampedWire(std::ceil(wire)), anyTime);
+    auto iLeft = iRight;
+    while (true) {
+      bool const hasRight = (iRight != end) && (wireDist(iRight) < minDist2);
+      bool const hasLeft = (iLeft != begin) && (wireDist(std::prev(iLeft)) < minDist2);
+      if (!hasRight && !hasLeft) break;
+      if (hasRight && (!hasLeft || (wireDist(iRight) <= wireDist(std::prev(iLeft))))) {
+        auto const wireEnd = LowerBound(iRight, end, iRight->wireID.Wire + 1, anyTime);
+        checkWire(iRight, wireEnd);
+        iRight = wireEnd;
+      }
+      else {
+        auto const wireBegin = LowerBound(begin, iLeft, std::prev(iLeft)->wireID.Wire, anyTime);
+        checkWire(wireBegin, iLeft);
+        iLeft = wireBegin;
+      }
+    } // while
+
+    return closest;
+  } // HitIndex::Closest()
+
+  //----------------------------------------------------------------------------
+  HitIndex const& HitIndex::Get(art::Event const& evt, art::InputTag const& label)
+  {
+    static std::map<art::InputTag, HitIndex> indices;
+
+    util::DataProductChangeTracker_t const tracker{evt, label};
+
+    // indices from other events are not going to be useful any more
+    for (auto iIndex = indices.begin(); iIndex != indices.end();) {
+      if (iIndex->second.fTracker.sameEvent(tracker))
+        ++iIndex;
+      else
+        iIndex = indices.erase(iIndex);
+    }
+
+    HitIndex& index = indices[label];
+
+    // the event display may reload the event anew (e.g. on a new TPC),
+    // so the address of the data product is also checked
+    art::Handle<std::vector<recob::Hit>> handle;
+    evt.getByLabel(label, handle);
+    if (index.fTracker.same(tracker) && (ProductOf(handle) == ProductOf(index.fHandle)))
+      return index;
+
+    index.Rebuild(handle);
+    index.fTracker = tracker;
+
+    MF_LOG_DEBUG("HitIndex") << "Indexed " << index.size() << " hits on "
+                             << index.fPlaneRanges.size() << " planes for " << tracker;
+    return index;
+  } // HitIndex::Get()
+
+  //----------------------------------------------------------------------------
+  void HitIndex::Rebuild(art::Handle<std::vector<recob::Hit>> const& handle)
+  {
+    Clear();
+    fHandle = handle;
+    if (!fHandle.isValid()) return;
+
+    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
+
+    std::vector<recob::Hit> const& hits = *fHandle;
+    fByChannel.reserve(hits.size());
+    fByPlane.reserve(hits.size());
+
+    // Note that the WireID in the hit object is useless for those detectors
+    // where a channel can correspond to more than one plane/wire; so we index
+    // the hit on all the wires of its channel. Hits on the same channel are
+    // usually next to each other, so the wires are looked up once per run
+    raw::ChannelID_t lastChannel = raw::InvalidChannelID;
+    std::vector<geo::WireID> wireIDs;
+    for (std::size_t iHit = 0; iHit < hits.size(); ++iHit) {
+      recob::Hit const& hit = hits[iHit];
+      if (hit.Channel() != lastChannel) {
+        lastChannel = hit.Channel();
+        wireIDs = wireReadoutGeom.ChannelToWire(lastChannel);
+      }
+
+      fByChannel.push_back({&hit, iHit, hit.WireID()});
+      for (geo::WireID const& wireID : wireIDs)
+        fByPlane.push_back({&hit, iHit, wireID});
+    } // for hits
+
+    std::stable_sort(
+      fByPlane.begin(), fByPlane.end(), [](HitEntry_t const& a, HitEntry_t const& b) {
+        if (a.wireID != b.wireID) return a.wireID < b.wireID;
+        return SortTime(*a.hit) < SortTime(*b.hit);
+      });
+    std::stable_sort(
+      fByChannel.begin(), fByChannel.end(), [](HitEntry_t const& a, HitEntry_t const& b) {
+        if (channelOf(a) != channelOf(b)) return channelOf(a) < channelOf(b);
+        return SortTime(*a.hit) < SortTime(*b.hit);
+      });
+
+    // the hits of each plane are now contiguous
+    std::size_t iStart = 0;
+    for (std::size_t iEntry = 1; iEntry <= fByPlane.size(); ++iEntry) {
+      if ((iEntry < fByPlane.size()) &&
+          (fByPlane[iEntry].wireID.planeID() == fByPlane[iStart].wireID.planeID()))
+        continue;
+      fPlaneRanges.emplace(fByPlane[iStart].wireID.planeID(), std::make_pair(iStart, iEntry));
+      iStart = iEntry;
+    } // for
+
+  } // HitIndex::Rebuild()
+
+  //----------------------------------------------------------------------------
+  void HitIndex::Clear()
+  {
+    fHandle.clear();
+    fByPlane.clear();
+    fByChannel.clear();
+    fPlaneRanges.clear();
+    fTracker.clear();
+  } // HitIndex::Clear()
+
+} // namespace evd
+
+////////////////////////////////////////////////////////////////////////
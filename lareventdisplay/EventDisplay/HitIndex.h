@@ -0,0 +1,174 @@
+/**
+ * @file   HitIndex.h
+ * @brief  Per-event index of reconstructed hits by wire plane and by channel
+ * @see    HitIndex.cxx
+ *
+ * The 2D views, the hit selection and the waveform tools all need the hits of
+ * a given plane or channel out of a `std::vector<recob::Hit>` data product.
+ * Instead of each of them scanning the whole collection (and asking the
+ * geometry for the wires of each hit channel) on every redraw, `HitIndex`
+ * sorts the hits once per event and data product, and hands out contiguous
+ * ranges of them.
+ */
+
+#ifndef EVD_HITINDEX_H
+#define EVD_HITINDEX_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::DataProductChangeTracker_t
+
+// framework libraries
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/fwd.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard libraries
+#include <cstddef>  // std::size_t
+#include <iterator> // std::distance()
+#include <map>
+#include <utility> // std::pair
+#include <vector>
+
+namespace evd {
+
+  /**
+   * @brief Index of the hits of one data product, by wire plane and channel
+   *
+   * The index is built from a `std::vector<recob::Hit>` data product.
+   * Each hit is indexed on all the wires its channel is connected to (the
+   * `recob::Hit::WireID()` is not reliable for detectors with wrapped wires),
+   * and the hits of each plane are sorted by wire and then peak time.
+   * The hits are also indexed by channel, sorted by peak time.
+   *
+   * Indices are shared via `Get()`, which keeps one for each data product
+   * label and rebuilds it only when the event or the data product change.
+   */
+  class HitIndex {
+  public:
+    /// Information on one indexed hit
+    struct HitEntry_t {
+      recob::Hit const* hit = nullptr; ///< the indexed hit
+      std::size_t index = 0;           ///< position of the hit in its data product
+      geo::WireID wireID;              ///< wire the hit is indexed on
+
+      recob::Hit const* operator->() const { return hit; }
+      recob::Hit const& operator*() const { return *hit; }
+    }; // HitEntry_t
+
+    using Entries_t = std::vector<HitEntry_t>;
+    using const_iterator = Entries_t::const_iterator;
+
+    /// A contiguous range of hit entries
+    class Range_t {
+    public:
+      Range_t() = default;
+      Range_t(const_iterator b, const_iterator e) : fBegin(b), fEnd(e) {}
+
+      const_iterator begin() const { return fBegin; }
+      const_iterator end() const { return fEnd; }
+      std::size_t size() const { return std::distance(fBegin, fEnd); }
+      bool empty() const { return fBegin == fEnd; }
+      HitEntry_t const& operator[](std::size_t i) const { return *(fBegin + i); }
+
+    private:
+      const_iterator fBegin, fEnd;
+    }; // Range_t
+
+    /// Returns whether the indexed data product is available
+    bool isValid() const { return fHandle.isValid(); }
+
+    /// Returns the number of hits in the indexed data product
+    std::size_t size() const { return isValid() ? fHandle->size() : 0U; }
+
+    /// Returns the handle of the indexed data product
+    art::Handle<std::vector<recob::Hit>> const& Handle() const { return fHandle; }
+
+    /// Returns an art pointer to the hit of the specified entry
+    art::Ptr<recob::Hit> Ptr(HitEntry_t const& entry) const
+    {
+      return art::Ptr<recob::Hit>(fHandle, entry.index);
+    }
+
+    /// Returns the hits on the specified plane, sorted by wire and peak time
+    Range_t Plane(geo::PlaneID const& pid) const;
+
+    /// Returns the hits on the specified wire, sorted by peak time
+    Range_t Wire(geo::WireID const& wid) const;
+
+    /// Returns the hits on the specified channel, sorted by peak time
+    Range_t Channel(raw::ChannelID_t channel) const;
+
+    /**
+     * @brief Returns the hits on a plane within a wire and peak time window
+     * @param pid the plane to look the hits up in
+     * @param wireMin lowest wire number of the window
+     * @param wireMax highest wire number of the window
+     * @param timeMin earliest peak time of the window [ticks]
+     * @param timeMax latest peak time of the window [ticks]
+     * @return pointers to the entries in the window, sorted by wire and time
+     *
+     * The window includes its borders. Each wire with hits in the window costs
+     * a binary search in the entries of the plane.
+     */
+    std::vector<HitEntry_t const*> InWindow(geo::PlaneID const& pid,
+                                            double wireMin,
+                                            double wireMax,
+                                            double timeMin,
+                                            double timeMax) const;
+
+    /**
+     * @brief Returns the hit on a plane closest to the specified point
+     * @param pid the plane to look the hits up in
+     * @param wire wire coordinate of the point
+     * @param time peak time coordinate of the point [ticks]
+     * @param wireScale length of one wire in the distance units (e.g. pitch)
+     * @param timeScale length of one tick in the distance units
+     * @return the closest entry, `nullptr` if the plane has no hit
+     *
+     * The wires with hits are visited outward from `wire`, until they are
+     * farther than the closest hit found; on each wire the hits closest in
+     * time are found by binary search.
+     */
+    HitEntry_t const* Closest(geo::PlaneID const& pid,
+                              double wire,
+                              double time,
+                              double wireScale,
+                              double timeScale) const;
+
+    /**
+     * @brief Returns the index of the hits with the specified label
+     * @param evt the event to read the hits from
+     * @param label the input tag of the `std::vector<recob::Hit>` data product
+     * @return the (shared) index of the hits, invalid if no hit is available
+     *
+     * The index is cached and rebuilt only if the event, the input tag or the
+     * memory location of the data product change.
+     */
+    static HitIndex const& Get(art::Event const& evt, art::InputTag const& label);
+
+  private:
+    art::Handle<std::vector<recob::Hit>> fHandle; ///< indexed data product
+
+    Entries_t fByPlane;   ///< all entries, sorted by wire ID and peak time
+    Entries_t fByChannel; ///< all entries, sorted by channel and peak time
+
+    /// Range of entries in `fByPlane` for each plane
+    std::map<geo::PlaneID, std::pair<std::size_t, std::size_t>> fPlaneRanges;
+
+    util::DataProductChangeTracker_t fTracker; ///< state of the indexed data
+
+    /// Fills the index from the specified data product
+    void Rebuild(art::Handle<std::vector<recob::Hit>> const& handle);
+
+    /// Removes all the content from the index
+    void Clear();
+
+  }; // class HitIndex
+
+} // namespace evd
+
+#endif // EVD_HITINDEX_H
@@ -17,8 +17,10 @@
 #include "lardata/Utilities/GeometryUtilities.h"
 #include "lardata/Utilities/PxHitConverter.h"
 #include "lardataobj/RecoBase/Seed.h"
+#include "lareventdisplay/EventDisplay/HitIndex.h"
 #include "lareventdisplay/EventDisplay/HitSelector.h"
 #include "lareventdisplay/EventDisplay/InfoTransfer.h"
+#include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
 
 namespace {
@@ -92,6 +94,7 @@ namespace evd {
                              double distance,
                              bool good_plane)
   {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
     art::ServiceHandle<evd::RecoDrawingOptions const> recoOpt;
     art::ServiceHandle<geo::Geometry const> geo;
     auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
@@ -101,7 +104,7 @@ namespace evd {
     util::GeometryUtilities const gser{*geo, wireReadoutGeom, clockData, detProp};
     std::vector<art::Ptr<recob::Hit>> hits_to_save;
 
-    art::Handle<std::vector<recob::Hit>> HitListHandle;
+    geo::PlaneID const planeID(rawOpt->CurrentTPC(), plane);
 
     starthitout[plane].clear();
     endhitout[plane].clear();
@@ -122,40 +125,44 @@ namespace evd {
     for (size_t imod = 0; imod < recoOpt->fHitLabels.size(); ++imod) {
       art::InputTag const which = recoOpt->fHitLabels[imod];
 
-      std::vector<art::Ptr<recob::Hit>> hitlist;
-      hitlist.clear();
-      evt.getByLabel(which, HitListHandle);
+      util::PxPoint startHit;
+      startHit.plane = plane;
+      startHit.w = (x + x1) / 2;
+      startHit.t = (y + y1) / 2;
 
-      for (unsigned int ii = 0; ii < HitListHandle->size(); ++ii) {
-        art::Ptr<recob::Hit> hit(HitListHandle, ii);
-        if (hit->WireID().Plane == plane) hitlist.push_back(hit);
-      }
+      double orttemp = std::hypot(y1 - y, x1 - x) / 2;
+
+      // the selected hits are within this distance from the center of the
+      // selection: only the hits in the window around that are checked
+      double const radius = std::hypot(orttemp, distance);
+
+      HitIndex const& hitIndex = HitIndex::Get(evt, which);
+      std::vector<art::Ptr<recob::Hit>> hitlist;
+      for (HitIndex::HitEntry_t const* entry :
+           hitIndex.InWindow(planeID,
+                             (startHit.w - radius) / gser.WireToCm(),
+                             (startHit.w + radius) / gser.WireToCm(),
+                             (startHit.t - radius) / gser.TimeToCm(),
+                             (startHit.t + radius) / gser.TimeToCm()))
+        hitlist.push_back(hitIndex.Ptr(*entry));
 
       // Select Local Hit List
       util::PxHitConverter PxC{gser};
       std::vector<util::PxHit> pxhitlist;
       PxC.GeneratePxHit(hitlist, pxhitlist);
       std::vector<unsigned int> pxhitlist_local_index;
-      std::vector<util::PxHit> pxhitlist_local;
-      pxhitlist_local.clear();
-
-      util::PxPoint startHit;
-      startHit.plane = pxhitlist.at(0).plane;
-      startHit.w = (x + x1) / 2;
-      startHit.t = (y + y1) / 2;
-
-      double orttemp = std::hypot(y1 - y, x1 - x) / 2;
-
       gser.SelectLocalHitlistIndex(
         pxhitlist, pxhitlist_local_index, startHit, orttemp, distance, lslope);
+      if (pxhitlist_local_index.empty()) continue;
 
+      std::vector<util::PxHit> pxhitlist_local;
       for (unsigned int idx = 0; idx < pxhitlist_local_index.size(); idx++) {
         hits_to_save.push_back(hitlist.at(pxhitlist_local_index.at(idx)));
         pxhitlist_local.push_back(pxhitlist.at(pxhitlist_local_index.at(idx)));
       }
 
       auto const hit_index = gser.FindClosestHitIndex(pxhitlist_local, x, y);
-      recob::Hit const& hit = *hits_to_save[hit_index];
+      recob::Hit const& hit = *hitlist[pxhitlist_local_index[hit_index]];
       starthitout[plane][1] = hit.PeakTime();
       starthitout[plane][0] = hit.WireID().Wire;
 
@@ -185,6 +192,7 @@ namespace evd {
   ///
   void HitSelector::ChangeHit(const art::Event& evt, unsigned int plane, double xin, double yin)
   {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
     art::ServiceHandle<evd::RecoDrawingOptions const> recoOpt;
     art::ServiceHandle<geo::Geometry const> geo;
     auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
@@ -193,51 +201,28 @@ namespace evd {
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
     util::GeometryUtilities const gser{*geo, wireReadoutGeom, clockData, detProp};
 
-    //get hits from info transfer, see if our selected hit is in it
-    std::vector<art::Ptr<recob::Hit>> hits_saved;
-    std::vector<art::Ptr<recob::Hit>> hitlist;
-
-    double x = xin * gser.WireToCm();
-    double y = yin * gser.TimeToCm();
-
-    art::Handle<std::vector<recob::Hit>> HitListHandle;
+    geo::PlaneID const planeID(rawOpt->CurrentTPC(), plane);
 
     for (size_t imod = 0; imod < recoOpt->fHitLabels.size(); ++imod) {
       art::InputTag const which = recoOpt->fHitLabels[imod];
-      evt.getByLabel(which, HitListHandle);
-
-      for (unsigned int ii = 0; ii < HitListHandle->size(); ++ii) {
-        art::Ptr<recob::Hit> hit(HitListHandle, ii);
-        if (hit->WireID().Plane == plane) hitlist.push_back(hit);
-      }
 
-      util::PxHitConverter PxC{gser};
-      std::vector<util::PxHit> pxhitlist;
-      PxC.GeneratePxHit(hitlist, pxhitlist);
+      // distances are measured in cm, as in the GeometryUtilities algorithms
+      HitIndex const& hitIndex = HitIndex::Get(evt, which);
+      HitIndex::HitEntry_t const* closest =
+        hitIndex.Closest(planeID, xin, yin, gser.WireToCm(), gser.TimeToCm());
+      if (!closest) continue;
 
-      unsigned int hitindex = gser.FindClosestHitIndex(pxhitlist, x, y);
-      if (hitlist[hitindex].isNull() || (hitindex > hitlist.size())) {
+      art::Ptr<recob::Hit> const hit = hitIndex.Ptr(*closest);
+      if (hit.isNull()) {
         WriteMsg("no luck finding hit in evd, please try again");
         break;
       }
 
+      // select the hit, or deselect it if it was already
       art::ServiceHandle<evd::InfoTransfer> infot;
-      hits_saved = infot->GetSelectedHitList(plane);
-      int found_it = 0;
-      for (unsigned int jj = 0; jj < hits_saved.size(); ++jj) {
-        if (hitlist[hitindex]->PeakTime() == hits_saved[jj]->PeakTime()) {
-          if (hitlist[hitindex]->Channel() == hits_saved[jj]->Channel()) {
-            found_it = 1;
-            hits_saved.erase(hits_saved.begin() + jj);
-          }
-        }
-      }
-
-      //if didn't find it, add it
-      if (found_it != 1) { hits_saved.push_back(hitlist[hitindex]); }
+      infot->ToggleSelectedHit(plane, hit);
 
       //update the info transfer list
-      infot->SetHitList(plane, hits_saved);
       infot->SetTestFlag(1);
       infot->SetEvtNumber(evt.id().event());
     }
@@ -24,6 +24,9 @@
 #include "canvas/Persistency/Common/Ptr.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>  // std::find_if(), std::sort()
+#include <functional> // std::less
+
 namespace {
   void WriteMsg(const char* fcn)
   {
@@ -47,6 +50,7 @@ namespace evd {
     unsigned int nplanes = wireReadoutGeom.Nplanes();
 
     fSelectedHitlist.resize(nplanes);
+    fSelectedHitKeys.resize(nplanes);
     fStartHit.resize(nplanes);
     fRefStartHit.resize(nplanes);
     fEndHit.resize(nplanes);
@@ -74,9 +78,11 @@ namespace evd {
     //clear everything
     fRefinedHitlist.resize(nplanes);
     fSelectedHitlist.resize(nplanes);
+    fSelectedHitKeys.resize(nplanes);
     for (unsigned int i = 0; i < nplanes; i++) {
       fRefinedHitlist[i].clear();
       fSelectedHitlist[i].clear();
+      fSelectedHitKeys[i].clear();
     }
     fHitModuleLabel = pset.get<std::string>("HitModuleLabel", "ffthit");
   }
@@ -91,9 +97,11 @@ namespace evd {
       //unless we're reloading we want to clear all the selected and refined hits
       fRefinedHitlist.resize(nplanes);
       fSelectedHitlist.resize(nplanes);
+      fSelectedHitKeys.resize(nplanes);
       for (unsigned int j = 0; j < nplanes; j++) {
         fRefinedHitlist[j].clear();
         fSelectedHitlist[j].clear();
+        fSelectedHitKeys[j].clear();
         starthitout[j].clear();
         endhitout[j].clear();
         starthitout[j].resize(2);
@@ -104,8 +112,8 @@ namespace evd {
         refendhitout[j].resize(2);
       }
       //also clear start and end points
-      fRefStartHit.clear();
-      fRefEndHit.clear();
+      fRefStartHit.assign(nplanes, nullptr);
+      fRefEndHit.assign(nplanes, nullptr);
       fFullHitlist.clear();
     }
     art::Handle<std::vector<recob::Hit>> hHandle;
@@ -162,31 +170,65 @@ namespace evd {
       WriteMsg(buf);
     }
 
-    for (size_t t = 0; t < fFullHitlist.size(); ++t) {
-      for (unsigned int ip = 0; ip < nplanes; ip++) {
-        for (size_t xx = 0; xx < fSelectedHitlist[ip].size(); ++xx) {
-          if (fFullHitlist[t] == fSelectedHitlist[ip][xx]) {
-            fRefinedHitlist[ip].push_back(fFullHitlist[t]);
-            break;
-          }
-        }
-
-        if (fStartHit[ip] && fFullHitlist[t].get() == fStartHit[ip]) {
-          fRefStartHit[ip] = const_cast<recob::Hit*>(fFullHitlist[t].get());
-        }
-
-        if (fEndHit[ip] && fFullHitlist[t].get() == fEndHit[ip]) {
-          fRefEndHit[ip] = const_cast<recob::Hit*>(fFullHitlist[t].get());
-        }
+    // the refined list keeps the selected hits found in the hit data product,
+    // in the order of the data product
+    recob::Hit const* const firstHit = hHandle->data();
+    recob::Hit const* const endHit = firstHit + hHandle->size();
+    auto const inProduct = [firstHit, endHit](recob::Hit const* hit) {
+      return hit && !std::less<recob::Hit const*>{}(hit, firstHit) &&
+             std::less<recob::Hit const*>{}(hit, endHit);
+    };
+    std::vector<std::size_t> keys;
+    for (unsigned int ip = 0; ip < nplanes; ip++) {
+      keys.clear();
+      for (HitKey_t const& key : fSelectedHitKeys[ip]) {
+        if ((key.first == hHandle.id()) && (key.second < hHandle->size()))
+          keys.push_back(key.second);
       }
+      std::sort(keys.begin(), keys.end());
+      for (std::size_t const key : keys)
+        fRefinedHitlist[ip].push_back(fFullHitlist[key]);
+
+      if (inProduct(fStartHit[ip])) fRefStartHit[ip] = fStartHit[ip];
+      if (inProduct(fEndHit[ip])) fRefEndHit[ip] = fEndHit[ip];
     }
 
     fSelectedHitlist.clear();
     fSelectedHitlist = fRefinedHitlist;
+    for (unsigned int ip = 0; ip < nplanes; ip++)
+      IndexSelectedHits(ip);
 
     return;
   }
 
+  //......................................................................
+  bool InfoTransfer::ToggleSelectedHit(unsigned int plane, art::Ptr<recob::Hit> const& hit)
+  {
+    std::vector<art::Ptr<recob::Hit>>& selected = fSelectedHitlist[plane];
+    if (fSelectedHitKeys[plane].insert(KeyOf(hit)).second) {
+      selected.push_back(hit);
+      return true;
+    }
+    fSelectedHitKeys[plane].erase(KeyOf(hit));
+    // the list keeps the selection order, so the hit is looked up in it;
+    // it should be there, but a list out of sync with the keys is not trusted
+    auto const iHit = std::find_if(selected.begin(), selected.end(), [&hit](auto const& other) {
+      return KeyOf(other) == KeyOf(hit);
+    });
+    if (iHit != selected.end()) selected.erase(iHit);
+    return false;
+  }
+
+  //......................................................................
+  void InfoTransfer::IndexSelectedHits(unsigned int plane)
+  {
+    HitKeySet_t& keys = fSelectedHitKeys[plane];
+    keys.clear();
+    keys.reserve(fSelectedHitlist[plane].size());
+    for (art::Ptr<recob::Hit> const& hit : fSelectedHitlist[plane])
+      keys.insert(KeyOf(hit));
+  }
+
   //......................................................................
   void InfoTransfer::SetSeedList(std::vector<util::PxLine> seedlines)
   {
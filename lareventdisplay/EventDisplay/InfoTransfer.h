@@ -9,8 +9,12 @@
 #ifndef INFOTRANSFER_H
 #define INFOTRANSFER_H
 #ifndef __CINT__
+#include <cstddef>    // std::size_t
+#include <functional> // std::hash
 #include <iostream>
 #include <string>
+#include <unordered_set>
+#include <utility> // std::pair
 #include <vector>
 
 #include "nuevdb/EventDisplayBase/Reconfigurable.h"
@@ -65,8 +69,19 @@ namespace evd {
     {
       fSelectedHitlist[p].clear();
       fSelectedHitlist[p] = hits_to_save;
+      IndexSelectedHits(p);
     }
 
+    /// Returns whether the hit is in the list selected by the GUI for the plane
+    bool IsSelectedHit(unsigned int plane, art::Ptr<recob::Hit> const& hit) const
+    {
+      return fSelectedHitKeys[plane].count(KeyOf(hit)) > 0;
+    }
+
+    /// Adds the hit to the selected list of the plane, or removes it if already
+    /// there; returns whether the hit is selected after the call
+    bool ToggleSelectedHit(unsigned int plane, art::Ptr<recob::Hit> const& hit);
+
     std::vector<art::Ptr<recob::Hit>> const& GetHitList(unsigned int plane) const
     {
       return fRefinedHitlist[plane];
@@ -84,6 +99,7 @@ namespace evd {
         std::cout << "no size" << std::endl;
       }
       fSelectedHitlist[plane].clear();
+      fSelectedHitKeys[plane].clear();
       for (unsigned int i = 0; i < fRefStartHit.size(); i++) {
         fRefStartHit[i] = NULL;
         fRefEndHit[i] = NULL;
@@ -128,6 +144,24 @@ namespace evd {
     std::vector<util::PxLine> const& GetSeedList() const;
 
   private:
+    /// Identifies a hit by its data product and its index in it
+    using HitKey_t = std::pair<art::ProductID, std::size_t>;
+
+    struct HitKeyHash_t {
+      std::size_t operator()(HitKey_t const& key) const
+      {
+        return std::hash<std::size_t>{}(key.second) ^
+               (std::hash<art::ProductID::value_type>{}(key.first.value()) << 1);
+      }
+    }; // HitKeyHash_t
+
+    using HitKeySet_t = std::unordered_set<HitKey_t, HitKeyHash_t>;
+
+    static HitKey_t KeyOf(art::Ptr<recob::Hit> const& hit) { return {hit.id(), hit.key()}; }
+
+    /// Fills the set of selected hit keys of the plane from its selected list
+    void IndexSelectedHits(unsigned int plane);
+
     void FillStartEndHitCoords(unsigned int plane);
 
     int testflag;
@@ -136,6 +170,7 @@ namespace evd {
     int fSubRun;
     std::vector<std::vector<art::Ptr<recob::Hit>>>
       fSelectedHitlist; ///< the list selected by the GUI (one for each plane)
+    std::vector<HitKeySet_t> fSelectedHitKeys; ///< keys of `fSelectedHitlist` (one for each plane)
     std::vector<std::vector<art::Ptr<recob::Hit>>>
       fRefinedHitlist; ///< the refined hitlist after rebuild (one for each plane)
     std::vector<art::Ptr<recob::Hit>> fFullHitlist; ///< the full Hit list from the Hitfinder.
@@ -9,6 +9,7 @@
 #include "TGNumberEntry.h"
 #include "TH1F.h"
 #include "TLatex.h"
+#include "TList.h"
 #include "TPad.h"
 #include "TPolyMarker.h"
 #include "TVirtualPadPainter.h"
@@ -21,6 +22,7 @@
 #include "larcorealg/Geometry/TPCGeo.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lareventdisplay/EventDisplay/DrawTimer.h"
 #include "lareventdisplay/EventDisplay/Ortho3DPad.h"
 #include "lareventdisplay/EventDisplay/RecoBaseDrawer.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawer.h"
@@ -234,26 +236,38 @@ void evd::Ortho3DPad::Draw(const char* /*opt*/)
 
   // Insert graphic objects into fView collection.
 
-  if (art::Event const* evtPtr = evdb::EventHolder::Instance()->GetEvent()) {
+  art::Event const* evtPtr = evdb::EventHolder::Instance()->GetEvent();
+  evd::DrawTimer timer("Ortho3DPad projection " + std::to_string(int(fProj)), evtPtr);
+  if (evtPtr) {
     auto const& evt = *evtPtr;
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
+    timer.Lap("setup");
 
     SimulationDraw()->MCTruthOrtho(evt, fProj, fMSize, fView);
+    timer.Lap("MCTruthOrtho");
     RecoBaseDraw()->SpacePointOrtho(evt, fProj, fMSize, fView);
+    timer.Lap("SpacePointOrtho");
     RecoBaseDraw()->PFParticleOrtho(evt, fProj, fMSize, fView);
+    timer.Lap("PFParticleOrtho");
     RecoBaseDraw()->ProngOrtho(evt, fProj, fMSize, fView);
+    timer.Lap("ProngOrtho");
     RecoBaseDraw()->SeedOrtho(evt, fProj, fView);
+    timer.Lap("SeedOrtho");
     RecoBaseDraw()->OpFlashOrtho(evt, clockData, detProp, fProj, fView);
+    timer.Lap("OpFlashOrtho");
     RecoBaseDraw()->VertexOrtho(evt, fProj, fView);
+    timer.Lap("VertexOrtho");
   }
   // Draw objects on pad.
 
   fPad->cd();
   fPad->GetPainter()->SetFillColor(18);
   fHisto->Draw("X-");
+  timer.Lap("pad setup");
   fView->Draw();
+  timer.Lap("View2D::Draw");
   TLatex latex;
   latex.SetTextColor(16);
   latex.SetTextSize(0.05);
@@ -272,6 +286,8 @@ void evd::Ortho3DPad::Draw(const char* /*opt*/)
   fPad->Modified();
   fPad->Update();
   fBoxDrawn = false;
+  timer.Lap("pad update");
+  if (timer.isEnabled()) timer.SetPrimitives(fPad->GetListOfPrimitives()->GetSize());
 }
 
 //......................................................................
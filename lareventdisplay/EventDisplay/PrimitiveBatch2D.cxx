@@ -0,0 +1,84 @@
+/**
+ * @file   PrimitiveBatch2D.cxx
+ * @brief  Boxes and lines sharing the same attributes, painted as one object
+ * @see    PrimitiveBatch2D.h
+ */
+
+#include "lareventdisplay/EventDisplay/PrimitiveBatch2D.h"
+
+// ROOT libraries
+#include "TVirtualPad.h"
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  PrimitiveBatch2D::PrimitiveBatch2D(int color, int lineWidth, int lineStyle, int fillStyle)
+    : TAttLine(color, lineStyle, lineWidth), TAttFill(color, fillStyle)
+  {
+    SetBit(kCannotPick);
+    SetBit(kMustCleanup); // removed from the pads when deleted
+  } // PrimitiveBatch2D::PrimitiveBatch2D()
+
+  //----------------------------------------------------------------------------
+  void PrimitiveBatch2D::Paint(Option_t*)
+  {
+    if (!gPad || empty()) return;
+
+    // same as TBox::Paint() and TLine::Paint(), with the attributes set once
+    TAttLine::Modify();
+    TAttFill::Modify();
+    for (std::size_t i = 0; i < fBoxes.size(); i += 4) {
+      gPad->PaintBox(gPad->XtoPad(fBoxes[i]),
+                     gPad->YtoPad(fBoxes[i + 1]),
+                     gPad->XtoPad(fBoxes[i + 2]),
+                     gPad->YtoPad(fBoxes[i + 3]));
+    }
+    for (std::size_t i = 0; i < fSegments.size(); i += 4) {
+      gPad->PaintLine(gPad->XtoPad(fSegments[i]),
+                      gPad->YtoPad(fSegments[i + 1]),
+                      gPad->XtoPad(fSegments[i + 2]),
+                      gPad->YtoPad(fSegments[i + 3]));
+    }
+  } // PrimitiveBatch2D::Paint()
+
+  //----------------------------------------------------------------------------
+  PrimitiveBatch2D& PrimitiveBatches2D::Batch(int color,
+                                              int lineWidth,
+                                              int lineStyle,
+                                              int fillStyle)
+  {
+    PrimitiveBatch2D*& batch = fIndex[Key_t{color, lineWidth, lineStyle, fillStyle}];
+    if (!batch) {
+      fBatches.push_back(
+        std::make_unique<PrimitiveBatch2D>(color, lineWidth, lineStyle, fillStyle));
+      batch = fBatches.back().get();
+    }
+    return *batch;
+  } // PrimitiveBatches2D::Batch()
+
+  //----------------------------------------------------------------------------
+  void PrimitiveBatches2D::Clear()
+  {
+    for (auto& batch : fBatches)
+      batch->Clear();
+  } // PrimitiveBatches2D::Clear()
+
+  //----------------------------------------------------------------------------
+  void PrimitiveBatches2D::Draw()
+  {
+    if (!gPad) return;
+    for (auto& batch : fBatches) {
+      if (!batch->empty()) batch->Draw();
+    }
+  } // PrimitiveBatches2D::Draw()
+
+  //----------------------------------------------------------------------------
+  std::size_t PrimitiveBatches2D::NPrimitives() const
+  {
+    std::size_t n = 0;
+    for (auto const& batch : fBatches)
+      n += batch->NBoxes() + batch->NSegments();
+    return n;
+  } // PrimitiveBatches2D::NPrimitives()
+
+} // namespace evd
@@ -0,0 +1,112 @@
+/**
+ * @file   PrimitiveBatch2D.h
+ * @brief  Boxes and lines sharing the same attributes, painted as one object
+ * @see    PrimitiveBatch2D.cxx
+ *
+ * `evdb::View2D` adds one ROOT object per box or line, and the pad visits all
+ * of them on each repaint. Drawers producing many primitives with only a few
+ * distinct attributes (like the hits of `RecoBaseDrawer::Hit2D()`) can instead
+ * store the coordinates in a batch for each combination of attributes, the
+ * same way `SpacePoint3DDrawerHitCharge` groups the markers by color.
+ */
+
+#ifndef EVD_PRIMITIVEBATCH2D_H
+#define EVD_PRIMITIVEBATCH2D_H
+
+// ROOT libraries
+#include "TAttFill.h"
+#include "TAttLine.h"
+#include "TObject.h"
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <map>
+#include <memory> // std::unique_ptr
+#include <tuple>
+#include <vector>
+
+namespace evd {
+
+  /**
+   * @brief Boxes and line segments drawn with the same line and fill attributes
+   *
+   * The coordinates are stored in contiguous arrays, and the whole batch is a
+   * single object in the pad: `Paint()` sets the attributes once and then
+   * paints all the boxes and all the segments. The batch can't be picked.
+   */
+  class PrimitiveBatch2D : public TObject, public TAttLine, public TAttFill {
+  public:
+    PrimitiveBatch2D(int color, int lineWidth, int lineStyle, int fillStyle);
+
+    /// Adds a box with corners (`x1`, `y1`) and (`x2`, `y2`)
+    void AddBox(double x1, double y1, double x2, double y2)
+    {
+      fBoxes.insert(fBoxes.end(), {float(x1), float(y1), float(x2), float(y2)});
+    }
+
+    /// Adds a line segment from (`x1`, `y1`) to (`x2`, `y2`)
+    void AddSegment(double x1, double y1, double x2, double y2)
+    {
+      fSegments.insert(fSegments.end(), {float(x1), float(y1), float(x2), float(y2)});
+    }
+
+    /// Removes all the primitives, keeping the allocated memory
+    void Clear(Option_t* = "") override
+    {
+      fBoxes.clear();
+      fSegments.clear();
+    }
+
+    std::size_t NBoxes() const { return fBoxes.size() / 4; }
+    std::size_t NSegments() const { return fSegments.size() / 4; }
+    bool empty() const { return fBoxes.empty() && fSegments.empty(); }
+
+    void Paint(Option_t* option = "") override;
+
+  private:
+    std::vector<float> fBoxes;    ///< x1, y1, x2, y2 of each box
+    std::vector<float> fSegments; ///< x1, y1, x2, y2 of each segment
+
+  }; // class PrimitiveBatch2D
+
+  /**
+   * @brief Collection of batches, one for each combination of attributes
+   *
+   * Batches are created on demand by `Batch()` and painted in the order they
+   * were created. `Clear()` empties all of them but keeps the objects, since
+   * the pad may still refer to them until it is cleared in turn.
+   *
+   * Example:
+   *
+   *     batches.Clear();
+   *     batches.Batch(kRed, 1).AddBox(w - 0.5, t - rms, w + 0.5, t + rms);
+   *     // ...
+   *     view->Draw();
+   *     batches.Draw(); // on the current pad, above the view primitives
+   */
+  class PrimitiveBatches2D {
+  public:
+    /// Returns the batch with the specified attributes, creating it if needed
+    PrimitiveBatch2D& Batch(int color, int lineWidth, int lineStyle = 1, int fillStyle = 0);
+
+    /// Removes all the primitives from all the batches
+    void Clear();
+
+    /// Appends all the non-empty batches to the current pad
+    void Draw();
+
+    /// Returns the total number of boxes and segments in the batches
+    std::size_t NPrimitives() const;
+
+  private:
+    /// Color, line width, line style and fill style
+    using Key_t = std::tuple<int, int, int, int>;
+
+    std::vector<std::unique_ptr<PrimitiveBatch2D>> fBatches; ///< in creation order
+    std::map<Key_t, PrimitiveBatch2D*> fIndex;               ///< batch by attributes
+
+  }; // class PrimitiveBatches2D
+
+} // namespace evd
+
+#endif // EVD_PRIMITIVEBATCH2D_H
@@ -52,10 +52,17 @@
  *   blank)
  */
 #include <algorithm> // std::fill(), std::find_if(), ...
+#include <atomic>
 #include <cmath>     // std::abs(), ...
 #include <cstddef>   // std::ptrdiff_t
+#include <cstdint>   // std::int64_t
+#include <future>    // std::async()
+#include <iterator>  // std::distance()
 #include <limits>    // std::numeric_limits<>
+#include <map>
 #include <memory>    // std::unique_ptr()
+#include <new>       // std::align_val_t
+#include <span>
 #include <tuple>
 #include <type_traits> // std::add_const_t<>, ...
 #include <typeinfo>    // to use typeid()
@@ -72,10 +79,12 @@
 #include "lardataalg/Utilities/StatCollector.h" // lar::util::MinMaxCollector<>
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RawData/raw.h"
+#include "lareventdisplay/EventDisplay/CellGridClass.h"
 #include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::PlaneDataChangeTracker_t
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RawDataDrawer.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WaveformCache.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
@@ -86,11 +95,14 @@
 #include "art/Framework/Principal/Handle.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/RunID.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/InputTag.h"
 #include "cetlib_except/demangle.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include "tbb/parallel_for_each.h"
+
 namespace {
   template <typename Stream, typename T>
   void PrintRange(Stream&& out, std::string header, lar::util::MinMaxCollector<T> const& range)
@@ -172,7 +184,93 @@ namespace details {
 namespace evd {
   namespace details {
 
-    /// Information about a RawDigit; may contain uncompressed duplicate of data
+    /// Returns the uncompressed samples of a raw digit
+    raw::RawDigit::ADCvector_t UncompressADCs(raw::RawDigit::ADCvector_t const& adcs,
+                                              size_t nSamples,
+                                              raw::Compress_t compression,
+                                              bool withPedestal,
+                                              int pedestal);
+
+    /**
+     * @brief Flat lookup table of channel information
+     *
+     * The wires of each channel are extracted from the geometry once per job
+     * and stored contiguously (a channel maps to a range of wire IDs).
+     * The channel conditions (status and pedestal) are cached per run:
+     * the status of all channels is read when the run changes, while the
+     * pedestal is queried the first time it is needed.
+     *
+     * The table is shared among all the drawers (see `Instance()`).
+     */
+    class ChannelInfoTableClass {
+    public:
+      /// A range of wire IDs
+      class WireIDRange_t {
+      public:
+        WireIDRange_t(geo::WireID const* b, geo::WireID const* e) : b(b), e(e) {}
+        geo::WireID const* begin() const { return b; }
+        geo::WireID const* end() const { return e; }
+        bool empty() const { return b == e; }
+
+      private:
+        geo::WireID const *b, *e;
+      }; // WireIDRange_t
+
+      /// Conditions of a single channel
+      struct ChannelConditions_t {
+        bool present = false; ///< whether the channel is present
+        bool bad = false;     ///< whether the channel is marked bad
+        lariov::ChannelStatusProvider::Status_t status =
+          lariov::ChannelStatusProvider::InvalidStatus; ///< channel status
+        mutable bool hasPedestal = false; ///< whether `pedestal` is cached
+        mutable float pedestal = 0.;      ///< pedestal mean from the database
+      };                                  // ChannelConditions_t
+
+      /// Returns the wires connected to the specified channel
+      WireIDRange_t WireIDs(raw::ChannelID_t channel) const;
+
+      /// Returns whether any of the wires of the channel is on the plane
+      bool isOnPlane(raw::ChannelID_t channel, geo::PlaneID const& pid) const;
+
+      /// Returns the conditions of the channel (current run)
+      ChannelConditions_t const& Conditions(raw::ChannelID_t channel) const;
+
+      /// Returns the pedestal mean of the channel from the database
+      float PedestalMean(raw::ChannelID_t channel) const;
+
+      /// Makes sure the conditions are up to date for the specified event
+      void UpdateConditions(art::Event const& evt);
+
+      /// Returns the table shared by all the drawers
+      static ChannelInfoTableClass& Instance();
+
+    private:
+      std::vector<geo::WireID> wireIDs;            ///< all wire IDs, by channel
+      std::vector<size_t> firstWireID;             ///< first wire ID of each channel
+      std::vector<ChannelConditions_t> conditions; ///< conditions, by channel
+      art::RunID conditionsRun;                    ///< run of the current conditions
+
+      /// Returns whether the channel is in the table
+      bool hasChannel(raw::ChannelID_t channel) const { return channel < conditions.size(); }
+
+      /// Fills the geometry information of the table (once per job)
+      void FillGeometry();
+
+    }; // class ChannelInfoTableClass
+
+    /// Type of a single uncompressed sample
+    using ADCsample_t = raw::RawDigit::ADCvector_t::value_type;
+
+    /// View of the uncompressed samples of a digit
+    using ADCspan_t = std::span<ADCsample_t const>;
+
+    /**
+     * @brief Information about a RawDigit; may contain uncompressed duplicate of data
+     *
+     * The uncompressed samples are owned (or shared with the waveform cache)
+     * until the digit is moved into a plane ADC matrix with `UseRow()`; from
+     * then on, they are a view into the matrix.
+     */
     class RawDigitInfo_t {
     public:
       /// Returns an art pointer to the actual digit
@@ -193,11 +291,23 @@ namespace evd {
       /// average charge
       //  short AverageCharge() const { return SampleInfo().average_charge; }
 
-      /// Returns the uncompressed data
-      raw::RawDigit::ADCvector_t const& Data() const;
+      /// Returns the uncompressed samples
+      ADCspan_t Samples() const;
+
+      /// Returns whether the uncompressed data is already available
+      bool hasData() const { return row || data.hasData(); }
+
+      /// Uses the specified samples as uncompressed data
+      void AdoptData(WaveformCache::RawSamplesPtr_t samples) const;
+
+      /// Uses the specified matrix row as uncompressed data, releasing any other copy
+      void UseRow(ADCsample_t const* samples, size_t nSamples) const;
+
+      /// Returns the memory held by this digit for the uncompressed samples [bytes]
+      size_t MemoryBytes() const;
 
-      /// Parses the specified digit
-      void Fill(art::Ptr<raw::RawDigit> const& src);
+      /// Parses the specified digit, coming from the specified waveform source
+      void Fill(art::Ptr<raw::RawDigit> const& src, WaveformCache::SourceID_t source);
 
       /// Deletes the data
       void Clear();
@@ -214,9 +324,17 @@ namespace evd {
 
       art::Ptr<raw::RawDigit> digit; ///< a pointer to the actual digit
 
+      WaveformCache::SourceID_t source = 0; ///< identifier in the waveform cache
+
       /// Uncompressed data
       mutable ::details::PointerToData_t<raw::RawDigit::ADCvector_t const> data;
 
+      /// Keeps the uncompressed data alive when shared with the waveform cache
+      mutable WaveformCache::RawSamplesPtr_t shared_data;
+
+      mutable ADCsample_t const* row = nullptr; ///< samples in a matrix (not owned)
+      mutable size_t row_size = 0;              ///< number of samples in `row`
+
       /// Information collected from the uncompressed data
       mutable std::unique_ptr<SampleInfo_t> sample_info;
 
@@ -231,26 +349,323 @@ namespace evd {
 
     }; // class RawDigitInfo_t
 
-    /// Cached set of RawDigitInfo_t
+    class ADCCorrectorClass;
+
+    /// Returns the pedestal of the digit according to the pedestal option
+    float DigitPedestal(raw::RawDigit const& digit, int pedestalOption);
+
+    /// Parameters of the search of the region of interest in the digits
+    struct RoISettings_t {
+      float threshold = 0.F;   ///< smallest interesting pedestal-subtracted ADC magnitude
+      int pedestalOption = -1; ///< choice of the pedestal (see `DigitPedestal()`)
+      size_t beginTick = 0;    ///< first tick of the search
+      size_t endTick = 0;      ///< tick after the last one of the search
+
+      bool operator==(RoISettings_t const& other) const
+      {
+        return (threshold == other.threshold) && (pedestalOption == other.pedestalOption) &&
+               (beginTick == other.beginTick) && (endTick == other.endTick);
+      }
+      bool operator!=(RoISettings_t const& other) const { return !(*this == other); }
+    }; // RoISettings_t
+
+    /// Ticks of a digit with samples above the region of interest threshold
+    struct DigitRoI_t {
+      bool found = false; ///< whether any sample is above threshold
+      size_t first = 0;   ///< first tick above threshold
+      size_t last = 0;    ///< last tick above threshold
+    };
+
+    /// Wires and ticks of a plane with samples above the region of interest threshold
+    struct PlaneRegion_t {
+      int wireMin = -1; ///< lowest wire
+      int wireMax = -1; ///< wire after the highest one
+      int timeMin = -1; ///< lowest tick
+      int timeMax = -1; ///< tick after the highest one
+    };
+
+    /// Returns the ticks of the `nSamples` samples above the threshold
+    DigitRoI_t FindRoI(ADCsample_t const* samples,
+                       size_t nSamples,
+                       float pedestal,
+                       RoISettings_t const& settings);
+
+    /**
+     * @brief Samples of one waveform aggregated in blocks of power-of-two ticks
+     *
+     * Each level `l` of the pyramid has one cell for each complete block of
+     * `2^l` ticks, starting from tick `0`; the samples at the end of the
+     * waveform which do not fill a complete block are not in that level.
+     * The finest level is `BaseLevel()`, and each coarser one is built merging
+     * pairs of cells of the previous one, up to a single cell.
+     * All the samples are pedestal-subtracted.
+     * The positive samples are also summed separately, so that the user can
+     * apply a charge correction to their average.
+     */
+    class ADCPyramidClass {
+    public:
+      /// Content of a block of ticks
+      struct Cell_t {
+        float adc = 0.F;             ///< sample with the largest magnitude
+        float charge = 0.F;          ///< sum of the samples
+        float convertedCharge = 0.F; ///< sum of the Birks-corrected samples
+      };
+
+      /// Returns the finest level of the pyramid
+      unsigned int BaseLevel() const { return baseLevel; }
+
+      /// Returns whether the specified level is available
+      bool hasLevel(unsigned int level) const
+      {
+        return (level >= baseLevel) && (level - baseLevel < levels.size());
+      }
+
+      /// Returns the cells of the specified level (which must be available)
+      std::vector<Cell_t> const& Level(unsigned int level) const
+      {
+        return levels[level - baseLevel];
+      }
+
+      /// Fills the pyramid from the `nSamples` samples of a waveform
+      void Build(ADCsample_t const* samples,
+                 size_t nSamples,
+                 float pedestal,
+                 unsigned int base,
+                 ADCCorrectorClass const& corrector);
+
+      /// Returns the memory used by the cells of all the levels [bytes]
+      size_t MemoryBytes() const;
+
+      /// Returns the lowest level with blocks of at least the specified ticks
+      static unsigned int LevelFor(unsigned int ticks);
+
+    private:
+      unsigned int baseLevel = 0; ///< finest level
+
+      std::vector<std::vector<Cell_t>> levels; ///< cells, from `baseLevel` up
+
+      /// Returns the cell with the content of both the specified ones
+      static Cell_t Merge(Cell_t const& a, Cell_t const& b);
+
+    }; // class ADCPyramidClass
+
+    /**
+     * @brief Uncompressed samples of all the digits on a plane, in one block
+     *
+     * Each digit on the plane is a row of a single wire-major matrix, in the
+     * order of `RawDigitCacheDataClass::DigitsOnPlane()`. Each row starts on a
+     * `Alignment` byte boundary, and the rows of digits shorter than the
+     * longest one are padded with zeroes (`RowSize()` is the actual number of
+     * samples). Next to the samples, a column holds the pedestal of each row,
+     * to be subtracted by the caller.
+     * The matrix is the storage of the samples of its digits, which only keep
+     * a view of their row.
+     */
+    class PlaneADCMatrixClass {
+    public:
+      /// Alignment of each row [bytes]
+      static constexpr size_t Alignment = 64;
+
+      /**
+       * @brief Moves the uncompressed samples of the specified digits, one per row
+       *
+       * The samples are copied in the matrix, and each digit is then pointed
+       * to its row (`RawDigitInfo_t::UseRow()`), releasing its own copy.
+       * The matrix must then outlive the digits, or be dropped with them.
+       */
+      void Fill(std::vector<RawDigitInfo_t> const& digits, std::vector<size_t> const& onPlane);
+
+      /// Sets the pedestal column (one pedestal per row) for the specified option
+      void SetPedestals(std::vector<float> const& rowPedestals, int pedestalOption);
+
+      /// Returns whether the pedestals are the ones of the specified option
+      bool hasPedestals(int pedestalOption) const { return pedestal_option == pedestalOption; }
+
+      /// Returns the number of rows (digits) in the matrix
+      size_t NRows() const { return row_sizes.size(); }
+
+      /// Returns the samples of the specified row
+      ADCsample_t const* Row(size_t iRow) const { return samples.get() + iRow * stride; }
+
+      /// Returns the number of samples in the specified row
+      size_t RowSize(size_t iRow) const { return row_sizes[iRow]; }
+
+      /// Returns the pedestal of the specified row
+      float Pedestal(size_t iRow) const { return pedestals[iRow]; }
+
+      /// Returns the memory used by the matrix and its columns [bytes]
+      size_t MemoryBytes() const
+      {
+        return NRows() * (stride * sizeof(ADCsample_t) + sizeof(size_t) + sizeof(float));
+      }
+
+    private:
+      /// Releases the memory of the samples
+      struct AlignedDelete_t {
+        void operator()(ADCsample_t* p) const
+        {
+          ::operator delete[](p, std::align_val_t(Alignment));
+        }
+      };
+
+      std::unique_ptr<ADCsample_t[], AlignedDelete_t> samples; ///< all the samples
+      size_t stride = 0;                                       ///< samples between rows
+
+      std::vector<size_t> row_sizes; ///< number of samples in each row
+      std::vector<float> pedestals;  ///< pedestal of each row
+      int pedestal_option = -1;      ///< pedestal option of `pedestals` (`-1`: none)
+
+    }; // class PlaneADCMatrixClass
+
+    /**
+     * @brief Cached set of RawDigitInfo_t from one data product
+     *
+     * Besides the digits, the cache holds a dense index from channel to digit,
+     * covering the range of channels of the product, so that `FindChannel()`
+     * takes constant time.
+     */
     class RawDigitCacheDataClass {
     public:
+      RawDigitCacheDataClass() = default;
+      ~RawDigitCacheDataClass() { StopPrefetch(); }
+
       /// Returns the list of digit info
       std::vector<RawDigitInfo_t> const& Digits() const { return digits; }
 
       /// Returns a pointer to the digit info of given channel, nullptr if none
       RawDigitInfo_t const* FindChannel(raw::ChannelID_t channel) const;
 
+      /// Returns the indices in Digits() of the digits with wires on the plane
+      std::vector<size_t> const& DigitsOnPlane(geo::PlaneID const& pid) const;
+
+      /**
+       * @brief Returns the pedestals of the digits on the plane
+       * @param pid the plane of the digits
+       * @param pedestalOption choice of the pedestal (see `DigitPedestal()`)
+       * @return pedestals, in the same order as `DigitsOnPlane(pid)`
+       *
+       * The pedestals are read once per plane and option, and they are dropped
+       * together with the digits.
+       * This must be called from the main thread only: the pedestals from the
+       * database are cached in the shared `ChannelInfoTableClass`, which is
+       * not protected against concurrent access.
+       */
+      std::vector<float> const& PlanePedestals(geo::PlaneID const& pid, int pedestalOption) const;
+
+      /**
+       * @brief Returns the ADC pyramids of the digits on the plane
+       * @param pid the plane of the digits
+       * @return pyramids, in the same order as `DigitsOnPlane(pid)`, or `nullptr`
+       *
+       * The pyramids are built by `UncompressPlane()`, and they are dropped
+       * together with the digits.
+       */
+      std::vector<ADCPyramidClass> const* PlanePyramids(geo::PlaneID const& pid) const;
+
+      /**
+       * @brief Uncompresses in parallel the digits on the plane
+       * @param pid the plane of the digits
+       * @param roi settings of the search of the region of interest
+       * @param pyramidBaseTicks ticks of the finest block of the ADC pyramids
+       * @param chargeCorrector correction of the charge in the ADC pyramids
+       *
+       * The digits on the plane which are not uncompressed yet are all
+       * uncompressed at once, in parallel, rather than one by one when their
+       * data is first requested. The digits on other planes are left
+       * compressed.
+       * In the same pass, the ticks above the region of interest threshold
+       * are found in each digit on the plane (see `PlaneRoIs()`), unless they
+       * were already found with the same settings.
+       * Also, unless `pyramidBaseTicks` is `0` or there is no
+       * `chargeCorrector`, the ADC pyramid of each digit is built (see
+       * `PlanePyramids()`), unless it was already built with the same
+       * settings; the corrector must be the same for all the calls on the
+       * same plane.
+       */
+      void UncompressPlane(geo::PlaneID const& pid,
+                           RoISettings_t const& roi,
+                           unsigned int pyramidBaseTicks = 0,
+                           ADCCorrectorClass const* chargeCorrector = nullptr) const;
+
+      /**
+       * @brief Returns the ticks above threshold of the digits on the plane
+       * @param pid the plane of the digits
+       * @param roi settings of the search of the region of interest
+       * @return ticks, in the same order as `DigitsOnPlane(pid)`, or `nullptr`
+       *
+       * The ticks are the ones found by `UncompressPlane()`; if that was not
+       * run with the same settings, `nullptr` is returned instead.
+       */
+      std::vector<DigitRoI_t> const* PlaneRoIs(geo::PlaneID const& pid,
+                                               RoISettings_t const& roi) const;
+
+      /**
+       * @brief Returns the region of interest of the plane, if known
+       * @param pid the plane
+       * @param roi settings of the search of the region of interest
+       * @return the region, or `nullptr` if not known for these settings
+       *
+       * The region is the one stored by `SetPlaneRegion()`. It is kept with the
+       * digits, so it survives a switch to another TPC of the same event.
+       */
+      PlaneRegion_t const* PlaneRegion(geo::PlaneID const& pid, RoISettings_t const& roi) const;
+
+      /**
+       * @brief Stores the region of interest of the plane
+       * @param pid the plane
+       * @param roi settings of the search of the region of interest
+       * @param region the region found with those settings
+       *
+       * The region is stored only if the plane was uncompressed with the same
+       * settings (see `UncompressPlane()`), and it is dropped when the ticks
+       * above threshold of the plane are searched again.
+       * Different planes can be stored concurrently.
+       */
+      void SetPlaneRegion(geo::PlaneID const& pid,
+                          RoISettings_t const& roi,
+                          PlaneRegion_t const& region) const;
+
+      /**
+       * @brief Returns the samples of the digits on the plane in a single matrix
+       * @param pid the plane of the digits
+       * @param roi settings of the region of interest, including the pedestal
+       * @return the matrix, with rows in the same order as `DigitsOnPlane(pid)`
+       *
+       * The matrix is filled the first time it is requested, after
+       * uncompressing the plane with `UncompressPlane()`, and it is dropped
+       * together with the digits.
+       */
+      PlaneADCMatrixClass const& PlaneMatrix(geo::PlaneID const& pid,
+                                             RoISettings_t const& roi) const;
+
+      /// Returns the memory used by the ADC matrices of all the planes [bytes]
+      size_t MatrixMemoryBytes() const;
+
+      /**
+       * @brief Returns the memory held by the cache [bytes]
+       *
+       * This includes the uncompressed samples held by the digits, the ADC
+       * matrices and the ADC pyramids. The samples shared with the waveform
+       * cache are counted, since they are kept alive by this cache; the digits
+       * moved into a matrix are counted only once, as part of the matrix.
+       */
+      size_t MemoryBytes() const;
+
       /// Returns the largest number of samples in the unpacked raw digits
       size_t MaxSamples() const { return max_samples; }
 
       /// Returns whether the cache is empty() (STL-like interface)
       bool empty() const { return digits.empty(); }
 
+      /// Returns the state the cache was last filled for
+      CacheID_t const& Timestamp() const { return timestamp; }
+
       /// Empties the cache
       void Clear();
 
       /// Fills the cache from the specified raw digits product handle
-      void Refill(art::Handle<std::vector<raw::RawDigit>>& rdcol);
+      void Refill(art::Handle<std::vector<raw::RawDigit>>& rdcol,
+                  WaveformCache::SourceID_t source);
 
       /// Clears the cache and marks it as invalid (use Update() to fill it)
       void Invalidate();
@@ -259,6 +674,30 @@ namespace evd {
       /// @return true if it needed to update (that might have failed)
       bool Update(art::Event const& evt, CacheID_t const& new_timestamp);
 
+      /**
+       * @brief Starts uncompressing all the cached digits in a separate thread
+       *
+       * The worker uncompresses a copy of the compressed data of the digits,
+       * and it never reads the product: art may delete the product of the
+       * event before the worker is stopped by the next `Clear()`.
+       * Each digit is uncompressed only once: by the worker, or by
+       * `DigitData()` if it is requested before the worker gets to it.
+       */
+      void StartPrefetch();
+
+      /// Stops the background uncompression, keeping what is already done
+      void StopPrefetch();
+
+      /**
+       * @brief Returns the uncompressed data of the specified digit
+       * @param iDigit index of the digit in `Digits()`
+       * @return the uncompressed samples of the digit
+       *
+       * If the digit is being uncompressed in background, this waits for the
+       * result and uses it. Different digits may be requested concurrently.
+       */
+      ADCspan_t DigitData(size_t iDigit) const;
+
       /// Dump the content of the cache
       template <typename Stream>
       void Dump(Stream&& out) const;
@@ -277,232 +716,148 @@ namespace evd {
         operator bool() const { return bUpToDate; }
       }; // struct BoolWithUpToDateMetadata
 
+      /// Value of `channel_digits` for channels without digit
+      static constexpr size_t NoDigit = std::numeric_limits<size_t>::max();
+
       std::vector<RawDigitInfo_t> digits; ///< vector of raw digit information
 
+      raw::ChannelID_t first_channel = 0; ///< channel of the first entry of `channel_digits`
+      std::vector<size_t> channel_digits; ///< index in `digits` of each channel, or `NoDigit`
+
       CacheID_t timestamp; ///< object expressing validity range of cached data
 
       size_t max_samples = 0; ///< the largest number of ticks in any digit
 
-      /// Checks whether an update is needed; can load digits in the process
-      BoolWithUpToDateMetadata CheckUpToDate(CacheID_t const& ts,
-                                             art::Event const* evt = nullptr) const;
-
-      static std::vector<raw::RawDigit> const* ReadProduct(art::Event const& evt,
-                                                           art::InputTag label);
-
-    }; // struct RawDigitCacheDataClass
-
-    std::vector<evd::details::RawDigitInfo_t>::const_iterator begin(
-      RawDigitCacheDataClass const& cache)
-    {
-      return cache.Digits().cbegin();
-    }
-    std::vector<evd::details::RawDigitInfo_t>::const_iterator end(
-      RawDigitCacheDataClass const& cache)
-    {
-      return cache.Digits().cend();
-    }
-
-    /// Manages a cell-like division of a coordinate
-    class GridAxisClass {
-    public:
-      /// Default constructor: an invalid range
-      GridAxisClass() { Init(0, 0., 0.); }
-
-      /// Constructor: sets the limits and the number of cells
-      GridAxisClass(size_t nDiv, float new_min, float new_max) { Init(nDiv, new_min, new_max); }
-
-      //@{
-      /// Returns the index of the specified cell
-      std::ptrdiff_t GetCell(float coord) const;
-      std::ptrdiff_t operator()(float coord) const { return GetCell(coord); }
-      //@}
-
-      /// Returns whether the cell is present or not
-      bool hasCell(std::ptrdiff_t iCell) const
-      {
-        return (iCell >= 0) && ((size_t)iCell < NCells());
-      }
+      /// Indices of the digits on each plane (filled on demand)
+      mutable std::map<geo::PlaneID, std::vector<size_t>> plane_digits;
 
-      /// Returns whether the coordinate is included in the range or not
-      bool hasCoord(float coord) const { return (coord >= Min()) && (coord < Max()); }
+      /// Pedestals of the digits on a plane, and how they were chosen
+      struct PlanePedestals_t {
+        int pedestalOption = -1;      ///< choice of the pedestal
+        std::vector<float> pedestals; ///< pedestal of each digit on the plane
+      };
 
-      //@{
-      /// Returns the extremes of the axis
-      float Min() const { return min; }
-      float Max() const { return max; }
-      //@}
+      /// Pedestals of the digits on each plane (filled on demand)
+      mutable std::map<geo::PlaneID, PlanePedestals_t> plane_pedestals;
 
-      /// Returns the length of the axis
-      float Length() const { return max - min; }
+      /// ADC pyramids of the digits on a plane, and how they were built
+      struct PlanePyramids_t {
+        unsigned int baseTicks = 0;            ///< ticks in the finest blocks
+        int pedestalOption = -1;               ///< choice of the subtracted pedestal
+        std::vector<ADCPyramidClass> pyramids; ///< pyramid of each digit on the plane
+      };
 
-      /// Returns the length of the axis
-      size_t NCells() const { return n_cells; }
+      /// ADC pyramids of the digits on each plane (filled on demand)
+      mutable std::map<geo::PlaneID, PlanePyramids_t> plane_pyramids;
 
-      /// Returns whether minimum and maximum match
-      bool isEmpty() const { return max == min; }
+      /// ADC matrices of the digits on each plane (filled on demand)
+      mutable std::map<geo::PlaneID, PlaneADCMatrixClass> plane_matrices;
 
-      /// Returns the cell size
-      float CellSize() const { return cell_size; }
+      /// Ticks above threshold of the digits on a plane, and how they were found
+      struct PlaneRoIs_t {
+        RoISettings_t settings;         ///< settings of the search
+        std::vector<DigitRoI_t> digits; ///< ticks of each digit on the plane
+        PlaneRegion_t region;           ///< region of interest of the plane
+        bool hasRegion = false;         ///< whether `region` is known
+      };
 
-      /// Returns the lower edge of the cell
-      float LowerEdge(std::ptrdiff_t iCell) const { return Min() + CellSize() * iCell; }
+      /// Ticks above threshold of the digits on each plane (filled on demand)
+      mutable std::map<geo::PlaneID, PlaneRoIs_t> plane_rois;
 
-      /// Returns the upper edge of the cell
-      float UpperEdge(std::ptrdiff_t iCell) const { return LowerEdge(iCell + 1); }
+      WaveformCache::SourceID_t source = 0; ///< identifier in the waveform cache
 
-      /// Initialize the axis, returns whether cell size is finite
-      bool Init(size_t nDiv, float new_min, float new_max);
+      /// Who is uncompressing a digit, when prefetching
+      enum PrefetchState_t : unsigned char {
+        psFree,    ///< nobody yet
+        psWorker,  ///< the background worker, which is not done yet
+        psDone,    ///< the background worker, which is done
+        psClaimed, ///< a user of the cache, which does not need the worker
+      };
 
-      /// Initialize the axis limits, returns whether cell size is finite
-      bool SetLimits(float new_min, float new_max);
+      /// Uncompression of a digit shared by the background worker and the users
+      struct PrefetchSlot_t {
+        std::atomic<unsigned char> state{psFree}; ///< who is uncompressing the digit
+        WaveformCache::RawSamplesPtr_t samples;   ///< result, set before `psDone`
+      };
 
-      /// Expands the cell (at fixed range) to meet minimum cell size
-      /// @return Whether the cell size was changed
-      bool SetMinCellSize(float min_size);
+      /// Copy of a compressed digit, owned by the background worker
+      struct CompressedDigit_t {
+        size_t iDigit;                   ///< index of the digit in `digits`
+        raw::ChannelID_t channel;        ///< channel of the digit
+        raw::Compress_t compression;     ///< compression of `adcs`
+        size_t nSamples;                 ///< number of uncompressed samples
+        int pedestal;                    ///< pedestal stored in the digit
+        raw::RawDigit::ADCvector_t adcs; ///< compressed samples
+      };
 
-      /// Expands the cell (at fixed range) to meet maximum cell size
-      /// @return Whether the cell size was changed
-      bool SetMaxCellSize(float max_size);
+      /// Uncompression status of each of the `digits` (`nullptr` if not prefetching)
+      std::unique_ptr<PrefetchSlot_t[]> prefetchSlots;
 
-      /// Expands the cell (at fixed range) to meet maximum cell size
-      /// @return Whether the cell size was changed
-      bool SetCellSizeBoundary(float min_size, float max_size)
-      {
-        return SetMinCellSize(min_size) || SetMaxCellSize(max_size);
-      }
+      std::future<void> prefetched;          ///< the background uncompression
+      std::atomic<bool> stopPrefetch{false}; ///< asks the background worker to stop
 
-      template <typename Stream>
-      void Dump(Stream&& out) const;
+      /**
+       * @brief Takes the digit away from the background worker
+       * @param iDigit index of the digit in `Digits()`
+       * @return the samples uncompressed by the worker, or `nullptr` if none
+       *
+       * If the worker is uncompressing the digit, this waits for it to finish.
+       * The slot of the digit does not keep any reference to the samples.
+       */
+      WaveformCache::RawSamplesPtr_t ClaimPrefetched(size_t iDigit) const;
 
-    private:
-      size_t n_cells; ///< number of cells in the axis
-      float min, max; ///< extremes of the axis
+      /// Checks whether an update is needed; can load digits in the process
+      BoolWithUpToDateMetadata CheckUpToDate(CacheID_t const& ts,
+                                             art::Event const* evt = nullptr) const;
 
-      float cell_size; ///< size of each cell
+      static std::vector<raw::RawDigit> const* ReadProduct(art::Event const& evt,
+                                                           art::InputTag label);
 
-    }; // GridAxisClass
+    }; // struct RawDigitCacheDataClass
 
-    /// Manages a grid-like division of 2D space
-    class CellGridClass {
+    /**
+     * @brief Caches of the raw digits of several data products
+     *
+     * Detectors may split their raw digits in several data products (e.g. one
+     * per TPC or per APA), and the drawers look for a plane in each of them.
+     * A cache is kept for each product, so that moving from a product to
+     * another does not need to read and uncompress the digits again.
+     * When a new event is selected, the caches of the products of the
+     * previous event are emptied.
+     */
+    class RawDigitCacheSetClass {
     public:
-      /// Default constructor: invalid ranges
-      CellGridClass() : wire_axis(), tdc_axis() {}
-
-      /// Constructor: sets the extremes and assumes one cell for each element
-      CellGridClass(unsigned int nWires, unsigned int nTDC);
-
-      /// Constructor: sets the wire and TDC ranges in detail
-      CellGridClass(float min_wire,
-                    float max_wire,
-                    unsigned int nWires,
-                    float min_tdc,
-                    float max_tdc,
-                    unsigned int nTDC);
-
-      /// Returns the total number of cells in the grid
-      size_t NCells() const { return wire_axis.NCells() * tdc_axis.NCells(); }
-
-      /// Return the information about the wires
-      GridAxisClass const& WireAxis() const { return wire_axis; }
-
-      /// Return the information about the TDCs
-      GridAxisClass const& TDCAxis() const { return tdc_axis; }
-
-      /// Returns the index of specified cell, or -1 if out of range
-      std::ptrdiff_t GetCell(float wire, float tick) const;
-
-      /// Returns the coordinates { w1, t1, w2, t2 } of specified cell
-      std::tuple<float, float, float, float> GetCellBox(std::ptrdiff_t iCell) const;
-
-      //@{
-      /// Returns whether the range includes the specified wire
-      bool hasWire(float wire) const { return wire_axis.hasCoord(wire); }
-      bool hasWire(int wire) const { return hasWire((float)wire); }
-      //@}
-
-      //@{
-      /// Returns whether the range includes the specified wire
-      bool hasTick(float tick) const { return tdc_axis.hasCoord(tick); }
-      bool hasTick(int tick) const { return hasTick((float)tick); }
-      //@}
-
-      /// Increments the specified cell of cont with the value v
-      /// @return whether there was such a cell
-      template <typename CONT>
-      bool Add(CONT& cont, float wire, float tick, typename CONT::value_type v)
-      {
-        std::ptrdiff_t cell = GetCell(wire, tick);
-        if (cell < 0) return false;
-        cont[(size_t)cell] += v;
-        return true;
-      } // Add()
-
-      /// @name Setters
-      /// @{
-      /// Sets a simple wire range: all the wires, one cell per wire
-      void SetWireRange(unsigned int nWires) { SetWireRange(0., (float)nWires, nWires); }
-
-      /// Sets the wire range, leaving the number of wire cells unchanged
-      void SetWireRange(float min_wire, float max_wire) { wire_axis.SetLimits(min_wire, max_wire); }
-
-      /// Sets the complete wire range
-      void SetWireRange(float min_wire, float max_wire, unsigned int nWires)
-      {
-        wire_axis.Init(nWires, min_wire, max_wire);
-      }
+      /// Returns the cache of the product of `new_timestamp`, updated to it
+      RawDigitCacheDataClass& Update(art::Event const& evt, CacheID_t const& new_timestamp);
 
-      /// Sets the complete wire range, with minimum cell size
-      void SetWireRange(float min_wire, float max_wire, unsigned int nWires, float min_size)
-      {
-        wire_axis.Init(nWires, min_wire, max_wire);
-        wire_axis.SetMinCellSize(min_size);
-      }
-
-      /// Sets a simple TDC range: all the ticks, one cell per tick
-      void SetTDCRange(unsigned int nTDC) { SetTDCRange(0., (float)nTDC, nTDC); }
-
-      /// Sets the complete TDC range
-      void SetTDCRange(float min_tdc, float max_tdc, unsigned int nTDC)
-      {
-        tdc_axis.Init(nTDC, min_tdc, max_tdc);
-      }
-
-      /// Sets the TDC range, leaving the number of ticks unchanged
-      void SetTDCRange(float min_tdc, float max_tdc) { tdc_axis.SetLimits(min_tdc, max_tdc); }
-
-      /// Sets the complete TDC range, with minimum cell size
-      void SetTDCRange(float min_tdc, float max_tdc, unsigned int nTDC, float min_size)
-      {
-        tdc_axis.Init(nTDC, min_tdc, max_tdc);
-        tdc_axis.SetMinCellSize(min_size);
-      }
-
-      /// @}
-
-      /// Sets the minimum size for wire cells
-      bool SetMinWireCellSize(float min_size) { return wire_axis.SetMinCellSize(min_size); }
+    private:
+      /// A cache and the product it holds
+      struct ProductCache_t {
+        art::InputTag label;                          ///< the product of the cache
+        std::unique_ptr<RawDigitCacheDataClass> data; ///< the cache
+      };
 
-      /// Sets the minimum size for TDC cells
-      bool SetMinTDCCellSize(float min_size) { return tdc_axis.SetMinCellSize(min_size); }
+      std::vector<ProductCache_t> caches; ///< caches for each of the products
 
-      /// Prints the current axes on the specified stream
-      template <typename Stream>
-      void Dump(Stream&& out) const;
+    }; // class RawDigitCacheSetClass
 
-    private:
-      GridAxisClass wire_axis;
-      GridAxisClass tdc_axis;
-    }; // CellGridClass
+    std::vector<evd::details::RawDigitInfo_t>::const_iterator begin(
+      RawDigitCacheDataClass const& cache)
+    {
+      return cache.Digits().cbegin();
+    }
+    std::vector<evd::details::RawDigitInfo_t>::const_iterator end(
+      RawDigitCacheDataClass const& cache)
+    {
+      return cache.Digits().cend();
+    }
 
     //--------------------------------------------------------------------------
     /// Applies Birks correction
     class ADCCorrectorClass {
     public:
-      ADCCorrectorClass(detinfo::DetectorPropertiesData const& dp, geo::PlaneID const& pid)
-        : detProp{dp}
-        , wirePitch{art::ServiceHandle<geo::WireReadout const>()->Get().Plane(pid).WirePitch()}
-        , electronsToADC{dp.ElectronsToADC()}
+      ADCCorrectorClass(detinfo::DetectorPropertiesData const& dp, double pitch)
+        : detProp{dp}, wirePitch{pitch}, electronsToADC{dp.ElectronsToADC()}
       {}
 
       /// Applies Birks correction to the specified pedestal-subtracted charge
@@ -528,13 +883,65 @@ namespace evd {
   // empty vector
   std::vector<raw::RawDigit> const RawDataDrawer::EmptyRawDigits;
 
+  //......................................................................
+  /// Drawing material prepared by PrepareRawDigit2D(), waiting for a view
+  struct RawDataDrawer::PreparedDrawing_t {
+    util::EventChangeTracker_t event;      ///< event the material belongs to
+    geo::PlaneID pid;                      ///< plane the material belongs to
+    details::CellGridClass requestedRange; ///< viewport the material was prepared for
+    bool zoomToRoI = false;                ///< whether the material is zoomed to the RoI
+    details::CellGridClass drawingRange;   ///< grid the boxes refer to
+    std::vector<BoxInfo_t> boxInfo;        ///< content of the cells
+    bool ready = false;                    ///< whether the material is complete
+
+    void Clear()
+    {
+      ready = false;
+      boxInfo.clear();
+    }
+  }; // RawDataDrawer::PreparedDrawing_t
+
+  //......................................................................
+  /// Information from services and conditions needed by the operations on a
+  /// plane, collected by StartRawDigit2D() on the main thread
+  struct RawDataDrawer::PlaneSetup_t {
+    geo::PlaneID pid;                  ///< plane the information belongs to
+    details::RoISettings_t roi;        ///< settings of the search of the region of interest
+    std::vector<bool> process;         ///< whether each digit on the plane is processed
+    double wirePitch = 0.;             ///< wire pitch on the plane
+    unsigned int nWires = 0;           ///< number of wires on the plane
+    float ticksPerPoint = 1.F;         ///< smallest TDC cell [ticks]
+    unsigned int pyramidBaseTicks = 0; ///< ticks in the finest ADC pyramid blocks (0: none)
+    bool ready = false;                ///< whether the information is complete
+
+    /// Samples of the digits on the plane, if kept in a matrix
+    details::PlaneADCMatrixClass const* matrix = nullptr;
+
+    /// Pedestal of each digit on the plane
+    std::vector<float> const* pedestals = nullptr;
+
+    /// Wires of the channels
+    details::ChannelInfoTableClass const* channels = nullptr;
+
+    void Clear()
+    {
+      ready = false;
+      process.clear();
+      pedestals = nullptr;
+      matrix = nullptr;
+    }
+  }; // RawDataDrawer::PlaneSetup_t
+
   //......................................................................
   RawDataDrawer::RawDataDrawer()
-    : digit_cache(new details::RawDigitCacheDataClass)
+    : digit_cache(nullptr)
+    , digit_caches(new details::RawDigitCacheSetClass)
     , fStartTick(0)
     , fTicks(2048)
     , fCacheID(new details::CacheID_t)
     , fDrawingRange(new details::CellGridClass)
+    , fPrepared(new PreparedDrawing_t)
+    , fSetup(new PlaneSetup_t)
   {
     art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
     geo::TPCID tpcid(rawopt->fCryostat, rawopt->fTPC);
@@ -556,7 +963,9 @@ namespace evd {
   //......................................................................
   RawDataDrawer::~RawDataDrawer()
   {
-    delete digit_cache;
+    delete digit_caches;
+    delete fSetup;
+    delete fPrepared;
     delete fDrawingRange;
     delete fCacheID;
   }
@@ -574,7 +983,7 @@ namespace evd {
     // we need to set the minimum cell size to 1, otherwise some cell will not
     // cover any wire/tick and they will be always empty
     if (PadResolution) {
-      // TODO implement support for swapping axes here
+      // the resolution is stored along wires and ticks, whatever the orientation of the axes
       unsigned int wire_pixels = PadResolution.width;
       unsigned int tdc_pixels = PadResolution.height;
       fDrawingRange->SetWireRange(low_wire, high_wire, wire_pixels, 1.F);
@@ -604,33 +1013,39 @@ namespace evd {
     TFrame const* pFrame = pPad->GetFrame();
     if (pFrame) {
       // these coordinates are used to find the actual extent of pad in pixels
-      double low_wire = pFrame->GetX1(), high_wire = pFrame->GetX2();
-      double low_tdc = pFrame->GetY1(), high_tdc = pFrame->GetY2();
-      double const wire_pixels = pPad->XtoAbsPixel(high_wire) - pPad->XtoAbsPixel(low_wire);
-      double const tdc_pixels = -(pPad->YtoAbsPixel(high_tdc) - pPad->YtoAbsPixel(low_tdc));
+      double low_x = pFrame->GetX1(), high_x = pFrame->GetX2();
+      double low_y = pFrame->GetY1(), high_y = pFrame->GetY2();
+      double const x_pixels = pPad->XtoAbsPixel(high_x) - pPad->XtoAbsPixel(low_x);
+      double const y_pixels = -(pPad->YtoAbsPixel(high_y) - pPad->YtoAbsPixel(low_y));
 
-      PadResolution.width = (unsigned int)wire_pixels;
-      PadResolution.height = (unsigned int)tdc_pixels;
-
-      log << "\n frame window is " << PadResolution.width << "x" << PadResolution.height
+      log << "\n frame window is " << (unsigned int)x_pixels << "x" << (unsigned int)y_pixels
           << " pixel big and";
       // those coordinates also are a (unreliable) estimation of the zoom;
       // if we have a better one, let's use it
       // (this does not change the size of the window in terms of pixels)
       if (zoom) {
         log << ", from external source,";
-        low_wire = (*zoom)[0];
-        high_wire = (*zoom)[1];
-        low_tdc = (*zoom)[2];
-        high_tdc = (*zoom)[3];
+        low_x = (*zoom)[0];
+        high_x = (*zoom)[1];
+        low_y = (*zoom)[2];
+        high_y = (*zoom)[3];
       }
 
+      // with the swapped orientation (ticks on the horizontal axis),
+      // wires are on the vertical axis of the pad
+      art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+      bool const swapped = (rawopt->fAxisOrientation > 0);
+      double const low_wire = swapped ? low_y : low_x, high_wire = swapped ? high_y : high_x;
+      double const low_tdc = swapped ? low_x : low_y, high_tdc = swapped ? high_x : high_y;
+      double const wire_pixels = swapped ? y_pixels : x_pixels;
+      double const tdc_pixels = swapped ? x_pixels : y_pixels;
+
+      PadResolution.width = (unsigned int)wire_pixels;
+      PadResolution.height = (unsigned int)tdc_pixels;
+
       log << " spans wires " << low_wire << "-" << high_wire << " and TDC " << low_tdc << "-"
           << high_tdc;
 
-      // TODO support swapping axes here:
-      // if (rawopt.fAxisOrientation < 1) { normal ; } else { swapped; }
-
       fDrawingRange->SetWireRange(low_wire, high_wire, (unsigned int)wire_pixels, 1.0);
       fDrawingRange->SetTDCRange(low_tdc, high_tdc, (unsigned int)tdc_pixels, 1.0);
     }
@@ -657,6 +1072,59 @@ namespace evd {
 
     virtual bool Operate(geo::WireID const& wireID, size_t tick, float adc) = 0;
 
+    /**
+     * @brief Processes all the samples of a wire in the specified tick range
+     * @param wireID the wire the samples belong to
+     * @param samples all the samples of the channel
+     * @param begin_tick first tick to be processed
+     * @param end_tick tick after the last one to be processed
+     * @param pedestal the pedestal to be subtracted from each sample
+     * @return whether the operation was successful
+     *
+     * The default implementation calls `ProcessTick()` and `Operate()` for
+     * each tick; derived classes can override it with a faster loop.
+     */
+    virtual bool OperateOnWire(geo::WireID const& wireID,
+                               details::ADCsample_t const* samples,
+                               size_t begin_tick,
+                               size_t end_tick,
+                               float pedestal)
+    {
+      for (size_t iTick = begin_tick; iTick < end_tick; ++iTick) {
+        if (!ProcessTick(iTick)) continue;
+        if (!Operate(wireID, iTick, samples[iTick] - pedestal)) return false;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Processes a wire of a digit in the specified tick range
+     * @param wireID the wire the samples belong to
+     * @param iOnPlane index of the digit among the ones on the plane
+     * @param samples all the uncompressed samples of the digit
+     * @param nSamples number of samples of the digit
+     * @param begin_tick first tick to be processed
+     * @param end_tick tick after the last one to be processed
+     * @param pedestal the pedestal to be subtracted from each sample
+     * @return whether the operation was successful
+     *
+     * The samples come either from the digit itself or from the ADC matrix of
+     * the plane (`details::PlaneADCMatrixClass`).
+     * The default implementation calls `OperateOnWire()` on the uncompressed
+     * samples of the digit; derived classes can use other representations of
+     * the digit content (e.g. `details::ADCPyramidClass`).
+     */
+    virtual bool OperateOnDigit(geo::WireID const& wireID,
+                                size_t /* iOnPlane */,
+                                details::ADCsample_t const* samples,
+                                size_t /* nSamples */,
+                                size_t begin_tick,
+                                size_t end_tick,
+                                float pedestal)
+    {
+      return OperateOnWire(wireID, samples, begin_tick, end_tick, pedestal);
+    }
+
     virtual bool Finish() { return true; }
 
     virtual std::string Name() const { return cet::demangle_symbol(typeid(*this).name()); }
@@ -713,6 +1181,33 @@ namespace evd {
       return true;
     }
 
+    bool OperateOnWire(geo::WireID const& wireID,
+                       details::ADCsample_t const* samples,
+                       size_t begin_tick,
+                       size_t end_tick,
+                       float pedestal) override
+    {
+      for (std::unique_ptr<OperationBaseClass> const& op : operations)
+        if (!op->OperateOnWire(wireID, samples, begin_tick, end_tick, pedestal)) return false;
+      return true;
+    }
+
+    bool OperateOnDigit(geo::WireID const& wireID,
+                        size_t iOnPlane,
+                        details::ADCsample_t const* samples,
+                        size_t nSamples,
+                        size_t begin_tick,
+                        size_t end_tick,
+                        float pedestal) override
+    {
+      for (std::unique_ptr<OperationBaseClass> const& op : operations) {
+        if (!op->OperateOnDigit(
+              wireID, iOnPlane, samples, nSamples, begin_tick, end_tick, pedestal))
+          return false;
+      }
+      return true;
+    }
+
     bool Finish() override
     {
       bool bAllOk = true;
@@ -757,12 +1252,20 @@ namespace evd {
   }; // class RawDataDrawer::ManyOperations
 
   //......................................................................
-  bool RawDataDrawer::RunOperation(art::Event const& evt, OperationBaseClass* operation)
+  bool RawDataDrawer::RunOperation(OperationBaseClass* operation)
   {
     geo::PlaneID const& pid = operation->PlaneID();
-    art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
 
-    if (digit_cache->empty()) return true;
+    if (!digit_cache || digit_cache->empty()) return true;
+
+    // the operations may be running concurrently on other planes:
+    // everything from services and conditions comes from StartRawDigit2D()
+    PlaneSetup_t const& setup = *fSetup;
+    if (!setup.ready || (setup.pid != pid)) {
+      throw art::Exception(art::errors::LogicError)
+        << "RawDataDrawer::RunOperation(): " << std::string(pid)
+        << " was not set up by StartRawDigit2D()";
+    }
 
     MF_LOG_DEBUG("RawDataDrawer") << "RawDataDrawer::RunOperation() running " << operation->Name();
 
@@ -770,91 +1273,48 @@ namespace evd {
     // but it's way better if the failure throws an exception
     if (!operation->Initialize()) return false;
 
-    lariov::ChannelStatusProvider const& channelStatus =
-      art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
-
-    //get pedestal conditions
-    const lariov::DetPedestalProvider& pedestalRetrievalAlg =
-      *(lar::providerFrom<lariov::DetPedestalService>());
-
-    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
-
-    // loop over all the channels/raw digits
-    for (evd::details::RawDigitInfo_t const& digit_info : *digit_cache) {
-      raw::RawDigit const& hit = digit_info.Digit();
-      raw::ChannelID_t const channel = hit.Channel();
-
-      // skip the bad channels
-      if (!channelStatus.IsPresent(channel)) continue;
-      // The following test is meant to be temporary until the "correct" solution is implemented
-      if (!ProcessChannelWithStatus(channelStatus.Status(channel))) continue;
-
-      // we have a list of all channels, but we are drawing only on one plane;
-      // most of the channels will not contribute to this plane,
-      // and before we start querying databases, unpacking data etc.
-      // we want to know it's for something
-
-      std::vector<geo::WireID> WireIDs = wireReadoutGeom.ChannelToWire(channel);
-
-      bool bDrawChannel = false;
-      for (geo::WireID const& wireID : WireIDs) {
-        if (wireID.planeID() != pid) continue; // not us!
-        bDrawChannel = true;
-        break;
-      } // for wires
-      if (!bDrawChannel) continue;
-
-      // collect bad channels
-      bool const bGood = rawopt->fSeeBadChannels || !channelStatus.IsBad(channel);
-
-      // nothing else to be done if the channel is not good:
-      // cells are marked bad by default and if any good channel falls in any of
-      // them, they become good
-      if (!bGood) continue;
+    // loop over the raw digits with wires on this plane only;
+    // they have all been uncompressed already
+    std::vector<size_t> const& digitsOnPlane = digit_cache->DigitsOnPlane(pid);
+    for (size_t iOnPlane = 0; iOnPlane < digitsOnPlane.size(); ++iOnPlane) {
+      // skip the bad channels, and the ones with a status we don't want;
+      // cells are marked bad by default and if any good channel falls in any
+      // of them, they become good
+      if (!setup.process[iOnPlane]) continue;
 
       // at this point we know we have to process this channel
-      raw::RawDigit::ADCvector_t const& uncompressed = digit_info.Data();
-
-      // recover the pedestal
-      float pedestal = 0;
-      if (rawopt->fPedestalOption == 0) { pedestal = pedestalRetrievalAlg.PedMean(channel); }
-      else if (rawopt->fPedestalOption == 1) {
-        pedestal = hit.GetPedestal();
-      }
-      else if (rawopt->fPedestalOption == 2) {
-        pedestal = 0;
+      // recover the samples and the pedestal
+      details::ADCsample_t const* samples = nullptr;
+      size_t nSamples = 0;
+      if (setup.matrix) {
+        samples = setup.matrix->Row(iOnPlane);
+        nSamples = setup.matrix->RowSize(iOnPlane);
       }
       else {
-        mf::LogWarning("RawDataDrawer")
-          << " PedestalOption is not understood: " << rawopt->fPedestalOption
-          << ".  Pedestals not subtracted.";
+        details::ADCspan_t const adcs = digit_cache->Digits()[digitsOnPlane[iOnPlane]].Samples();
+        samples = adcs.data();
+        nSamples = adcs.size();
       }
+      float const pedestal = (*setup.pedestals)[iOnPlane];
+      raw::ChannelID_t const channel = digit_cache->Digits()[digitsOnPlane[iOnPlane]].Channel();
 
       // loop over all the wires that are covered by this channel;
       // without knowing better, we have to draw into all of them
-      for (geo::WireID const& wireID : WireIDs) {
+      for (geo::WireID const& wireID : setup.channels->WireIDs(channel)) {
         // check that the plane and tpc are the correct ones to draw
         if (wireID.planeID() != pid) continue; // not us!
 
         // do we have anything to do with this wire?
         if (!operation->ProcessWire(wireID)) continue;
 
-        // get an iterator over the adc values
-        // accumulate all the data of this wire in our "cells"
-        size_t const max_tick = std::min({uncompressed.size(), size_t(fStartTick + fTicks)});
-
-        for (size_t iTick = fStartTick; iTick < max_tick; ++iTick) {
-
-          // do we have anything to do with this wire?
-          if (!operation->ProcessTick(iTick)) continue;
+        // accumulate all the data of this wire in our "cells", in one go
+        size_t const max_tick = std::min(nSamples, size_t(fStartTick + fTicks));
 
-          float const adc = uncompressed[iTick] - pedestal;
-          //std::cout << "adc, pedestal: " << adc << " " << pedestal << std::endl;
+        if (!operation->OperateOnDigit(
+              wireID, iOnPlane, samples, nSamples, fStartTick, max_tick, pedestal))
+          return false;
 
-          if (!operation->Operate(wireID, iTick, adc)) return false;
-
-        } // if good
-      }   // for wires
+      } // for wires
     }     // for channels
 
     return operation->Finish();
@@ -872,23 +1332,49 @@ namespace evd {
       , rawCharge(0.)
       , convertedCharge(0.)
       , drawingRange(*(dataDrawer->fDrawingRange))
-      , ADCCorrector(detProp, PlaneID())
+      , ADCCorrector(detProp, dataDrawer->fSetup->wirePitch)
     {}
 
     bool Initialize() override
     {
-      art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+      PlaneSetup_t const& setup = *(RawDataDrawerPtr()->fSetup);
 
       // set up the size of the grid to be visualized;
       // the information on the size has to be already there:
       // caller should have user ExtractRange(), or similar, first.
       // set the minimum cell in ticks to at least match fTicksPerPoint
-      drawingRange.SetMinTDCCellSize((float)rawopt->fTicksPerPoint);
+      drawingRange.SetMinTDCCellSize(setup.ticksPerPoint);
       // also set the minimum wire cell size to 1,
       // otherwise there will be cells represented by no wire.
       drawingRange.SetMinWireCellSize(1.F);
       boxInfo.clear();
       boxInfo.resize(drawingRange.NCells());
+
+      // find the ticks where each TDC cell ends, for OperateOnWire()
+      details::GridAxisClass const& tdcAxis = drawingRange.TDCAxis();
+      firstTick = (tdcAxis.Min() > 0.F) ? size_t(std::ceil(tdcAxis.Min())) : 0U;
+      tdcCellEnd.resize(tdcAxis.NCells());
+      size_t tick = firstTick;
+      for (size_t iCell = 0; iCell < tdcCellEnd.size(); ++iCell) {
+        while (tdcAxis.hasCoord((float)tick) &&
+               (tdcAxis.GetCell((float)tick) <= (std::ptrdiff_t)iCell))
+          ++tick;
+        tdcCellEnd[iCell] = tick;
+      } // for
+
+      // with cells of many ticks, read the pyramid level of blocks not larger than a cell
+      pyramidLevel = -1;
+      if (setup.pyramidBaseTicks > 0) {
+        pyramidBaseLevel = details::ADCPyramidClass::LevelFor(setup.pyramidBaseTicks);
+        float const cellTicks = tdcAxis.CellSize();
+        if (cellTicks >= float(1U << pyramidBaseLevel)) {
+          unsigned int level = pyramidBaseLevel;
+          while (float(2U << level) <= cellTicks)
+            ++level;
+          pyramids = RawDataDrawerPtr()->digit_cache->PlanePyramids(PlaneID());
+          if (pyramids) pyramidLevel = level;
+        }
+      }
       return true;
     }
 
@@ -917,6 +1403,137 @@ namespace evd {
       return true;
     }
 
+    bool OperateOnWire(geo::WireID const& wireID,
+                       details::ADCsample_t const* samples,
+                       size_t begin_tick,
+                       size_t end_tick,
+                       float pedestal) override
+    {
+      if (!ProcessWire(wireID)) return true;
+      std::ptrdiff_t const wireCell = drawingRange.WireAxis().GetCell((float)wireID.Wire);
+      if (!drawingRange.WireAxis().hasCell(wireCell)) return true;
+
+      size_t const nTDCCells = tdcCellEnd.size();
+      BoxInfo_t* const wireInfo = boxInfo.data() + wireCell * nTDCCells;
+
+      // start from the first TDC cell which does not end before our first tick
+      size_t tick = std::max(begin_tick, firstTick);
+      size_t iCell = std::distance(
+        tdcCellEnd.begin(), std::upper_bound(tdcCellEnd.begin(), tdcCellEnd.end(), tick));
+
+      // the samples not below the pedestal are positive
+      details::ADCsample_t const positiveFrom = PositiveFrom(pedestal);
+
+      // one cell at a time, each cell being a contiguous range of samples
+      double wireRawCharge = 0., wireConvertedCharge = 0.;
+      for (; iCell < nTDCCells; ++iCell) {
+        if (tick >= end_tick) break;
+        size_t const cellEnd = std::min(tdcCellEnd[iCell], end_tick);
+        if (tick >= cellEnd) continue; // no tick in this cell
+
+        BoxInfo_t& info = wireInfo[iCell];
+        info.good = true; // if in range, we mark this cell as good
+
+        // the loop runs on the integer samples, with no branch nor call,
+        // so that the compiler can vectorize it; the pedestal is subtracted
+        // from the results of the whole cell
+        size_t const cellStart = tick;
+        size_t const nCellTicks = cellEnd - cellStart;
+        std::int64_t sampleSum = 0;
+        details::ADCsample_t sampleMin = std::numeric_limits<details::ADCsample_t>::max();
+        details::ADCsample_t sampleMax = std::numeric_limits<details::ADCsample_t>::lowest();
+        for (; tick < cellEnd; ++tick) {
+          details::ADCsample_t const sample = samples[tick];
+          sampleSum += sample;
+          sampleMin = std::min(sampleMin, sample);
+          sampleMax = std::max(sampleMax, sample);
+        } // for ticks
+
+        // draw maximum digit in the cell
+        float const cellMax = sampleMax - pedestal, cellMin = sampleMin - pedestal;
+        float const cellADC = (std::abs(cellMin) <= std::abs(cellMax)) ? cellMax : cellMin;
+        if (std::abs(info.adc) <= std::abs(cellADC)) info.adc = cellADC;
+
+        wireRawCharge += double(sampleSum) - double(pedestal) * nCellTicks;
+
+        // the Birks correction is not linear, so it is applied to each sample,
+        // as Operate() does; the correction of negative charge is 0
+        if (sampleMax < positiveFrom) continue;
+        for (size_t iTick = cellStart; iTick < cellEnd; ++iTick) {
+          if (samples[iTick] >= positiveFrom)
+            wireConvertedCharge += ADCCorrector(samples[iTick] - pedestal);
+        }
+      } // for cells
+
+      rawCharge += wireRawCharge;
+      convertedCharge += wireConvertedCharge;
+      return true;
+    } // OperateOnWire()
+
+    bool OperateOnDigit(geo::WireID const& wireID,
+                        size_t iOnPlane,
+                        details::ADCsample_t const* samples,
+                        size_t /* nSamples */,
+                        size_t begin_tick,
+                        size_t end_tick,
+                        float pedestal) override
+    {
+      if (pyramidLevel < 0) return OperateOnWire(wireID, samples, begin_tick, end_tick, pedestal);
+
+      if (!ProcessWire(wireID)) return true;
+      std::ptrdiff_t const wireCell = drawingRange.WireAxis().GetCell((float)wireID.Wire);
+      if (!drawingRange.WireAxis().hasCell(wireCell)) return true;
+
+      // the pyramid was built when the plane was uncompressed
+      details::ADCPyramidClass const& pyramid = (*pyramids)[iOnPlane];
+      if (!pyramid.hasLevel(pyramidLevel))
+        return OperateOnWire(wireID, samples, begin_tick, end_tick, pedestal);
+
+      size_t const startTick = std::max(begin_tick, firstTick);
+      size_t const stopTick = std::min(end_tick, tdcCellEnd.empty() ? 0U : tdcCellEnd.back());
+      if (startTick >= stopTick) return true;
+
+      // the samples not in a complete block within the range are read directly
+      std::vector<details::ADCPyramidClass::Cell_t> const& blocks = pyramid.Level(pyramidLevel);
+      size_t const blockTicks = size_t(1) << pyramidLevel;
+      size_t const firstBlock = (startTick + blockTicks - 1) / blockTicks;
+      size_t const endBlock = std::min(stopTick / blockTicks, blocks.size());
+      if (firstBlock >= endBlock)
+        return OperateOnWire(wireID, samples, startTick, stopTick, pedestal);
+      if (!OperateOnWire(wireID, samples, startTick, firstBlock * blockTicks, pedestal))
+        return false;
+      if (!OperateOnWire(wireID, samples, endBlock * blockTicks, stopTick, pedestal))
+        return false;
+
+      // each block is assigned to the cell with both its start and end ticks;
+      // since blocks are not larger than cells, a block may at most straddle
+      // two cells, and in that case its samples are read directly
+      BoxInfo_t* const wireInfo = boxInfo.data() + wireCell * tdcCellEnd.size();
+      size_t iCell = 0;
+      double wireRawCharge = 0., wireConvertedCharge = 0.;
+      for (size_t iBlock = firstBlock; iBlock < endBlock; ++iBlock) {
+        size_t const blockStart = iBlock * blockTicks;
+        size_t const blockEnd = blockStart + blockTicks;
+        while (tdcCellEnd[iCell] <= blockStart)
+          ++iCell;
+        if (tdcCellEnd[iCell] < blockEnd) {
+          if (!OperateOnWire(wireID, samples, blockStart, blockEnd, pedestal)) return false;
+          continue;
+        }
+
+        details::ADCPyramidClass::Cell_t const& block = blocks[iBlock];
+        BoxInfo_t& info = wireInfo[iCell];
+        info.good = true; // if in range, we mark this cell as good
+        if (std::abs(info.adc) <= std::abs(block.adc)) info.adc = block.adc;
+        wireRawCharge += block.charge;
+        wireConvertedCharge += block.convertedCharge;
+      } // for blocks
+
+      rawCharge += wireRawCharge;
+      convertedCharge += wireConvertedCharge;
+      return true;
+    } // OperateOnDigit()
+
     bool Finish() override
     {
       // write the information back
@@ -928,19 +1545,46 @@ namespace evd {
       // from configuration (see Initialize())
       *(RawDataDrawerPtr()->fDrawingRange) = drawingRange;
 
-      // complete the drawing
-      RawDataDrawerPtr()->QueueDrawingBoxes(view, PlaneID(), boxInfo);
+      // complete the drawing, or leave it for later if there is no view yet
+      if (view)
+        RawDataDrawerPtr()->QueueDrawingBoxes(view, PlaneID(), boxInfo);
+      else {
+        PreparedDrawing_t& prepared = *(RawDataDrawerPtr()->fPrepared);
+        prepared.pid = PlaneID();
+        prepared.drawingRange = drawingRange;
+        prepared.boxInfo = std::move(boxInfo);
+        prepared.ready = true;
+      }
 
       return true;
     }
 
   private:
-    evdb::View2D* view;
+    evdb::View2D* view; ///< target view (if null, drawing is only prepared)
 
     double rawCharge = 0., convertedCharge = 0.;
     details::CellGridClass drawingRange;
     std::vector<BoxInfo_t> boxInfo;
     details::ADCCorrectorClass ADCCorrector;
+
+    size_t firstTick = 0;           ///< first tick in the drawing range
+    std::vector<size_t> tdcCellEnd; ///< tick after the last one of each TDC cell
+
+    int pyramidLevel = -1;             ///< level to read (negative: none)
+    unsigned int pyramidBaseLevel = 0; ///< finest level of the pyramids
+
+    /// Pyramids of the digits on the plane
+    std::vector<details::ADCPyramidClass> const* pyramids = nullptr;
+
+    /// Returns the smallest sample value not below the specified pedestal
+    static details::ADCsample_t PositiveFrom(float pedestal)
+    {
+      using Limits_t = std::numeric_limits<details::ADCsample_t>;
+      float const threshold = std::ceil(pedestal);
+      if (threshold <= float(Limits_t::lowest())) return Limits_t::lowest();
+      if (threshold >= float(Limits_t::max())) return Limits_t::max();
+      return details::ADCsample_t(threshold);
+    } // PositiveFrom()
   }; // class RawDataDrawer::BoxDrawer
 
   void RawDataDrawer::QueueDrawingBoxes(evdb::View2D* view,
@@ -1028,8 +1672,9 @@ namespace evd {
     if (rawopt->fDrawRawDataOrCalibWires == 1) return;
 
     geo::PlaneID const pid(rawopt->CurrentTPC(), plane);
+    if (!StartRawDigit2D(evt, detProp, plane)) return;
     BoxDrawer drawer(detProp, pid, this, view);
-    if (!RunOperation(evt, &drawer)) {
+    if (!RunOperation(&drawer)) {
       throw art::Exception(art::errors::Unknown) << "RawDataDrawer::RunDrawOperation(): "
                                                     "somewhere something went somehow wrong";
     }
@@ -1042,10 +1687,17 @@ namespace evd {
     float const RoIthreshold;
 
     RoIextractorClass(geo::PlaneID const& pid, RawDataDrawer* data_drawer)
-      : OperationBaseClass(pid, data_drawer)
-      , RoIthreshold(art::ServiceHandle<evd::RawDrawingOptions const>()->RoIthreshold(PlaneID()))
+      : OperationBaseClass(pid, data_drawer), RoIthreshold(data_drawer->fSetup->roi.threshold)
     {}
 
+    bool Initialize() override
+    {
+      // the ticks above threshold were found when uncompressing the plane
+      RawDataDrawer* const drawer = RawDataDrawerPtr();
+      digitRoIs = drawer->digit_cache->PlaneRoIs(PlaneID(), drawer->fSetup->roi);
+      return true;
+    }
+
     bool Operate(geo::WireID const& wireID, size_t tick, float adc) override
     {
       if (std::abs(adc) < RoIthreshold) return true;
@@ -1054,6 +1706,55 @@ namespace evd {
       return true;
     } // Operate()
 
+    bool OperateOnWire(geo::WireID const& wireID,
+                       details::ADCsample_t const* samples,
+                       size_t begin_tick,
+                       size_t end_tick,
+                       float pedestal) override
+    {
+      // only the first and the last sample above threshold can change the range
+      auto const aboveThreshold = [samples, pedestal, this](size_t tick) {
+        float const adc = samples[tick] - pedestal;
+        return std::abs(adc) >= RoIthreshold;
+      };
+
+      size_t first = begin_tick;
+      while ((first < end_tick) && !aboveThreshold(first))
+        ++first;
+      if (first >= end_tick) return true; // nothing above threshold
+
+      size_t last = end_tick - 1;
+      while (!aboveThreshold(last))
+        --last;
+
+      WireRange.add(wireID.Wire);
+      TDCrange.add(first);
+      TDCrange.add(last);
+      return true;
+    } // OperateOnWire()
+
+    bool OperateOnDigit(geo::WireID const& wireID,
+                        size_t iOnPlane,
+                        details::ADCsample_t const* samples,
+                        size_t nSamples,
+                        size_t begin_tick,
+                        size_t end_tick,
+                        float pedestal) override
+    {
+      if (!digitRoIs) {
+        return OperationBaseClass::OperateOnDigit(
+          wireID, iOnPlane, samples, nSamples, begin_tick, end_tick, pedestal);
+      }
+
+      details::DigitRoI_t const& roi = (*digitRoIs)[iOnPlane];
+      if (!roi.found) return true; // nothing above threshold
+
+      WireRange.add(wireID.Wire);
+      TDCrange.add(roi.first);
+      TDCrange.add(roi.last);
+      return true;
+    } // OperateOnDigit()
+
     bool Finish() override
     {
       geo::PlaneID::PlaneID_t const plane = PlaneID().Plane;
@@ -1063,11 +1764,10 @@ namespace evd {
       int& TimeMax = pRawDataDrawer->fTimeMax[plane];
 
       if ((WireMin == WireMax) && WireRange.has_data()) {
-        auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout>()->Get();
         mf::LogInfo("RawDataDrawer")
           << "Region of interest for " << std::string(PlaneID()) << " detected to be within wires "
           << WireRange.min() << " to " << WireRange.max() << " (plane has "
-          << wireReadoutGeom.Nwires(PlaneID()) << " wires)";
+          << pRawDataDrawer->fSetup->nWires << " wires)";
         WireMax = WireRange.max() + 1;
         WireMin = WireRange.min();
       }
@@ -1078,14 +1778,25 @@ namespace evd {
         TimeMax = TDCrange.max() + 1;
         TimeMin = TDCrange.min();
       }
+
+      // the region is kept with the digits, for when we are back on this plane
+      if (pRawDataDrawer->hasRegionOfInterest(plane)) {
+        pRawDataDrawer->digit_cache->SetPlaneRegion(
+          PlaneID(), pRawDataDrawer->fSetup->roi, {WireMin, WireMax, TimeMin, TimeMax});
+      }
       return true;
     } // Finish()
 
   private:
     lar::util::MinMaxCollector<float> WireRange, TDCrange;
+
+    /// Ticks above threshold of each digit on the plane (`nullptr` if not available)
+    std::vector<details::DigitRoI_t> const* digitRoIs = nullptr;
   }; // class RawDataDrawer::RoIextractorClass
 
-  void RawDataDrawer::RunRoIextractor(art::Event const& evt, unsigned int plane)
+  void RawDataDrawer::RunRoIextractor(art::Event const& evt,
+                                      detinfo::DetectorPropertiesData const& detProp,
+                                      unsigned int plane)
   {
     art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
     geo::PlaneID const pid(rawopt->CurrentTPC(), plane);
@@ -1097,9 +1808,10 @@ namespace evd {
                                   << " on this draw";
 
     if (!bExtractRoI) return;
+    if (!StartRawDigit2D(evt, detProp, plane)) return;
 
     RoIextractorClass Extractor(pid, this);
-    if (!RunOperation(evt, &Extractor)) {
+    if (!RunOperation(&Extractor)) {
       throw std::runtime_error(
         "RawDataDrawer::RunRoIextractor(): somewhere something went somehow wrong");
     }
@@ -1125,12 +1837,39 @@ namespace evd {
     // (ok, now it's private, but it could be exposed)
     if (!bDraw) return;
 
+    // if PrepareRawDigit2D() has already done the work for this very viewport,
+    // we just send it to the view; in any case, the material is used only once
+    if (fPrepared->ready && (fPrepared->pid == pid) && fPrepared->event.same(evt) &&
+        (fPrepared->requestedRange == *fDrawingRange) && (fPrepared->zoomToRoI == bZoomToRoI)) {
+      MF_LOG_DEBUG("RawDataDrawer") << __func__ << "() using prepared drawing for " << pid;
+      *fDrawingRange = fPrepared->drawingRange;
+      QueueDrawingBoxes(view, pid, fPrepared->boxInfo);
+      fPrepared->Clear();
+      return;
+    }
+    fPrepared->Clear();
+
+    if (!StartRawDigit2D(evt, detProp, plane)) return;
+
+    FillRawDigit2D(detProp, view, pid, bZoomToRoI);
+
+  } // RawDataDrawer::RawDigit2D()
+
+  //......................................................................
+  bool RawDataDrawer::StartRawDigit2D(art::Event const& evt,
+                                      detinfo::DetectorPropertiesData const& detProp,
+                                      unsigned int plane)
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+    geo::PlaneID const pid(rawopt->CurrentTPC(), plane);
+
+    fPrepared->Clear();
+    fSetup->Clear();
+
     // Need to loop over the labels, but we don't want to zap existing cached RawDigits that are valid
-    // So... do the painful search to make sure the RawDigits we recover at those we are searching for.
+    // So... look for the first RawDigits with any channel on this plane.
     bool theDroidIAmLookingFor = false;
 
-    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
-
     // Loop over labels
     for (const auto& rawDataLabel : rawopt->fRawDataLabels) {
       // make sure we reset what needs to be reset
@@ -1139,24 +1878,81 @@ namespace evd {
       details::CacheID_t NewCacheID(evt, rawDataLabel, pid);
       GetRawDigits(evt, NewCacheID);
 
-      // Painful check to see if these RawDigits contain the droids we are looking for
-      for (const auto& rawDigit : digit_cache->Digits()) {
-        std::vector<geo::WireID> WireIDs = wireReadoutGeom.ChannelToWire(rawDigit.Channel());
-
-        for (geo::WireID const& wireID : WireIDs) {
-          if (wireID.planeID() != pid) continue; // not us!
-          theDroidIAmLookingFor = true;
-          break;
-        } // for wires
-
-        if (theDroidIAmLookingFor) break;
-      }
-
+      // the list of digits on the plane is cached, and used later for drawing
+      theDroidIAmLookingFor = !digit_cache->DigitsOnPlane(pid).empty();
       if (theDroidIAmLookingFor) break;
     }
 
-    if (!theDroidIAmLookingFor) return;
+    if (!theDroidIAmLookingFor) return false;
+
+    // the operations might be running concurrently on other planes:
+    // everything they need from services and conditions is collected here
+    PlaneSetup_t& setup = *fSetup;
+    setup.pid = pid;
+    setup.roi = RoISettings(pid);
+    setup.ticksPerPoint = (float)rawopt->fTicksPerPoint;
+    setup.pyramidBaseTicks = rawopt->fADCPyramidBaseTicks;
+
+    geo::PlaneGeo const& planeGeo = art::ServiceHandle<geo::WireReadout const>()->Get().Plane(pid);
+    setup.wirePitch = planeGeo.WirePitch();
+    setup.nWires = planeGeo.Nwires();
+
+    details::ChannelInfoTableClass& channelTable = details::ChannelInfoTableClass::Instance();
+    channelTable.UpdateConditions(evt);
+    setup.channels = &channelTable;
+
+    std::vector<size_t> const& digitsOnPlane = digit_cache->DigitsOnPlane(pid);
+    setup.process.reserve(digitsOnPlane.size());
+    for (size_t const iDigit : digitsOnPlane) {
+      raw::RawDigit const& digit = digit_cache->Digits()[iDigit].Digit();
+      details::ChannelInfoTableClass::ChannelConditions_t const& conditions =
+        channelTable.Conditions(digit.Channel());
+
+      // skip the bad channels;
+      // the status test is meant to be temporary until the "correct" solution is implemented
+      setup.process.push_back(conditions.present && ProcessChannelWithStatus(conditions.status) &&
+                              (rawopt->fSeeBadChannels || !conditions.bad));
+    } // for
+    setup.pedestals = &(digit_cache->PlanePedestals(pid, rawopt->fPedestalOption));
+
+    // all the data of the plane is needed: uncompress it in bulk,
+    // optionally into a single matrix; this also finds the region of interest
+    // of each digit and builds its ADC pyramid, which the operations may use
+    // from their initialization
+    details::ADCCorrectorClass const chargeCorrector(detProp, setup.wirePitch);
+    digit_cache->UncompressPlane(pid, setup.roi, setup.pyramidBaseTicks, &chargeCorrector);
+    if (rawopt->fPlaneADCMatrix) setup.matrix = &(digit_cache->PlaneMatrix(pid, setup.roi));
+
+    setup.ready = true;
+    return true;
+  } // RawDataDrawer::StartRawDigit2D()
 
+  //......................................................................
+  void RawDataDrawer::PrepareRawDigit2D(art::Event const& evt,
+                                        detinfo::DetectorPropertiesData const& detProp,
+                                        unsigned int plane,
+                                        bool bZoomToRoI /* = false */
+  )
+  {
+    // this may run in a worker thread: no service is used from here on
+    geo::PlaneID const pid(fSetup->pid.asTPCID(), plane);
+
+    // no view: the result is stored for RawDigit2D(), which will use it only
+    // if asked for the same viewport (the range is changed by the zoom to RoI)
+    details::CellGridClass const requestedRange = *fDrawingRange;
+    FillRawDigit2D(detProp, nullptr, pid, bZoomToRoI);
+    fPrepared->event.set(evt);
+    fPrepared->requestedRange = requestedRange;
+    fPrepared->zoomToRoI = bZoomToRoI;
+  } // RawDataDrawer::PrepareRawDigit2D()
+
+  //......................................................................
+  void RawDataDrawer::FillRawDigit2D(detinfo::DetectorPropertiesData const& detProp,
+                                     evdb::View2D* view,
+                                     geo::PlaneID const& pid,
+                                     bool bZoomToRoI)
+  {
+    geo::PlaneID::PlaneID_t const plane = pid.Plane;
     bool const hasRoI = hasRegionOfInterest(plane);
 
     // - if we don't have a RoI yet, we want to get it while we draw
@@ -1185,7 +1981,7 @@ namespace evd {
         pManyOps->AddOperation(std::move(extractor));
       }
 
-      if (!RunOperation(evt, operation.get())) {
+      if (!RunOperation(operation.get())) {
         throw art::Exception(art::errors::Unknown) << "RawDataDrawer::RunDrawOperation(): "
                                                       "somewhere something went somehow wrong";
       }
@@ -1195,7 +1991,7 @@ namespace evd {
       if (!hasRoI) {
         MF_LOG_DEBUG("RawDataDrawer") << __func__ << "() setting up RoI extraction for " << pid;
         RoIextractorClass extractor(pid, this);
-        if (!RunOperation(evt, &extractor)) {
+        if (!RunOperation(&extractor)) {
           throw art::Exception(art::errors::Unknown)
             << "RawDataDrawer::RunDrawOperation():"
                " something went somehow wrong while extracting RoI";
@@ -1214,12 +2010,12 @@ namespace evd {
       // then we draw
       MF_LOG_DEBUG("RawDataDrawer") << __func__ << "() setting up drawing";
       BoxDrawer drawer(detProp, pid, this, view);
-      if (!RunOperation(evt, &drawer)) {
+      if (!RunOperation(&drawer)) {
         throw art::Exception(art::errors::Unknown) << "RawDataDrawer::RunDrawOperation():"
                                                       " something went somehow wrong while drawing";
       }
     }
-  } // RawDataDrawer::RawDigit2D()
+  } // RawDataDrawer::FillRawDigit2D()
 
   //........................................................................
   int RawDataDrawer::GetRegionOfInterest(int plane, int& minw, int& maxw, int& mint, int& maxt)
@@ -1265,65 +2061,57 @@ namespace evd {
     art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
     if (rawopt->fDrawRawDataOrCalibWires == 1) return;
 
-    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
-
     geo::PlaneID const pid(rawopt->CurrentTPC(), plane);
 
+    details::ChannelInfoTableClass& channelTable = details::ChannelInfoTableClass::Instance();
+    channelTable.UpdateConditions(evt);
+
     for (const auto& rawDataLabel : rawopt->fRawDataLabels) {
       details::CacheID_t NewCacheID(evt, rawDataLabel, pid);
       GetRawDigits(evt, NewCacheID);
 
-      lariov::ChannelStatusProvider const& channelStatus =
-        art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
-
-      //get pedestal conditions
-      const lariov::DetPedestalProvider& pedestalRetrievalAlg =
-        art::ServiceHandle<lariov::DetPedestalService const>()->GetPedestalProvider();
-
-      for (evd::details::RawDigitInfo_t const& digit_info : *digit_cache) {
+      details::RoISettings_t const roiSettings = RoISettings(pid);
+      details::PlaneADCMatrixClass const* matrix = nullptr;
+      if (rawopt->fPlaneADCMatrix)
+        matrix = &(digit_cache->PlaneMatrix(pid, roiSettings));
+      else
+        digit_cache->UncompressPlane(pid, roiSettings);
+
+      // each digit on the plane is counted once, even if the channel has more
+      // than one wire on the plane
+      std::vector<size_t> const& digitsOnPlane = digit_cache->DigitsOnPlane(pid);
+      std::vector<float> const& pedestals =
+        digit_cache->PlanePedestals(pid, roiSettings.pedestalOption);
+      for (size_t iOnPlane = 0; iOnPlane < digitsOnPlane.size(); ++iOnPlane) {
+        evd::details::RawDigitInfo_t const& digit_info =
+          digit_cache->Digits()[digitsOnPlane[iOnPlane]];
         raw::RawDigit const& hit = digit_info.Digit();
         raw::ChannelID_t const channel = hit.Channel();
 
-        if (!channelStatus.IsPresent(channel)) continue;
+        details::ChannelInfoTableClass::ChannelConditions_t const& conditions =
+          channelTable.Conditions(channel);
+
+        if (!conditions.present) continue;
 
         // The following test is meant to be temporary until the "correct" solution is implemented
-        if (!ProcessChannelWithStatus(channelStatus.Status(channel))) continue;
+        if (!ProcessChannelWithStatus(conditions.status)) continue;
 
         // to be explicit: we don't cound bad channels in
-        if (!rawopt->fSeeBadChannels && channelStatus.IsBad(channel)) continue;
-
-        std::vector<geo::WireID> wireids = wireReadoutGeom.ChannelToWire(channel);
-        for (auto const& wid : wireids) {
-          // check that the plane and tpc are the correct ones to draw
-          if (wid.planeID() != pid) continue;
-
-          raw::RawDigit::ADCvector_t const& uncompressed = digit_info.Data();
-
-          //float const pedestal = pedestalRetrievalAlg.PedMean(channel);
-          // recover the pedestal
-          float pedestal = 0;
-          if (rawopt->fPedestalOption == 0) { pedestal = pedestalRetrievalAlg.PedMean(channel); }
-          else if (rawopt->fPedestalOption == 1) {
-            pedestal = hit.GetPedestal();
-          }
-          else if (rawopt->fPedestalOption == 2) {
-            pedestal = 0;
-          }
-          else {
-            mf::LogWarning("RawDataDrawer")
-              << " PedestalOption is not understood: " << rawopt->fPedestalOption
-              << ".  Pedestals not subtracted.";
-          }
-
-          for (short d : uncompressed)
-            histo->Fill(float(d) - pedestal);
-
-          // this channel is on the correct plane, don't double count the raw signal
-          // if there are more than one wids for the channel
-          break;
-        } // end loop over wids
-      }   //end loop over raw hits
-    }     //end loop over labels
+        if (!rawopt->fSeeBadChannels && conditions.bad) continue;
+
+        if (matrix) {
+          details::ADCsample_t const* samples = matrix->Row(iOnPlane);
+          float const pedestal = matrix->Pedestal(iOnPlane);
+          for (size_t iTick = 0; iTick < matrix->RowSize(iOnPlane); ++iTick)
+            histo->Fill(float(samples[iTick]) - pedestal);
+          continue;
+        }
+
+        float const pedestal = pedestals[iOnPlane];
+        for (short d : digit_info.Samples())
+          histo->Fill(float(d) - pedestal);
+      } //end loop over raw hits
+    }   //end loop over labels
   }
 
   //......................................................................
@@ -1346,7 +2134,7 @@ namespace evd {
       details::CacheID_t NewCacheID(evt, rawDataLabel, pid);
       GetRawDigits(evt, NewCacheID);
 
-      if (digit_cache->empty()) return;
+      if (digit_cache->empty()) continue;
 
       geo::WireID const wireid(pid, wire);
 
@@ -1359,20 +2147,18 @@ namespace evd {
       } // if no channel
 
       // check the channel status; bad channels are still ok.
-      lariov::ChannelStatusProvider const& channelStatus =
-        art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
+      details::ChannelInfoTableClass& channelTable = details::ChannelInfoTableClass::Instance();
+      channelTable.UpdateConditions(evt);
+      details::ChannelInfoTableClass::ChannelConditions_t const& conditions =
+        channelTable.Conditions(channel);
 
-      if (!channelStatus.IsPresent(channel)) return;
+      if (!conditions.present) return;
 
       // The following test is meant to be temporary until the "correct" solution is implemented
-      if (!ProcessChannelWithStatus(channelStatus.Status(channel))) return;
+      if (!ProcessChannelWithStatus(conditions.status)) return;
 
       // we accept to see the content of a bad channel, so this is commented out:
-      if (!rawopt->fSeeBadChannels && channelStatus.IsBad(channel)) return;
-
-      //get pedestal conditions
-      const lariov::DetPedestalProvider& pedestalRetrievalAlg =
-        art::ServiceHandle<lariov::DetPedestalService const>()->GetPedestalProvider();
+      if (!rawopt->fSeeBadChannels && conditions.bad) return;
 
       // find the raw digit
       // (iDigit is an iterator to a evd::details::RawDigitInfo_t)
@@ -1383,22 +2169,11 @@ namespace evd {
         continue;
       }
 
-      raw::RawDigit::ADCvector_t const& uncompressed = pDigit->Data();
+      details::ADCspan_t const uncompressed =
+        digit_cache->DigitData(pDigit - digit_cache->Digits().data());
 
       // recover the pedestal
-      float pedestal = 0;
-      if (rawopt->fPedestalOption == 0) { pedestal = pedestalRetrievalAlg.PedMean(channel); }
-      else if (rawopt->fPedestalOption == 1) {
-        pedestal = pDigit->DigitPtr()->GetPedestal();
-      }
-      else if (rawopt->fPedestalOption == 2) {
-        pedestal = 0;
-      }
-      else {
-        mf::LogWarning("RawDataDrawer")
-          << " PedestalOption is not understood: " << rawopt->fPedestalOption
-          << ".  Pedestals not subtracted.";
-      }
+      float const pedestal = details::DigitPedestal(pDigit->Digit(), rawopt->fPedestalOption);
 
       for (size_t j = 0; j < uncompressed.size(); ++j)
         histo->Fill(float(j), float(uncompressed[j]) - pedestal);
@@ -1428,6 +2203,25 @@ namespace evd {
 
   } // RawDataDrawer::ResetRegionOfInterest()
 
+  //......................................................................
+  void RawDataDrawer::RestoreRegionOfInterest(geo::TPCID const& tpcid)
+  {
+    if (!digit_cache) return;
+
+    for (geo::PlaneID::PlaneID_t plane = 0; plane < fWireMin.size(); ++plane) {
+      geo::PlaneID const pid(tpcid, plane);
+      details::PlaneRegion_t const* region = digit_cache->PlaneRegion(pid, RoISettings(pid));
+      if (!region) continue;
+
+      MF_LOG_DEBUG("RawDataDrawer") << "Restoring the region of interest of " << pid;
+      fWireMin[plane] = region->wireMin;
+      fWireMax[plane] = region->wireMax;
+      fTimeMin[plane] = region->timeMin;
+      fTimeMax[plane] = region->timeMax;
+    } // for planes
+
+  } // RawDataDrawer::RestoreRegionOfInterest()
+
   //......................................................................
 
   void RawDataDrawer::GetRawDigits(art::Event const& evt, details::CacheID_t const& new_timestamp)
@@ -1435,12 +2229,16 @@ namespace evd {
     MF_LOG_DEBUG("RawDataDrawer") << "GetRawDigits() for " << new_timestamp
                                   << " (last for: " << *fCacheID << ")";
 
-    // update cache
-    digit_cache->Update(evt, new_timestamp);
+    // update the cache of this product, which becomes the current one
+    digit_cache = &(digit_caches->Update(evt, new_timestamp));
 
     // if time stamp is changing, we want to reconsider which region is
-    // interesting
-    if (!fCacheID->sameTPC(new_timestamp)) ResetRegionOfInterest();
+    // interesting; the regions already found in this event are kept with the
+    // digits, and they are still good
+    if (!fCacheID->sameTPC(new_timestamp)) {
+      ResetRegionOfInterest();
+      RestoreRegionOfInterest(new_timestamp.planeID().asTPCID());
+    }
 
     // all the caches have been properly updated or invalidated;
     // we are now on a new cache state
@@ -1464,66 +2262,155 @@ namespace evd {
     return true;
   } // RawDataDrawer::ProcessChannel()
 
+  //----------------------------------------------------------------------------
+  details::RoISettings_t RawDataDrawer::RoISettings(geo::PlaneID const& pid) const
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+    details::RoISettings_t settings;
+    settings.threshold = rawopt->RoIthreshold(pid);
+    settings.pedestalOption = rawopt->fPedestalOption;
+    settings.beginTick = size_t(fStartTick);
+    settings.endTick = size_t(fStartTick + fTicks);
+    return settings;
+  } // RawDataDrawer::RoISettings()
+
   //----------------------------------------------------------------------------
   namespace details {
 
+    //--------------------------------------------------------------------------
+    raw::RawDigit::ADCvector_t UncompressADCs(raw::RawDigit::ADCvector_t const& adcs,
+                                              size_t nSamples,
+                                              raw::Compress_t compression,
+                                              bool withPedestal,
+                                              int pedestal)
+    {
+      raw::RawDigit::ADCvector_t samples(nSamples);
+      if (withPedestal) //Use pedestal in uncompression
+        Uncompress(adcs, samples, pedestal, compression);
+      else
+        Uncompress(adcs, samples, compression);
+      return samples;
+    } // UncompressADCs()
+
+    //--------------------------------------------------------------------------
+    float DigitPedestal(raw::RawDigit const& digit, int pedestalOption)
+    {
+      switch (pedestalOption) {
+      case 0: return ChannelInfoTableClass::Instance().PedestalMean(digit.Channel());
+      case 1: return digit.GetPedestal();
+      case 2: return 0.F;
+      default:
+        mf::LogWarning("RawDataDrawer") << " PedestalOption is not understood: " << pedestalOption
+                                        << ".  Pedestals not subtracted.";
+        return 0.F;
+      } // switch
+    }   // DigitPedestal()
+
+    //--------------------------------------------------------------------------
+    DigitRoI_t FindRoI(ADCsample_t const* samples,
+                       size_t nSamples,
+                       float pedestal,
+                       RoISettings_t const& settings)
+    {
+      auto const aboveThreshold = [samples, pedestal, &settings](size_t tick) {
+        float const adc = samples[tick] - pedestal;
+        return std::abs(adc) >= settings.threshold;
+      };
+
+      // only the first and the last sample above threshold matter
+      DigitRoI_t roi;
+      size_t const endTick = std::min(nSamples, settings.endTick);
+      size_t first = settings.beginTick;
+      while ((first < endTick) && !aboveThreshold(first))
+        ++first;
+      if (first >= endTick) return roi; // nothing above threshold
+
+      size_t last = endTick - 1;
+      while (!aboveThreshold(last))
+        --last;
+
+      roi.found = true;
+      roi.first = first;
+      roi.last = last;
+      return roi;
+    } // FindRoI()
+
     //--------------------------------------------------------------------------
     //--- RawDigitInfo_t
     //---
-    raw::RawDigit::ADCvector_t const& RawDigitInfo_t::Data() const
+    ADCspan_t RawDigitInfo_t::Samples() const
     {
+      if (row) return {row, row_size};
       if (!data.hasData()) UncompressData();
-      return *data;
-    } // RawDigitInfo_t::Data()
+      return {data->data(), data->size()};
+    } // RawDigitInfo_t::Samples()
 
-    void RawDigitInfo_t::Fill(art::Ptr<raw::RawDigit> const& src)
+    void RawDigitInfo_t::UseRow(ADCsample_t const* samples, size_t nSamples) const
     {
       data.Clear();
+      shared_data.reset(); // the waveform cache may now drop its copy
+      row = samples;
+      row_size = nSamples;
+    } // RawDigitInfo_t::UseRow()
+
+    size_t RawDigitInfo_t::MemoryBytes() const
+    {
+      // the samples of uncompressed digits and matrix rows are not held here
+      return shared_data ? shared_data->size() * sizeof(ADCsample_t) : 0;
+    } // RawDigitInfo_t::MemoryBytes()
+
+    void RawDigitInfo_t::Fill(art::Ptr<raw::RawDigit> const& src,
+                              WaveformCache::SourceID_t new_source)
+    {
+      data.Clear();
+      shared_data.reset();
+      row = nullptr;
+      row_size = 0;
       digit = src;
+      source = new_source;
     } // RawDigitInfo_t::Fill()
 
     void RawDigitInfo_t::Clear()
     {
       data.Clear();
+      shared_data.reset();
+      row = nullptr;
+      row_size = 0;
       sample_info.reset();
     }
 
+    void RawDigitInfo_t::AdoptData(WaveformCache::RawSamplesPtr_t samples) const
+    {
+      row = nullptr;
+      row_size = 0;
+      data.PointToData(*samples);
+      shared_data = std::move(samples);
+    } // RawDigitInfo_t::AdoptData()
+
     void RawDigitInfo_t::UncompressData() const
     {
       data.Clear();
+      shared_data.reset();
+      row = nullptr;
+      row_size = 0;
 
       if (!digit) return; // no original data, can't do anything
 
-      art::ServiceHandle<evd::RawDrawingOptions const> drawopt;
-
       if (digit->Compression() == kNone) {
         // no compression, we can refer to the original data directly
         data.PointToData(digit->ADCs());
       }
       else {
-        // data is compressed, need to do the real work
-        if (drawopt->fUncompressWithPed) { //Use pedestal in uncompression
-          int pedestal = (int)digit->GetPedestal();
-          raw::RawDigit::ADCvector_t samples;
-          samples.resize(digit->Samples());
-          Uncompress(digit->ADCs(), samples, pedestal, digit->Compression());
-          data.StealData(std::move(samples));
-        }
-        else {
-          raw::RawDigit::ADCvector_t samples;
-          samples.resize(digit->Samples());
-          Uncompress(digit->ADCs(), samples, digit->Compression());
-          data.StealData(std::move(samples));
-        }
+        // data is compressed: the shared cache might have done the work already
+        AdoptData(WaveformCache::Instance().RawDigitSamples(source, *digit));
       }
     } // RawDigitInfo_t::UncompressData()
 
     void RawDigitInfo_t::CollectSampleInfo() const
     {
-      raw::RawDigit::ADCvector_t const& samples = Data();
+      ADCspan_t const samples = Samples();
 
-      lar::util::MinMaxCollector<raw::RawDigit::ADCvector_t::value_type> stat(samples.begin(),
-                                                                              samples.end());
+      lar::util::MinMaxCollector<ADCsample_t> stat(samples.begin(), samples.end());
 
       sample_info.reset(new SampleInfo_t);
       sample_info->min_charge = stat.min();
@@ -1546,25 +2433,411 @@ namespace evd {
         out << " uncompressed data";
       else
         out << " data items compressed with <" << digit->Compression() << ">";
-      if (data.hasData())
+      if (row)
+        out << " with data in a matrix (" << row_size << " samples)";
+      else if (data.hasData())
         out << " with data (" << data->size() << " samples)";
       else
         out << " without data";
     } // RawDigitInfo_t::Dump()
 
+    //--------------------------------------------------------------------------
+    //--- ADCPyramidClass
+    //---
+    void ADCPyramidClass::Build(ADCsample_t const* samples,
+                                size_t nSamples,
+                                float pedestal,
+                                unsigned int base,
+                                ADCCorrectorClass const& corrector)
+    {
+      baseLevel = base;
+      levels.clear();
+
+      size_t const blockTicks = size_t(1) << baseLevel;
+      size_t const nCells = nSamples >> baseLevel;
+      if (nCells == 0) return;
+
+      std::vector<Cell_t> cells(nCells);
+      ADCsample_t const* sample = samples;
+      for (Cell_t& cell : cells) {
+        for (size_t iTick = 0; iTick < blockTicks; ++iTick) {
+          float const adc = *(sample++) - pedestal;
+          cell.charge += adc;
+          if (std::abs(cell.adc) <= std::abs(adc)) cell.adc = adc;
+          cell.convertedCharge += corrector(adc); // not linear: one sample at a time
+        } // for ticks
+      }   // for cells
+      levels.push_back(std::move(cells));
+
+      while (levels.back().size() > 1) {
+        std::vector<Cell_t> const& finer = levels.back();
+        std::vector<Cell_t> coarser(finer.size() / 2);
+        for (size_t iCell = 0; iCell < coarser.size(); ++iCell)
+          coarser[iCell] = Merge(finer[2 * iCell], finer[2 * iCell + 1]);
+        levels.push_back(std::move(coarser));
+      } // while
+    }   // ADCPyramidClass::Build()
+
+    size_t ADCPyramidClass::MemoryBytes() const
+    {
+      size_t bytes = 0;
+      for (std::vector<Cell_t> const& cells : levels)
+        bytes += cells.size() * sizeof(Cell_t);
+      return bytes;
+    } // ADCPyramidClass::MemoryBytes()
+
+    unsigned int ADCPyramidClass::LevelFor(unsigned int ticks)
+    {
+      unsigned int level = 0;
+      while ((1U << level) < ticks)
+        ++level;
+      return level;
+    } // ADCPyramidClass::LevelFor()
+
+    ADCPyramidClass::Cell_t ADCPyramidClass::Merge(Cell_t const& a, Cell_t const& b)
+    {
+      Cell_t merged;
+      merged.adc = (std::abs(a.adc) <= std::abs(b.adc)) ? b.adc : a.adc;
+      merged.charge = a.charge + b.charge;
+      merged.convertedCharge = a.convertedCharge + b.convertedCharge;
+      return merged;
+    } // ADCPyramidClass::Merge()
+
+    //--------------------------------------------------------------------------
+    //--- PlaneADCMatrixClass
+    //---
+    void PlaneADCMatrixClass::Fill(std::vector<RawDigitInfo_t> const& digits,
+                                   std::vector<size_t> const& onPlane)
+    {
+      row_sizes.clear();
+      row_sizes.reserve(onPlane.size());
+      size_t maxSamples = 0;
+      for (size_t const iDigit : onPlane) {
+        row_sizes.push_back(digits[iDigit].Samples().size());
+        maxSamples = std::max(maxSamples, row_sizes.back());
+      }
+
+      // each row is padded to a whole number of aligned blocks
+      size_t const blockSamples = Alignment / sizeof(ADCsample_t);
+      stride = (maxSamples + blockSamples - 1) / blockSamples * blockSamples;
+      size_t const nSamples = stride * onPlane.size();
+      samples.reset(static_cast<ADCsample_t*>(
+        ::operator new[](nSamples * sizeof(ADCsample_t), std::align_val_t(Alignment))));
+
+      for (size_t iRow = 0; iRow < onPlane.size(); ++iRow) {
+        RawDigitInfo_t const& digit = digits[onPlane[iRow]];
+        ADCspan_t const adcs = digit.Samples();
+        ADCsample_t* const row = samples.get() + iRow * stride;
+        std::fill(std::copy(adcs.begin(), adcs.end(), row), row + stride, ADCsample_t(0));
+        digit.UseRow(row, adcs.size());
+      } // for rows
+
+      pedestals.clear();
+      pedestal_option = -1;
+    } // PlaneADCMatrixClass::Fill()
+
+    void PlaneADCMatrixClass::SetPedestals(std::vector<float> const& rowPedestals,
+                                           int pedestalOption)
+    {
+      pedestals = rowPedestals;
+      pedestal_option = pedestalOption;
+    } // PlaneADCMatrixClass::SetPedestals()
+
+    //--------------------------------------------------------------------------
+    //--- ChannelInfoTableClass
+    //---
+
+    ChannelInfoTableClass::WireIDRange_t ChannelInfoTableClass::WireIDs(
+      raw::ChannelID_t channel) const
+    {
+      if (!hasChannel(channel)) return {nullptr, nullptr};
+      geo::WireID const* first = wireIDs.data();
+      return {first + firstWireID[channel], first + firstWireID[channel + 1]};
+    } // ChannelInfoTableClass::WireIDs()
+
+    bool ChannelInfoTableClass::isOnPlane(raw::ChannelID_t channel,
+                                          geo::PlaneID const& pid) const
+    {
+      for (geo::WireID const& wireID : WireIDs(channel))
+        if (wireID.planeID() == pid) return true;
+      return false;
+    } // ChannelInfoTableClass::isOnPlane()
+
+    ChannelInfoTableClass::ChannelConditions_t const& ChannelInfoTableClass::Conditions(
+      raw::ChannelID_t channel) const
+    {
+      static ChannelConditions_t const NoChannel; // not present
+      return hasChannel(channel) ? conditions[channel] : NoChannel;
+    } // ChannelInfoTableClass::Conditions()
+
+    float ChannelInfoTableClass::PedestalMean(raw::ChannelID_t channel) const
+    {
+      ChannelConditions_t const& info = Conditions(channel);
+      if (info.hasPedestal) return info.pedestal;
+
+      lariov::DetPedestalProvider const& pedestalRetrievalAlg =
+        art::ServiceHandle<lariov::DetPedestalService const>()->GetPedestalProvider();
+      float const pedestal = pedestalRetrievalAlg.PedMean(channel);
+      if (hasChannel(channel)) {
+        info.pedestal = pedestal;
+        info.hasPedestal = true;
+      }
+      return pedestal;
+    } // ChannelInfoTableClass::PedestalMean()
+
+    void ChannelInfoTableClass::UpdateConditions(art::Event const& evt)
+    {
+      art::RunID const run = evt.id().runID();
+      if (run == conditionsRun) return;
+
+      MF_LOG_DEBUG("RawDataDrawer") << "Reading channel conditions for " << run;
+
+      lariov::ChannelStatusProvider const& channelStatus =
+        art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
+
+      raw::ChannelID_t const nChannels = conditions.size();
+      for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+        ChannelConditions_t& info = conditions[channel];
+        info = ChannelConditions_t{}; // pedestals are also reset
+        info.present = channelStatus.IsPresent(channel);
+        if (!info.present) continue;
+        info.bad = channelStatus.IsBad(channel);
+        info.status = channelStatus.Status(channel);
+      } // for channels
+
+      conditionsRun = run;
+    } // ChannelInfoTableClass::UpdateConditions()
+
+    void ChannelInfoTableClass::FillGeometry()
+    {
+      auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
+
+      raw::ChannelID_t const nChannels = wireReadoutGeom.Nchannels();
+
+      wireIDs.clear();
+      firstWireID.clear();
+      firstWireID.reserve(nChannels + 1);
+      for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+        firstWireID.push_back(wireIDs.size());
+        for (geo::WireID const& wireID : wireReadoutGeom.ChannelToWire(channel))
+          wireIDs.push_back(wireID);
+      } // for channels
+      firstWireID.push_back(wireIDs.size());
+      wireIDs.shrink_to_fit();
+
+      conditions.assign(nChannels, ChannelConditions_t{});
+      conditionsRun = art::RunID(); // conditions need to be read anew
+
+      MF_LOG_DEBUG("RawDataDrawer") << "Channel table filled with " << nChannels << " channels and "
+                                    << wireIDs.size() << " wires";
+    } // ChannelInfoTableClass::FillGeometry()
+
+    ChannelInfoTableClass& ChannelInfoTableClass::Instance()
+    {
+      static ChannelInfoTableClass table;
+      if (table.firstWireID.empty()) table.FillGeometry();
+      return table;
+    } // ChannelInfoTableClass::Instance()
+
     //--------------------------------------------------------------------------
     //--- RawDigitCacheDataClass
     //---
 
     RawDigitInfo_t const* RawDigitCacheDataClass::FindChannel(raw::ChannelID_t channel) const
     {
-      auto iDigit = std::find_if(
-        digits.cbegin(), digits.cend(), [channel](evd::details::RawDigitInfo_t const& digit) {
-          return digit.Channel() == channel;
-        });
-      return (iDigit == digits.cend()) ? nullptr : &*iDigit;
+      if (channel < first_channel) return nullptr;
+      size_t const index = channel - first_channel;
+      if (index >= channel_digits.size() || channel_digits[index] == NoDigit) return nullptr;
+      return &digits[channel_digits[index]];
     } // RawDigitCacheDataClass::FindChannel()
 
+    std::vector<size_t> const& RawDigitCacheDataClass::DigitsOnPlane(geo::PlaneID const& pid) const
+    {
+      auto iPlane = plane_digits.find(pid);
+      if (iPlane != plane_digits.end()) return iPlane->second;
+
+      ChannelInfoTableClass const& channelTable = ChannelInfoTableClass::Instance();
+      std::vector<size_t>& onPlane = plane_digits[pid];
+      for (size_t iDigit = 0; iDigit < digits.size(); ++iDigit) {
+        if (channelTable.isOnPlane(digits[iDigit].Channel(), pid)) onPlane.push_back(iDigit);
+      } // for digits
+      return onPlane;
+    } // RawDigitCacheDataClass::DigitsOnPlane()
+
+    std::vector<float> const& RawDigitCacheDataClass::PlanePedestals(geo::PlaneID const& pid,
+                                                                     int pedestalOption) const
+    {
+      std::vector<size_t> const& onPlane = DigitsOnPlane(pid);
+      PlanePedestals_t& planePedestals = plane_pedestals[pid];
+      if ((planePedestals.pedestalOption != pedestalOption) ||
+          (planePedestals.pedestals.size() != onPlane.size())) {
+        planePedestals.pedestalOption = pedestalOption;
+        planePedestals.pedestals.clear();
+        planePedestals.pedestals.reserve(onPlane.size());
+        for (size_t const iDigit : onPlane)
+          planePedestals.pedestals.push_back(DigitPedestal(digits[iDigit].Digit(), pedestalOption));
+      }
+      return planePedestals.pedestals;
+    } // RawDigitCacheDataClass::PlanePedestals()
+
+    std::vector<ADCPyramidClass> const* RawDigitCacheDataClass::PlanePyramids(
+      geo::PlaneID const& pid) const
+    {
+      auto const iPlane = plane_pyramids.find(pid);
+      if (iPlane == plane_pyramids.end()) return nullptr;
+      std::vector<ADCPyramidClass> const& pyramids = iPlane->second.pyramids;
+      return (pyramids.size() == DigitsOnPlane(pid).size()) ? &pyramids : nullptr;
+    } // RawDigitCacheDataClass::PlanePyramids()
+
+    void RawDigitCacheDataClass::UncompressPlane(geo::PlaneID const& pid,
+                                                 RoISettings_t const& roi,
+                                                 unsigned int pyramidBaseTicks,
+                                                 ADCCorrectorClass const* chargeCorrector) const
+    {
+      std::vector<size_t> const& onPlane = DigitsOnPlane(pid);
+      PlaneRoIs_t& planeRoIs = plane_rois[pid];
+      bool const findRoIs =
+        (planeRoIs.settings != roi) || (planeRoIs.digits.size() != onPlane.size());
+
+      bool buildPyramids = false;
+      PlanePyramids_t* planePyramids = nullptr;
+      if ((pyramidBaseTicks > 0) && chargeCorrector) {
+        planePyramids = &(plane_pyramids[pid]);
+        buildPyramids = (planePyramids->baseTicks != pyramidBaseTicks) ||
+                        (planePyramids->pedestalOption != roi.pedestalOption) ||
+                        (planePyramids->pyramids.size() != onPlane.size());
+      }
+
+      // indices in onPlane of the digits to be visited
+      std::vector<size_t> toProcess;
+      for (size_t iOnPlane = 0; iOnPlane < onPlane.size(); ++iOnPlane) {
+        if (findRoIs || buildPyramids || !digits[onPlane[iOnPlane]].hasData())
+          toProcess.push_back(iOnPlane);
+      }
+      if (toProcess.empty()) return;
+
+      // the pedestals must be read before the parallel section (see PlanePedestals())
+      std::vector<float> const* pedestals = nullptr;
+      if (findRoIs || buildPyramids) pedestals = &PlanePedestals(pid, roi.pedestalOption);
+      if (findRoIs) {
+        planeRoIs.settings = roi;
+        planeRoIs.digits.assign(onPlane.size(), DigitRoI_t{});
+        planeRoIs.hasRegion = false;
+      }
+      unsigned int const pyramidBaseLevel =
+        buildPyramids ? ADCPyramidClass::LevelFor(pyramidBaseTicks) : 0;
+      if (buildPyramids) {
+        planePyramids->baseTicks = pyramidBaseTicks;
+        planePyramids->pedestalOption = roi.pedestalOption;
+        planePyramids->pyramids.assign(onPlane.size(), ADCPyramidClass{});
+      }
+
+      MF_LOG_DEBUG("RawDataDrawer") << "Uncompressing " << toProcess.size() << "/"
+                                    << onPlane.size() << " raw digits on " << pid
+                                    << (findRoIs ? ", finding their region of interest" : "")
+                                    << (buildPyramids ? ", building their ADC pyramids" : "");
+
+      // each digit owns its data, the shared waveform cache is thread safe,
+      // and nothing else shared is modified;
+      // the samples are searched for the region of interest and summarised in
+      // the pyramid right after they are uncompressed, rather than in separate
+      // passes
+      tbb::parallel_for_each(toProcess.begin(), toProcess.end(), [&](size_t iOnPlane) {
+        ADCspan_t const adcs = DigitData(onPlane[iOnPlane]);
+        if (findRoIs) {
+          planeRoIs.digits[iOnPlane] =
+            FindRoI(adcs.data(), adcs.size(), (*pedestals)[iOnPlane], roi);
+        }
+        if (buildPyramids) {
+          planePyramids->pyramids[iOnPlane].Build(
+            adcs.data(), adcs.size(), (*pedestals)[iOnPlane], pyramidBaseLevel, *chargeCorrector);
+        }
+      });
+    } // RawDigitCacheDataClass::UncompressPlane()
+
+    std::vector<DigitRoI_t> const* RawDigitCacheDataClass::PlaneRoIs(
+      geo::PlaneID const& pid,
+      RoISettings_t const& roi) const
+    {
+      auto const iPlane = plane_rois.find(pid);
+      if (iPlane == plane_rois.end()) return nullptr;
+      PlaneRoIs_t const& planeRoIs = iPlane->second;
+      if ((planeRoIs.settings != roi) || (planeRoIs.digits.size() != DigitsOnPlane(pid).size()))
+        return nullptr;
+      return &(planeRoIs.digits);
+    } // RawDigitCacheDataClass::PlaneRoIs()
+
+    PlaneRegion_t const* RawDigitCacheDataClass::PlaneRegion(geo::PlaneID const& pid,
+                                                             RoISettings_t const& roi) const
+    {
+      auto const iPlane = plane_rois.find(pid);
+      if (iPlane == plane_rois.end()) return nullptr;
+      PlaneRoIs_t const& planeRoIs = iPlane->second;
+      if (!planeRoIs.hasRegion || (planeRoIs.settings != roi)) return nullptr;
+      return &(planeRoIs.region);
+    } // RawDigitCacheDataClass::PlaneRegion()
+
+    void RawDigitCacheDataClass::SetPlaneRegion(geo::PlaneID const& pid,
+                                                RoISettings_t const& roi,
+                                                PlaneRegion_t const& region) const
+    {
+      // no new entry is created, so that different planes can be set concurrently
+      auto const iPlane = plane_rois.find(pid);
+      if (iPlane == plane_rois.end()) return;
+      PlaneRoIs_t& planeRoIs = iPlane->second;
+      if (planeRoIs.settings != roi) return;
+      planeRoIs.region = region;
+      planeRoIs.hasRegion = true;
+    } // RawDigitCacheDataClass::SetPlaneRegion()
+
+    PlaneADCMatrixClass const& RawDigitCacheDataClass::PlaneMatrix(geo::PlaneID const& pid,
+                                                                   RoISettings_t const& roi) const
+    {
+      std::vector<size_t> const& onPlane = DigitsOnPlane(pid);
+      UncompressPlane(pid, roi);
+      auto iMatrix = plane_matrices.find(pid);
+      if (iMatrix == plane_matrices.end()) {
+        iMatrix = plane_matrices.emplace(pid, PlaneADCMatrixClass()).first;
+        iMatrix->second.Fill(digits, onPlane);
+
+        // the matrix is now the only copy: the background worker must not keep one
+        if (prefetchSlots) {
+          for (size_t const iDigit : onPlane)
+            ClaimPrefetched(iDigit);
+        }
+        MF_LOG_DEBUG("RawDataDrawer")
+          << "ADC matrix of " << onPlane.size() << " raw digits on " << pid << ": "
+          << iMatrix->second.MemoryBytes() << " bytes (" << MatrixMemoryBytes()
+          << " bytes for " << plane_matrices.size() << " planes of " << timestamp << "; "
+          << MemoryBytes() << " bytes in the whole cache)";
+      }
+
+      PlaneADCMatrixClass& matrix = iMatrix->second;
+      if (!matrix.hasPedestals(roi.pedestalOption))
+        matrix.SetPedestals(PlanePedestals(pid, roi.pedestalOption), roi.pedestalOption);
+      return matrix;
+    } // RawDigitCacheDataClass::PlaneMatrix()
+
+    size_t RawDigitCacheDataClass::MatrixMemoryBytes() const
+    {
+      size_t bytes = 0;
+      for (auto const& [pid, matrix] : plane_matrices)
+        bytes += matrix.MemoryBytes();
+      return bytes;
+    } // RawDigitCacheDataClass::MatrixMemoryBytes()
+
+    size_t RawDigitCacheDataClass::MemoryBytes() const
+    {
+      size_t bytes = MatrixMemoryBytes();
+      for (RawDigitInfo_t const& digitInfo : digits)
+        bytes += digitInfo.MemoryBytes();
+      for (auto const& [pid, planePyramids] : plane_pyramids) {
+        for (ADCPyramidClass const& pyramid : planePyramids.pyramids)
+          bytes += pyramid.MemoryBytes();
+      }
+      return bytes;
+    } // RawDigitCacheDataClass::MemoryBytes()
+
     std::vector<raw::RawDigit> const* RawDigitCacheDataClass::ReadProduct(art::Event const& evt,
                                                                           art::InputTag label)
     {
@@ -1573,17 +2846,125 @@ namespace evd {
       return &*rdcol;
     } // RawDigitCacheDataClass::ReadProduct()
 
-    void RawDigitCacheDataClass::Refill(art::Handle<std::vector<raw::RawDigit>>& rdcol)
+    void RawDigitCacheDataClass::Refill(art::Handle<std::vector<raw::RawDigit>>& rdcol,
+                                        WaveformCache::SourceID_t new_source)
     {
+      source = new_source;
       digits.resize(rdcol->size());
+      raw::ChannelID_t minChannel = std::numeric_limits<raw::ChannelID_t>::max();
+      raw::ChannelID_t maxChannel = 0;
       for (size_t iDigit = 0; iDigit < rdcol->size(); ++iDigit) {
         art::Ptr<raw::RawDigit> pDigit(rdcol, iDigit);
-        digits[iDigit].Fill(pDigit);
+        digits[iDigit].Fill(pDigit, source);
         size_t samples = pDigit->Samples();
         if (samples > max_samples) max_samples = samples;
+        raw::ChannelID_t const channel = pDigit->Channel();
+        if (!raw::isValidChannelID(channel)) continue;
+        minChannel = std::min(minChannel, channel);
+        maxChannel = std::max(maxChannel, channel);
+      } // for
+
+      // the index covers the channels of this product only (e.g. of one APA);
+      // the first digit of each channel is indexed, as the linear search did
+      channel_digits.clear();
+      if (minChannel > maxChannel) return; // no valid channel
+      first_channel = minChannel;
+      channel_digits.resize(maxChannel - minChannel + 1, NoDigit);
+      for (size_t iDigit = digits.size(); iDigit-- > 0;) {
+        raw::ChannelID_t const channel = digits[iDigit].Channel();
+        if (raw::isValidChannelID(channel)) channel_digits[channel - first_channel] = iDigit;
       } // for
     }   // RawDigitCacheDataClass::Refill()
 
+    void RawDigitCacheDataClass::StartPrefetch()
+    {
+      StopPrefetch();
+      prefetchSlots.reset();
+
+      // collect the compressed digits still to be uncompressed; the worker may
+      // outlive the event, so it gets its own copy of the compressed data
+      WaveformCache& waveforms = WaveformCache::Instance();
+      std::vector<CompressedDigit_t> compressed;
+      for (size_t iDigit = 0; iDigit < digits.size(); ++iDigit) {
+        RawDigitInfo_t const& digitInfo = digits[iDigit];
+        if (digitInfo.hasData()) continue;
+        raw::RawDigit const& digit = digitInfo.Digit();
+        if (digit.Compression() == kNone) continue; // no uncompression needed
+        // already uncompressed (e.g. last time we were on this event)
+        if (auto samples = waveforms.FindRawDigitSamples(source, digit.Channel())) {
+          digitInfo.AdoptData(std::move(samples));
+          continue;
+        }
+        compressed.push_back({iDigit,
+                              digit.Channel(),
+                              digit.Compression(),
+                              digit.Samples(),
+                              (int)digit.GetPedestal(),
+                              digit.ADCs()});
+      } // for
+      if (compressed.empty()) return;
+
+      MF_LOG_DEBUG("RawDataDrawer") << "Uncompressing " << compressed.size()
+                                    << " raw digits in background for " << timestamp;
+
+      bool const withPedestal =
+        art::ServiceHandle<evd::RawDrawingOptions const>()->fUncompressWithPed;
+      prefetchSlots.reset(new PrefetchSlot_t[digits.size()]);
+      stopPrefetch = false;
+      prefetched = std::async(
+        std::launch::async,
+        [this, &waveforms, withPedestal, source = source, compressed = std::move(compressed)]() {
+          for (CompressedDigit_t const& digit : compressed) {
+            if (stopPrefetch) break;
+            PrefetchSlot_t& slot = prefetchSlots[digit.iDigit];
+            unsigned char state = psFree;
+            if (!slot.state.compare_exchange_strong(state, psWorker)) continue; // taken
+            auto samples = std::make_shared<raw::RawDigit::ADCvector_t const>(
+              UncompressADCs(digit.adcs,
+                             digit.nSamples,
+                             digit.compression,
+                             withPedestal,
+                             digit.pedestal));
+            waveforms.StoreRawDigitSamples(source, digit.channel, samples);
+            slot.samples = std::move(samples);
+            slot.state = psDone;
+            slot.state.notify_all();
+          } // for
+        });
+    } // RawDigitCacheDataClass::StartPrefetch()
+
+    void RawDigitCacheDataClass::StopPrefetch()
+    {
+      if (!prefetched.valid()) return;
+      stopPrefetch = true;
+      prefetched.get();
+    } // RawDigitCacheDataClass::StopPrefetch()
+
+    ADCspan_t RawDigitCacheDataClass::DigitData(size_t iDigit) const
+    {
+      RawDigitInfo_t const& digitInfo = digits[iDigit];
+      if (digitInfo.hasData() || !prefetchSlots) return digitInfo.Samples();
+
+      if (auto samples = ClaimPrefetched(iDigit)) digitInfo.AdoptData(std::move(samples));
+      return digitInfo.Samples();
+    } // RawDigitCacheDataClass::DigitData()
+
+    WaveformCache::RawSamplesPtr_t RawDigitCacheDataClass::ClaimPrefetched(size_t iDigit) const
+    {
+      // if the worker has not taken the digit yet, it will skip it;
+      // otherwise we wait for it to be done, and take its result
+      PrefetchSlot_t& slot = prefetchSlots[iDigit];
+      unsigned char state = psFree;
+      if (slot.state.compare_exchange_strong(state, psClaimed)) return nullptr;
+      while (state == psWorker) {
+        slot.state.wait(psWorker);
+        state = slot.state;
+      }
+      if ((state != psDone) || !slot.state.compare_exchange_strong(state, psClaimed))
+        return nullptr;
+      return std::move(slot.samples);
+    } // RawDigitCacheDataClass::ClaimPrefetched()
+
     void RawDigitCacheDataClass::Invalidate()
     {
       timestamp.clear();
@@ -1591,8 +2972,17 @@ namespace evd {
 
     void RawDigitCacheDataClass::Clear()
     {
+      StopPrefetch();
+      prefetchSlots.reset();
       Invalidate();
       digits.clear();
+      channel_digits.clear();
+      first_channel = 0;
+      plane_digits.clear();
+      plane_pedestals.clear();
+      plane_pyramids.clear();
+      plane_matrices.clear();
+      plane_rois.clear();
       max_samples = 0;
     } // RawDigitCacheDataClass::Clear()
 
@@ -1655,9 +3045,18 @@ namespace evd {
         return true;
       }
 
-      Refill(rdcol);
+      art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+      WaveformCache::Kind_t const kind = rawopt->fUncompressWithPed ?
+                                           WaveformCache::Kind_t::RawDigitWithPedestal :
+                                           WaveformCache::Kind_t::RawDigit;
+      WaveformCache& waveforms = WaveformCache::Instance();
+      waveforms.Configure(); // on the main thread, before any worker uses the cache
+      Refill(rdcol, waveforms.Source(evt.id(), rdcol.id(), kind));
 
       timestamp = new_timestamp;
+
+      if (rawopt->fPrefetchRawDigits) StartPrefetch();
+
       return true;
     } // RawDigitCacheDataClass::Update()
 
@@ -1666,7 +3065,10 @@ namespace evd {
     {
       out << "Cache at " << ((void*)this) << " with time stamp " << std::string(timestamp)
           << " and " << digits.size() << " entries (maximum sample: " << max_samples << ");"
-          << " data at " << ((void*)digits.data());
+          << " data at " << ((void*)digits.data()) << " (" << MemoryBytes() << " bytes)";
+      if (!plane_matrices.empty())
+        out << "; " << plane_matrices.size() << " plane ADC matrices (" << MatrixMemoryBytes()
+            << " bytes)";
       for (RawDigitInfo_t const& digitInfo : digits) {
         out << "\n  ";
         digitInfo.Dump(out);
@@ -1675,118 +3077,31 @@ namespace evd {
     } // RawDigitCacheDataClass::Dump()
 
     //--------------------------------------------------------------------------
-    //--- GridAxisClass
-    //---
-    std::ptrdiff_t GridAxisClass::GetCell(float coord) const
-    {
-      return std::ptrdiff_t((coord - min) / cell_size); // truncate
-    }                                                   // GridAxisClass::GetCell()
-
-    //--------------------------------------------------------------------------
-    bool GridAxisClass::Init(size_t nDiv, float new_min, float new_max)
-    {
-
-      n_cells = std::max(nDiv, size_t(1));
-      return SetLimits(new_min, new_max);
-
-    } // GridAxisClass::Init()
-
-    //--------------------------------------------------------------------------
-    bool GridAxisClass::SetLimits(float new_min, float new_max)
-    {
-      min = new_min;
-      max = new_max;
-      cell_size = Length() / float(n_cells);
-
-      return std::isnormal(cell_size);
-    } // GridAxisClass::SetLimits()
-
-    //--------------------------------------------------------------------------
-    bool GridAxisClass::SetMinCellSize(float min_size)
-    {
-      if (cell_size >= min_size) return false;
-
-      // n_cells gets truncated
-      n_cells = (size_t)std::max(std::floor(Length() / min_size), 1.0F);
-
-      // reevaluate cell size, that might be different than min_size
-      // because of n_cells truncation or minimum value
-      cell_size = Length() / float(n_cells);
-      return true;
-    } // GridAxisClass::SetMinCellSize()
-
-    //--------------------------------------------------------------------------
-    bool GridAxisClass::SetMaxCellSize(float max_size)
-    {
-      if (cell_size <= max_size) return false;
-
-      // n_cells gets rounded up
-      n_cells = (size_t)std::max(std::ceil(Length() / max_size), 1.0F);
-
-      // reevaluate cell size, that might be different than max_size
-      // because of n_cells rounding or minimum value
-      cell_size = Length() / float(n_cells);
-      return true;
-    } // GridAxisClass::SetMaxCellSize()
-
-    //--------------------------------------------------------------------------
-    template <typename Stream>
-    void GridAxisClass::Dump(Stream&& out) const
-    {
-      out << NCells() << " cells from " << Min() << " to " << Max() << " (length: " << Length()
-          << ")";
-    } // GridAxisClass::Dump()
-
-    //--------------------------------------------------------------------------
-    //--- CellGridClass
+    //--- RawDigitCacheSetClass
     //---
-    CellGridClass::CellGridClass(unsigned int nWires, unsigned int nTDC)
-      : wire_axis((size_t)nWires, 0., float(nWires)), tdc_axis((size_t)nTDC, 0., float(nTDC))
-    {} // CellGridClass::CellGridClass(int, int)
-
-    //--------------------------------------------------------------------------
-    CellGridClass::CellGridClass(float min_wire,
-                                 float max_wire,
-                                 unsigned int nWires,
-                                 float min_tdc,
-                                 float max_tdc,
-                                 unsigned int nTDC)
-      : wire_axis((size_t)nWires, min_wire, max_wire), tdc_axis((size_t)nTDC, min_tdc, max_tdc)
-    {} // CellGridClass::CellGridClass({ float, float, int } x 2)
-
-    //--------------------------------------------------------------------------
-    std::ptrdiff_t CellGridClass::GetCell(float wire, float tick) const
-    {
-      std::ptrdiff_t iWireCell = wire_axis.GetCell(wire);
-      if (!wire_axis.hasCell(iWireCell)) return std::ptrdiff_t(-1);
-      std::ptrdiff_t iTDCCell = tdc_axis.GetCell(tick);
-      if (!tdc_axis.hasCell(iTDCCell)) return std::ptrdiff_t(-1);
-      return iWireCell * TDCAxis().NCells() + iTDCCell;
-    } // CellGridClass::GetCell()
 
-    //--------------------------------------------------------------------------
-    std::tuple<float, float, float, float> CellGridClass::GetCellBox(std::ptrdiff_t iCell) const
+    RawDigitCacheDataClass& RawDigitCacheSetClass::Update(art::Event const& evt,
+                                                          CacheID_t const& new_timestamp)
     {
-      // { w1, t1, w2, t2 }
-      size_t const nTDCCells = TDCAxis().NCells();
-      std::ptrdiff_t iWireCell = (std::ptrdiff_t)(iCell / nTDCCells),
-                     iTDCCell = (std::ptrdiff_t)(iCell % nTDCCells);
+      // the digits of a different event are not going to be used any more
+      for (ProductCache_t& cache : caches) {
+        if (!cache.data->empty() && !cache.data->Timestamp().sameEvent(new_timestamp))
+          cache.data->Clear();
+      }
 
-      return std::tuple<float, float, float, float>(WireAxis().LowerEdge(iWireCell),
-                                                    TDCAxis().LowerEdge(iTDCCell),
-                                                    WireAxis().UpperEdge(iWireCell),
-                                                    TDCAxis().UpperEdge(iTDCCell));
-    } // CellGridClass::GetCellBox()
+      art::InputTag const& label = new_timestamp.inputLabel();
+      auto iCache = std::find_if(caches.begin(), caches.end(), [&label](ProductCache_t const& c) {
+        return c.label == label;
+      });
+      if (iCache == caches.end()) {
+        MF_LOG_DEBUG("RawDataDrawer") << "Adding a raw digit cache for '" << label.encode() << "'";
+        caches.push_back({label, std::make_unique<RawDigitCacheDataClass>()});
+        iCache = std::prev(caches.end());
+      }
 
-    //--------------------------------------------------------------------------
-    template <typename Stream>
-    void CellGridClass::Dump(Stream&& out) const
-    {
-      out << "Wire axis: ";
-      WireAxis().Dump(out);
-      out << "; time axis: ";
-      TDCAxis().Dump(out);
-    } // CellGridClass::Dump()
+      iCache->data->Update(evt, new_timestamp);
+      return *(iCache->data);
+    } // RawDigitCacheSetClass::Update()
 
     //--------------------------------------------------------------------------
 
@@ -33,7 +33,9 @@ namespace evd {
 
   namespace details {
     class RawDigitCacheDataClass;
+    class RawDigitCacheSetClass;
     class CellGridClass;
+    struct RoISettings_t;
     typedef ::util::PlaneDataChangeTracker_t CacheID_t;
   } // namespace details
 
@@ -70,6 +72,43 @@ namespace evd {
                     unsigned int plane,
                     bool bZoomToRoI = false);
 
+    /**
+     * @brief Reads the raw digits needed to draw the specified plane
+     * @param evt source for raw digits
+     * @param detProp detector properties, for the charge correction
+     * @param plane number of the plane to be drawn
+     * @return whether there is anything to be drawn on the plane
+     * @see PrepareRawDigit2D()
+     *
+     * This is the first half of the preparation of the drawing, which needs
+     * access to the event and to shared resources; it must be called on the
+     * main thread, after `ExtractRange()`.
+     * It reads and uncompresses the digits of the plane, and it resolves all
+     * the services and channel conditions the drawing needs.
+     */
+    bool StartRawDigit2D(art::Event const& evt,
+                         detinfo::DetectorPropertiesData const& detProp,
+                         unsigned int plane);
+
+    /**
+     * @brief Prepares the drawing of the plane, without creating ROOT objects
+     * @param evt source for raw digits
+     * @param plane number of the plane to be drawn
+     * @param bZoomToRoI whether to render only te region of interest
+     * @see StartRawDigit2D(), RawDigit2D()
+     *
+     * This call must follow a successful `StartRawDigit2D()`.
+     * It performs all the processing of `RawDigit2D()` but the creation of the
+     * graphic objects, and it keeps the result until the next call of
+     * `RawDigit2D()` on the same plane, which will only send it to the view.
+     * Different drawers can run this preparation concurrently, since it only
+     * uses the data collected by `StartRawDigit2D()` and no service.
+     */
+    void PrepareRawDigit2D(art::Event const& evt,
+                           detinfo::DetectorPropertiesData const& detProp,
+                           unsigned int plane,
+                           bool bZoomToRoI = false);
+
     void FillQHisto(const art::Event& evt, unsigned int plane, TH1F* histo);
 
     void FillTQHisto(const art::Event& evt, unsigned int plane, unsigned int wire, TH1F* histo);
@@ -96,13 +135,13 @@ namespace evd {
 
   private:
     struct BoxInfo_t {
-      int adc = 0;       ///< total ADC count in this box
+      float adc = 0.F;   ///< ADC count with the largest magnitude in this box
       bool good = false; ///< whether the channel is not bad
     };
 
     struct PadResolution_t {
-      unsigned int width = 0;  // width of pad in pixels
-      unsigned int height = 0; // heigt of pad in pixels
+      unsigned int width = 0;  // pixels of the pad along the wire direction
+      unsigned int height = 0; // pixels of the pad along the tick direction
 
       /// Returns whether the stored value is valid
       bool isFilled() const { return (width != 0) && (height != 0); }
@@ -112,6 +151,12 @@ namespace evd {
 
     }; ///< Stores the information about the drawing area
 
+    /// Drawing material from PrepareRawDigit2D()
+    struct PreparedDrawing_t;
+
+    /// Information from services and conditions, from StartRawDigit2D()
+    struct PlaneSetup_t;
+
     /// Helper class to be used with ChannelLooper()
     class OperationBaseClass;
     class ManyOperations;
@@ -128,10 +173,13 @@ namespace evd {
     friend class BoxDrawer;
     friend class RoIextractorClass;
 
-    /// Cache of raw digits
+    /// Cache of raw digits of the current product (owned by `digit_caches`)
     // Never use raw pointers. Unless you are dealing with CINT, that is.
     evd::details::RawDigitCacheDataClass* digit_cache;
 
+    /// Caches of raw digits of all the products
+    evd::details::RawDigitCacheSetClass* digit_caches;
+
 #ifndef __CINT__
     /// Prepares for a new event (if somebody tells it to)
     void Reset(art::Event const& event);
@@ -141,6 +189,12 @@ namespace evd {
 
     /// Returns whether a channel with the specified status should be processed
     bool ProcessChannelWithStatus(lariov::ChannelStatusProvider::Status_t channel_status) const;
+
+    /// Returns the settings of the search of the region of interest on the plane
+    details::RoISettings_t RoISettings(geo::PlaneID const& pid) const;
+
+    /// Recovers the regions of interest of the TPC already found in this event
+    void RestoreRegionOfInterest(geo::TPCID const& tpcid);
 #endif // __CINT__
 
     double fStartTick; ///< low tick
@@ -161,6 +215,10 @@ namespace evd {
     // TODO with ROOT 6, turn this into a std::unique_ptr()
     details::CellGridClass* fDrawingRange; ///< information about the viewport
 
+    PreparedDrawing_t* fPrepared; ///< drawing material waiting for RawDigit2D()
+
+    PlaneSetup_t* fSetup; ///< information for the operations on the current plane
+
     /// Performs the 2D wire plane drawing
     void DrawRawDigit2D(art::Event const& evt, evdb::View2D* view, unsigned int plane);
 
@@ -169,8 +227,9 @@ namespace evd {
      * @param evt event to read the digits from
      * @param ts a cache ID assessing the new state the cache should move to
      *
-     * The function will ask the data cache for an update
-     * (RawDigitCacheDataClass::Update()).
+     * The function will ask the data cache of the product in the state for an
+     * update (RawDigitCacheDataClass::Update()), and make it the current one
+     * (`digit_cache`).
      * The cache will evaluate whether it is already in a state compatible with
      * ts or if cache needs to be invalidated, in which case it will fill with
      * new data.
@@ -179,8 +238,14 @@ namespace evd {
      */
     void GetRawDigits(art::Event const& evt, details::CacheID_t const& new_timestamp);
 
+    /// Runs the drawing operations on `pid`; with no `view`, stores the result
+    void FillRawDigit2D(detinfo::DetectorPropertiesData const& detProp,
+                        evdb::View2D* view,
+                        geo::PlaneID const& pid,
+                        bool bZoomToRoI);
+
     // Helper functions for drawing
-    bool RunOperation(art::Event const& evt, OperationBaseClass* operation);
+    bool RunOperation(OperationBaseClass* operation);
     void QueueDrawingBoxes(evdb::View2D* view,
                            geo::PlaneID const& pid,
                            std::vector<BoxInfo_t> const& BoxInfo);
@@ -188,7 +253,9 @@ namespace evd {
                           detinfo::DetectorPropertiesData const& detProp,
                           evdb::View2D* view,
                           unsigned int plane);
-    void RunRoIextractor(art::Event const& evt, unsigned int plane);
+    void RunRoIextractor(art::Event const& evt,
+                         detinfo::DetectorPropertiesData const& detProp,
+                         unsigned int plane);
     void SetDrawingLimitsFromRoI(geo::PlaneID::PlaneID_t plane);
     void SetDrawingLimitsFromRoI(geo::PlaneID const pid) { SetDrawingLimitsFromRoI(pid.Plane); }
 
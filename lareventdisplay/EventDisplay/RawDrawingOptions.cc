@@ -7,6 +7,9 @@
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 
+#include <functional> // std::hash
+#include <string>
+
 namespace evd {
 
   //......................................................................
@@ -18,6 +21,7 @@ namespace evd {
   //......................................................................
   void RawDrawingOptions::reconfigure(fhicl::ParameterSet const& pset)
   {
+    fConfigHash = std::hash<std::string>{}(pset.id().to_string());
     fDrawRawDataOrCalibWires = pset.get<int>("DrawRawDataOrCalibWires");
     fScaleDigitsByCharge = pset.get<int>("ScaleDigitsByCharge");
     fTicksPerPoint = pset.get<int>("TicksPerPoint");
@@ -34,6 +38,10 @@ namespace evd {
       pset.get<unsigned int>("MaxChannelStatus", lariov::ChannelStatusProvider::InvalidStatus - 1);
     fUncompressWithPed = pset.get<bool>("UncompressWithPed", false);
     fSeeBadChannels = pset.get<bool>("SeeBadChannels", false);
+    fPrefetchRawDigits = pset.get<bool>("PrefetchRawDigits", false);
+    fWaveformCacheSize = pset.get<unsigned int>("WaveformCacheSize", 512);
+    fADCPyramidBaseTicks = pset.get<unsigned int>("ADCPyramidBaseTicks", 0);
+    fPlaneADCMatrix = pset.get<bool>("PlaneADCMatrix", false);
     fRoIthresholds = pset.get<std::vector<float>>("RoIthresholds", std::vector<float>());
     fPedestalOption = pset.get<int>("PedestalOption", 0);
 
@@ -7,6 +7,7 @@
 #ifndef RAWDRAWINGOPTIONS_H
 #define RAWDRAWINGOPTIONS_H
 #ifndef __CINT__
+#include <cstddef> // std::size_t
 #include <string>
 #include <vector>
 
@@ -37,6 +38,16 @@ namespace evd {
    *   apply the same threshold to all planes). If no threshold is specified
    *   at all, the value of 'MinSignal' parameter is used as threshold for all
    *   planes
+   * - *PrefetchRawDigits* (boolean, default: `false`): when raw digits are
+   *   read for a new event, uncompress all of them in a separate thread, so
+   *   that drawing other planes and TPCs of the same event does not need to
+   *   wait for it (at the cost of keeping all the uncompressed data in memory)
+   * - *WaveformCacheSize* (integer, default: `512`): memory budget, in MiB, of
+   *   the cache of uncompressed raw digits and calibrated wire signals shared
+   *   by all drawers and waveform tools (`0` disables the cache)
+   * - *PlaneADCMatrix* (boolean, default: `false`): the uncompressed samples
+   *   of the raw digits of each plane are moved into a single aligned matrix,
+   *   which then backs the waveform of each digit of the drawn planes
    *
    */
   class RawDrawingOptions : public evdb::Reconfigurable {
@@ -59,8 +70,13 @@ namespace evd {
     std::vector<art::InputTag>
       fRawDataLabels; ///< module label that made the raw digits, default is daq
 
-    bool fUncompressWithPed; ///< Option to uncompress with pedestal. Turned off by default
-    bool fSeeBadChannels;    ///< Allow "bad" channels to be viewed
+    bool fUncompressWithPed;         ///< Option to uncompress with pedestal. Turned off by default
+    bool fSeeBadChannels;            ///< Allow "bad" channels to be viewed
+    bool fPrefetchRawDigits;         ///< Uncompress all raw digits in background
+    unsigned int fWaveformCacheSize; ///< Memory budget of the waveform cache [MiB]
+
+    unsigned int fADCPyramidBaseTicks; ///< Ticks in the finest max-ADC pyramid block (0: none)
+    bool fPlaneADCMatrix;              ///< Keep the samples of each plane in a single matrix
 
     std::vector<float> fRoIthresholds; ///< region of interest thresholds, per plane
 
@@ -70,6 +86,8 @@ namespace evd {
     fhicl::ParameterSet
       fRawDigitDrawerParams; ///< FHICL parameters for the RawDigit waveform display
 
+    std::size_t fConfigHash; ///< hash of the configuration last applied by `reconfigure()`
+
     /// Returns the current TPC as a TPCID
     geo::TPCID CurrentTPC() const { return geo::TPCID(fCryostat, fTPC); }
 
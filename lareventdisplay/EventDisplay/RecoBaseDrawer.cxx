@@ -2,12 +2,15 @@
 /// \brief   Class to aid in the rendering of RecoBase objects
 /// \author  brebel@fnal.gov
 
+#include <algorithm> // std::min(), std::max()
 #include <cmath>
 #include <limits>
 #include <map>
 #include <stdint.h>
+#include <tuple> // std::tie()
 
 #include "TBox.h"
+#include "TFrame.h"
 #include "TH1.h"
 #include "TLine.h"
 #include "TMarker.h"
@@ -18,6 +21,7 @@
 #include "TRotation.h"
 #include "TText.h"
 #include "TVector3.h"
+#include "TVirtualPad.h"
 
 #include "larcore/Geometry/Geometry.h"
 #include "larcore/Geometry/WireReadout.h"
@@ -30,6 +34,7 @@
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/RecoBaseProxy/Track.h"
+#include "lardataalg/Utilities/StatCollector.h" // lar::util::MinMaxCollector<>
 #include "lardataobj/AnalysisBase/CosmicTag.h"
 #include "lardataobj/RecoBase/Cluster.h"
 #include "lardataobj/RecoBase/Edge.h"
@@ -46,10 +51,15 @@
 #include "lardataobj/RecoBase/Vertex.h"
 #include "lardataobj/RecoBase/Wire.h"
 #include "lareventdisplay/EventDisplay/3DDrawers/ISpacePoints3D.h"
+#include "lareventdisplay/EventDisplay/AssociationCache.h"
+#include "lareventdisplay/EventDisplay/CellGridClass.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/HitIndex.h"
+#include "lareventdisplay/EventDisplay/PrimitiveBatch2D.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RecoBaseDrawer.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WireSignalView.h"
 #include "lareventdisplay/EventDisplay/eventdisplay.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
@@ -78,12 +88,30 @@ namespace {
   {
     return art::ServiceHandle<geo::WireReadout const>()->Get();
   }
+
+  // Adds `n` entries of value 0 to the histogram, like `n` calls to Fill(0.).
+  void FillZeros(TH1& histo, std::size_t n)
+  {
+    if (n == 0) return;
+    int const bin = histo.FindBin(0.);
+    double const entries = histo.GetEntries() + n;
+    if (!histo.IsBinUnderflow(bin) && !histo.IsBinOverflow(bin)) {
+      double stats[4];
+      histo.GetStats(stats);
+      stats[0] += n; // sum of weights
+      stats[1] += n; // sum of squares of weights
+      histo.PutStats(stats);
+    }
+    histo.AddBinContent(bin, n);
+    if (histo.GetSumw2N() > 0) (*histo.GetSumw2())[bin] += n;
+    histo.SetEntries(entries);
+  }
 } // namespace
 
 namespace evd {
 
   //......................................................................
-  RecoBaseDrawer::RecoBaseDrawer()
+  RecoBaseDrawer::RecoBaseDrawer() : fDrawingRange(std::make_unique<details::CellGridClass>())
   {
     art::ServiceHandle<geo::Geometry const> geo;
     auto const& wireReadoutGeom = getWireReadoutGeom();
@@ -138,15 +166,35 @@ namespace evd {
 
     int ticksPerPoint = rawOpt->fTicksPerPoint;
 
-    // to make det independent later:
-    double mint = 5000;
-    double maxt = 0;
-    double minw = 5000;
-    double maxw = 0;
-
     geo::PlaneID pid(rawOpt->fCryostat, rawOpt->fTPC, plane);
 
     auto const& wireReadoutGeom = getWireReadoutGeom();
+
+    // set up the grid to be visualized, following the same rules as
+    // RawDataDrawer::BoxDrawer: at most one box per pixel of the pad, and at
+    // least fTicksPerPoint ticks and one wire per cell; if the viewport is not
+    // known (ExtractRange() was not called) the whole plane is covered
+    details::CellGridClass drawingRange = *fDrawingRange;
+    if (drawingRange.WireAxis().isEmpty() || drawingRange.TDCAxis().isEmpty()) {
+      unsigned int const nWires = wireReadoutGeom.Nwires(pid);
+      drawingRange.SetWireRange(0., float(nWires), nWires);
+      drawingRange.SetTDCRange(0., float(rawOpt->fTicks), (unsigned int)rawOpt->fTicks);
+    }
+    drawingRange.SetMinTDCCellSize((float)ticksPerPoint);
+    drawingRange.SetMinWireCellSize(1.F);
+
+    struct CellInfo_t {
+      float adc = 0.;      ///< signal with the largest magnitude in the cell
+      bool filled = false; ///< whether any signal above threshold is in the cell
+    };
+    std::vector<CellInfo_t> cells(drawingRange.NCells());
+
+    float const minSignal = rawOpt->fMinSignal;
+    size_t const maxTicks = (rawOpt->fTicks > 0.) ? size_t(rawOpt->fTicks) : 0;
+
+    // the region of interest covers the whole plane, not just the viewport
+    lar::util::MinMaxCollector<float> wireRange, tickRange;
+
     for (size_t imod = 0; imod < recoOpt->fWireLabels.size(); ++imod) {
       art::InputTag const which = recoOpt->fWireLabels[imod];
 
@@ -163,77 +211,83 @@ namespace evd {
 
         std::vector<geo::WireID> wireids = wireReadoutGeom.ChannelToWire(channel);
 
-        geo::SigType_t sigType = wireReadoutGeom.SignalType(channel);
-
         for (auto const& wid : wireids) {
           if (wid.planeID() != pid) continue;
 
-          double wire = 1. * wid.Wire;
-          double tick = 0;
-          // get the unpacked ROIs
-          std::vector<float> wirSig = wires[i]->Signal();
-          if (wirSig.size() == 0) continue;
-          // get an iterator over the adc values
-          std::vector<float>::const_iterator itr = wirSig.begin();
-          while (itr != wirSig.end()) {
-            int ticksUsed = 0;
-            double tdcsum = 0.;
-            double adcsum = 0.;
-            while (ticksUsed < ticksPerPoint && itr != wirSig.end()) {
-              tdcsum += tick;
-              adcsum += (1. * (*itr));
-              ++ticksUsed;
-              tick += 1.;
-              itr++; // this advance of the iterator is sufficient for the external loop too
-            }
-            double adc = adcsum / ticksPerPoint;
-            double tdc = tdcsum / ticksPerPoint;
+          float const wire = wid.Wire;
+          bool const bInView = drawingRange.hasWire(wire);
 
-            if (TMath::Abs(adc) < rawOpt->fMinSignal) continue;
-            if (tdc > rawOpt->fTicks) continue;
+          auto addSample = [&](size_t iTick, float adc) {
+            if (std::abs(adc) < minSignal) return;
 
-            int co = 0;
-            double sf = 1.;
-            double q0 = 1000.0;
+            wireRange.add(wire);
+            tickRange.add(iTick);
 
-            co = cst->CalQ(sigType).GetColor(adc);
-            if (rawOpt->fScaleDigitsByCharge) {
-              sf = sqrt(adc / q0);
-              if (sf > 1.0) sf = 1.0;
-            }
+            if (!bInView) return;
+            std::ptrdiff_t const cell = drawingRange.GetCell(wire, iTick);
+            if (cell < 0) return;
 
-            if (wire < minw) minw = wire;
-            if (wire > maxw) maxw = wire;
-            if (tdc < mint) mint = tdc;
-            if (tdc > maxt) maxt = tdc;
-
-            if (rawOpt->fAxisOrientation < 1) {
-              TBox& b1 = view->AddBox(wire - sf * 0.5,
-                                      tdc - sf * 0.5 * ticksPerPoint,
-                                      wire + sf * 0.5,
-                                      tdc + sf * 0.5 * ticksPerPoint);
-              b1.SetFillStyle(1001);
-              b1.SetFillColor(co);
-              b1.SetBit(kCannotPick);
-            }
-            else {
-              TBox& b1 = view->AddBox(tdc - sf * 0.5 * ticksPerPoint,
-                                      wire - sf * 0.5,
-                                      tdc + sf * 0.5 * ticksPerPoint,
-                                      wire + sf * 0.5);
-              b1.SetFillStyle(1001);
-              b1.SetFillColor(co);
-              b1.SetBit(kCannotPick);
-            }
-          } // end loop over samples
+            // draw maximum signal in the cell
+            CellInfo_t& info = cells[cell];
+            info.filled = true;
+            if (std::abs(info.adc) <= std::abs(adc)) info.adc = adc;
+          }; // addSample()
+
+          // samples out of the regions of interest pass only a null threshold
+          WireSignalView const signal(*wires[i]);
+          if (minSignal > 0.)
+            signal.forEachROISample(addSample, 0, maxTicks);
+          else
+            signal.forEachSample(addSample, 0, maxTicks);
         }   //end loop over wire segments
       }     //end loop over wires
     }       // end loop over wire module labels
 
-    fWireMin[plane] = minw;
-    fWireMax[plane] = maxw;
-    fTimeMin[plane] = mint;
-    fTimeMax[plane] = maxt;
+    evdb::ColorScale const& colorSet = cst->CalQ(wireReadoutGeom.SignalType(pid));
+    bool const bScaleDigitsByCharge = rawOpt->fScaleDigitsByCharge;
+    for (size_t iCell = 0; iCell < cells.size(); ++iCell) {
+      CellInfo_t const& info = cells[iCell];
+      if (!info.filled) continue;
+
+      int const co = colorSet.GetColor(info.adc);
+
+      // scale factor, proportional to the signal (optional)
+      constexpr float q0 = 1000.;
+      float const sf = bScaleDigitsByCharge ? std::min(std::sqrt(info.adc / q0), 1.0F) : 1.;
+
+      // coordinates of the cell box
+      float min_wire, max_wire, min_tick, max_tick;
+      std::tie(min_wire, min_tick, max_wire, max_tick) = drawingRange.GetCellBox(iCell);
+      if (sf != 1.) {              // need to shrink the box
+        float const nsf = 1. - sf; // negation of scale factor
+        float const half_box_wires = (max_wire - min_wire) / 2.,
+                    half_box_ticks = (max_tick - min_tick) / 2.;
+        min_wire += nsf * half_box_wires;
+        max_wire -= nsf * half_box_wires;
+        min_tick += nsf * half_box_ticks;
+        max_tick -= nsf * half_box_ticks;
+      } // if scaling
+
+      TBox& b1 = (rawOpt->fAxisOrientation < 1) ?
+                   view->AddBox(min_wire, min_tick, max_wire, max_tick) :
+                   view->AddBox(min_tick, min_wire, max_tick, max_wire);
+      b1.SetFillStyle(1001);
+      b1.SetFillColor(co);
+      b1.SetBit(kCannotPick);
+    } // for cells
+
+    if (wireRange.has_data() && tickRange.has_data()) {
+      fWireMin[plane] = wireRange.min();
+      fWireMax[plane] = wireRange.max();
+      fTimeMin[plane] = tickRange.min();
+      fTimeMax[plane] = tickRange.max();
+    }
+    else { // no signal: the whole plane is interesting
+      fWireMin[plane] = 0;
+      fWireMax[plane] = wireReadoutGeom.Nwires(pid);
+      fTimeMin[plane] = 0;
+      fTimeMax[plane] = rawOpt->fTicks;
+    }
 
     // Add a loop to draw dead wires in 2D display
     double startTick(50.);
@@ -253,6 +307,59 @@ namespace evd {
     }
   }
 
+  //......................................................................
+  void RecoBaseDrawer::ExtractRange(TVirtualPad* pPad,
+                                    std::vector<double> const* zoom /* = nullptr */)
+  {
+    // same as RawDataDrawer::ExtractRange(), which see
+    TFrame const* pFrame = pPad->GetFrame();
+    if (!pFrame) return; // keep the old frame (if any)
+
+    // these coordinates are used to find the actual extent of pad in pixels
+    double low_x = pFrame->GetX1(), high_x = pFrame->GetX2();
+    double low_y = pFrame->GetY1(), high_y = pFrame->GetY2();
+    double const x_pixels = pPad->XtoAbsPixel(high_x) - pPad->XtoAbsPixel(low_x);
+    double const y_pixels = -(pPad->YtoAbsPixel(high_y) - pPad->YtoAbsPixel(low_y));
+
+    // the zoom from the frame is unreliable; if we have a better one, use it
+    if (zoom) {
+      low_x = (*zoom)[0];
+      high_x = (*zoom)[1];
+      low_y = (*zoom)[2];
+      high_y = (*zoom)[3];
+    }
+
+    // with the swapped orientation, wires are on the vertical axis
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
+    bool const swapped = (rawOpt->fAxisOrientation > 0);
+    double const low_wire = swapped ? low_y : low_x, high_wire = swapped ? high_y : high_x;
+    double const low_tdc = swapped ? low_x : low_y, high_tdc = swapped ? high_x : high_y;
+    double const wire_pixels = swapped ? y_pixels : x_pixels;
+    double const tdc_pixels = swapped ? x_pixels : y_pixels;
+
+    MF_LOG_DEBUG("RecoBaseDrawer")
+      << "ExtractRange() on pad '" << pPad->GetName() << "': " << wire_pixels << "x" << tdc_pixels
+      << " pixels spanning wires " << low_wire << "-" << high_wire << " and TDC " << low_tdc << "-"
+      << high_tdc;
+
+    fDrawingRange->SetWireRange(low_wire, high_wire, (unsigned int)wire_pixels, 1.0);
+    fDrawingRange->SetTDCRange(low_tdc, high_tdc, (unsigned int)tdc_pixels, 1.0);
+  } // RecoBaseDrawer::ExtractRange()
+
+  //......................................................................
+  PrimitiveBatches2D& RecoBaseDrawer::Batches(evdb::View2D const* view)
+  {
+    auto& batches = fBatches[view];
+    if (!batches) batches = std::make_unique<PrimitiveBatches2D>();
+    return *batches;
+  } // RecoBaseDrawer::Batches()
+
+  //......................................................................
+  void RecoBaseDrawer::ReleaseBatches(evdb::View2D const* view)
+  {
+    fBatches.erase(view);
+  } // RecoBaseDrawer::ReleaseBatches()
+
   //......................................................................
   ///
   /// Render Hit objects on a 2D viewing canvas
@@ -332,6 +439,10 @@ namespace evd {
 
     int nHitsDrawn(0);
 
+    // boxes and connecting lines have the same attributes
+    PrimitiveBatch2D& batch = Batches(view).Batch(color, lineWidth);
+    PrimitiveBatch2D& lines = Batches(view).Batch(color, 1);
+
     for (const auto& hit : hits) {
       // Note that the WireID in the hit object is useless for those detectors where a channel can correspond to
       // more than one plane/wire. So our plan is to recover the list of wire IDs from the channel number and
@@ -364,28 +475,12 @@ namespace evd {
         float rms = 0.5 * hit->RMS();
 
         if (rawOpt->fAxisOrientation < 1) {
-          TBox& b1 = view->AddBox(w - 0.5, time - rms, w + 0.5, time + rms);
-          if (drawConnectingLines && nHitsDrawn > 0) {
-            TLine& l = view->AddLine(w, time, wold, timeold);
-            l.SetLineColor(color);
-            l.SetBit(kCannotPick);
-          }
-          b1.SetFillStyle(0);
-          b1.SetBit(kCannotPick);
-          b1.SetLineColor(color);
-          b1.SetLineWidth(lineWidth);
+          batch.AddBox(w - 0.5, time - rms, w + 0.5, time + rms);
+          if (drawConnectingLines && nHitsDrawn > 0) lines.AddSegment(w, time, wold, timeold);
         }
         else {
-          TBox& b1 = view->AddBox(time - rms, w - 0.5, time + rms, w + 0.5);
-          if (drawConnectingLines && nHitsDrawn > 0) {
-            TLine& l = view->AddLine(time, w, timeold, wold);
-            l.SetLineColor(color);
-            l.SetBit(kCannotPick);
-          }
-          b1.SetFillStyle(0);
-          b1.SetBit(kCannotPick);
-          b1.SetLineColor(color);
-          b1.SetLineWidth(lineWidth);
+          batch.AddBox(time - rms, w - 0.5, time + rms, w + 0.5);
+          if (drawConnectingLines && nHitsDrawn > 0) lines.AddSegment(time, w, timeold, wold);
         }
         wold = w;
         timeold = time;
@@ -410,6 +505,10 @@ namespace evd {
     float timeold(0.);
     int nHitsDrawn(0);
 
+    PrimitiveBatch2D& lines = (rawOpt->fAxisOrientation < 1) ?
+                                Batches(view).Batch((cosmicscore > 0.5) ? kMagenta : 1, 3) :
+                                Batches(view).Batch(1, 1, (cosmicscore > 0.5) ? 2 : 1);
+
     for (const auto& hit : hits) {
       // check that we are in the correct TPC
       // the view should tell use we are in the correct plane
@@ -422,22 +521,11 @@ namespace evd {
       // the calibration chain
       float time = hit->PeakTime();
 
-      if (rawOpt->fAxisOrientation < 1) {
-        if (nHitsDrawn > 0) {
-          TLine& l = view->AddLine(w, time + 100, wold, timeold + 100);
-          l.SetLineWidth(3);
-          l.SetLineColor(1);
-          if (cosmicscore > 0.5) l.SetLineColor(kMagenta);
-          l.SetBit(kCannotPick);
-        }
-      }
-      else {
-        if (nHitsDrawn > 0) {
-          TLine& l = view->AddLine(time + 20, w, timeold + 20, wold);
-          l.SetLineColor(1);
-          if (cosmicscore > 0.5) l.SetLineStyle(2);
-          l.SetBit(kCannotPick);
-        }
+      if (nHitsDrawn > 0) {
+        if (rawOpt->fAxisOrientation < 1)
+          lines.AddSegment(w, time + 100, wold, timeold + 100);
+        else
+          lines.AddSegment(time + 20, w, timeold + 20, wold);
       }
 
       wold = w;
@@ -861,7 +949,8 @@ namespace evd {
       // No space points no continue
       if (spacePointVec.size() > 0) {
         // Add the relations to recover associations cluster hits
-        art::FindManyP<recob::Hit> spHitAssnVec(spacePointVec, evt, which);
+        auto const& spHitAssnVec =
+          AssociationCache::FindManyP<recob::SpacePoint, recob::Hit>(evt, which, which);
 
         if (spHitAssnVec.isValid()) {
           // Create a local hit vector...
@@ -888,8 +977,9 @@ namespace evd {
       }
 
       // Ok, now proceed with our normal processing of hits on clusters
-      art::FindMany<recob::Hit> fmh(clust, evt, which);
-      art::FindManyP<recob::PFParticle> fmc(clust, evt, which);
+      auto const& fmh = AssociationCache::FindMany<recob::Cluster, recob::Hit>(evt, which, which);
+      auto const& fmc =
+        AssociationCache::FindManyP<recob::Cluster, recob::PFParticle>(evt, which, which);
 
       for (size_t ic = 0; ic < clust.size(); ++ic) {
         if (clust[ic]->Plane().Plane != plane) continue;
@@ -902,7 +992,7 @@ namespace evd {
         float cosmicscore = FLT_MIN;
 
         if (fmc.isValid()) {
-          std::vector<art::Ptr<recob::PFParticle>> pfplist = fmc.at(ic);
+          std::vector<art::Ptr<recob::PFParticle>> const& pfplist = fmc.at(ic);
           // Use the first one
           if (!pfplist.empty()) {
             clusterIdx = pfplist[0]->Self();
@@ -911,9 +1001,10 @@ namespace evd {
             pfpIndex = pfplist[0]->Self();
             //Get cosmic score
             if (recoOpt->fDrawCosmicTags) {
-              art::FindManyP<anab::CosmicTag> fmct(pfplist, evt, which);
+              auto const& fmct = AssociationCache::FindManyP<recob::PFParticle, anab::CosmicTag>(
+                evt, pfplist[0].id(), which);
               if (fmct.isValid()) {
-                std::vector<art::Ptr<anab::CosmicTag>> ctlist = fmct.at(0);
+                std::vector<art::Ptr<anab::CosmicTag>> const& ctlist = fmct.at(pfplist[0].key());
                 if (!ctlist.empty()) { cosmicscore = ctlist[0]->CosmicScore(); }
               }
             }
@@ -1373,11 +1464,12 @@ namespace evd {
         auto tracks = GetTracks(evt, which);
         if (!tracks || tracks->size() < 1) continue;
 
-        art::FindMany<recob::Hit> fmh(tracks, evt, which);
+        auto const& fmh = AssociationCache::FindMany<recob::Track, recob::Hit>(evt, which, which);
 
         art::InputTag const whichTag(
           recoOpt->fCosmicTagLabels.size() > imod ? recoOpt->fCosmicTagLabels[imod] : "");
-        art::FindManyP<anab::CosmicTag> cosmicTrackTags(tracks, evt, whichTag);
+        auto const& cosmicTrackTags =
+          AssociationCache::FindManyP<recob::Track, anab::CosmicTag>(evt, which, whichTag);
 
         auto tracksProxy = proxy::getCollection<proxy::Tracks>(evt, which);
 
@@ -1471,7 +1563,7 @@ namespace evd {
         auto showers = GetShowers(evt, which);
         if (!showers || showers->size() < 1) continue;
 
-        art::FindMany<recob::Hit> fmh(showers, evt, which);
+        auto const& fmh = AssociationCache::FindMany<recob::Shower, recob::Hit>(evt, which, which);
 
         // loop over the prongs and get the clusters and hits associated with
         // them.  only keep those that are in this view
@@ -1595,10 +1687,10 @@ namespace evd {
       if (vertexTrackAssnsHandle->size() < 1) continue;
 
       // Get the rest of the associations in the standard way
-      art::FindMany<recob::Hit> fmh(trackCol, evt, which);
+      auto const& fmh = AssociationCache::FindMany<recob::Track, recob::Hit>(evt, which, which);
 
-      art::FindManyP<anab::CosmicTag> cosmicTrackTags(
-        trackCol, evt, recoOpt->fTrkVtxCosmicLabels[imod]);
+      auto const& cosmicTrackTags = AssociationCache::FindManyP<recob::Track, anab::CosmicTag>(
+        evt, which, recoOpt->fTrkVtxCosmicLabels[imod]);
 
       auto tracksProxy = proxy::getCollection<proxy::Tracks>(evt, which);
 
@@ -1983,37 +2075,44 @@ namespace evd {
       std::vector<art::Ptr<recob::SpacePoint>> spacePointVec;
       GetSpacePoints(evt, assns, spacePointVec);
 
-      // Recover the edges
-      std::vector<art::Ptr<recob::Edge>> edgeVec;
-      if (recoOpt->fDrawEdges) GetEdges(evt, assns, edgeVec);
-
       // No space points no continue
       if (spacePointVec.empty()) continue;
 
       // Add the relations to recover associations cluster hits
-      art::FindManyP<recob::SpacePoint> edgeSpacePointAssnsVec(edgeVec, evt, assns);
-      art::FindManyP<recob::SpacePoint> spacePointAssnVec(pfParticleVec, evt, assns);
-      art::FindManyP<recob::Hit> spHitAssnVec(spacePointVec, evt, assns);
-      art::FindManyP<recob::Edge> edgeAssnsVec(pfParticleVec, evt, assns);
+      // (the edges are looked up only when requested)
+      auto const& edgeSpacePointAssnsVec =
+        recoOpt->fDrawEdges ?
+          AssociationCache::FindManyP<recob::Edge, recob::SpacePoint>(evt, assns, assns) :
+          AssociationCache::FindManyP<recob::Edge, recob::SpacePoint>(
+            evt, art::ProductID(), assns);
+      auto const& spacePointAssnVec =
+        AssociationCache::FindManyP<recob::PFParticle, recob::SpacePoint>(evt, which, assns);
+      auto const& spHitAssnVec =
+        AssociationCache::FindManyP<recob::SpacePoint, recob::Hit>(evt, assns, assns);
+      auto const& edgeAssnsVec =
+        AssociationCache::FindManyP<recob::PFParticle, recob::Edge>(evt, which, assns);
 
       // If no valid space point associations then nothing to do
       if (!spacePointAssnVec.isValid()) continue;
 
       // Need the PCA info as well
-      art::FindMany<recob::PCAxis> pcAxisAssnVec(pfParticleVec, evt, which);
+      auto const& pcAxisAssnVec =
+        AssociationCache::FindMany<recob::PFParticle, recob::PCAxis>(evt, which, which);
 
       // Want CR tagging info
       // Note the cosmic tags come from a different producer - we assume that the producers are
       // matched in the fcl label vectors!
       art::InputTag cosmicTagLabel =
         imod < recoOpt->fCosmicTagLabels.size() ? recoOpt->fCosmicTagLabels[imod] : "";
-      art::FindMany<anab::CosmicTag> pfCosmicAssns(pfParticleVec, evt, cosmicTagLabel);
+      auto const& pfCosmicAssns =
+        AssociationCache::FindMany<recob::PFParticle, anab::CosmicTag>(evt, which, cosmicTagLabel);
 
       // We also want to drive display of tracks but have the same issue with production... so follow the
       // same prescription.
       art::InputTag trackTagLabel =
         imod < recoOpt->fTrackLabels.size() ? recoOpt->fTrackLabels[imod] : "";
-      art::FindMany<recob::Track> pfTrackAssns(pfParticleVec, evt, trackTagLabel);
+      auto const& pfTrackAssns =
+        AssociationCache::FindMany<recob::PFParticle, recob::Track>(evt, which, trackTagLabel);
 
       // Commence looping over possible clusters
       for (size_t idx = 0; idx < pfParticleVec.size(); idx++) {
@@ -3092,13 +3191,15 @@ namespace evd {
       if (pfParticleVec.size() < 1) continue;
 
       // Add the relations to recover associations cluster hits
-      art::FindMany<recob::SpacePoint> spacePointAssnVec(pfParticleVec, evt, which);
+      auto const& spacePointAssnVec =
+        AssociationCache::FindMany<recob::PFParticle, recob::SpacePoint>(evt, which, which);
 
       // If no valid space point associations then nothing to do
       if (!spacePointAssnVec.isValid()) continue;
 
       // Need the PCA info as well
-      art::FindMany<recob::PCAxis> pcAxisAssnVec(pfParticleVec, evt, which);
+      auto const& pcAxisAssnVec =
+        AssociationCache::FindMany<recob::PFParticle, recob::PCAxis>(evt, which, which);
 
       if (!pcAxisAssnVec.isValid()) continue;
 
@@ -3680,32 +3781,22 @@ namespace evd {
                               unsigned int plane)
   {
     art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
-    auto const& wireReadoutGeom = getWireReadoutGeom();
 
     hits.clear();
 
-    auto hitsH = evt.getHandle<std::vector<recob::Hit>>(which);
-    try {
-      *hitsH;
-    }
-    catch (cet::exception& e) {
-      writeErrMsg("GetHits", e);
+    HitIndex const& hitIndex = HitIndex::Get(evt, which);
+    if (!hitIndex.isValid()) {
+      mf::LogWarning("RecoBaseDrawer")
+        << "RecoBaseDrawer::GetHits failed: no hit collection '" << which.encode() << "'";
       return 0;
     }
 
-    for (const auto& hit : *hitsH) {
-      // Note that the WireID in the hit object is useless for those detectors where a channel can correspond to
-      // more than one plane/wire. So our plan is to recover the list of wire IDs from the channel number and
-      // loop over those (if there are any)
-      const std::vector<geo::WireID>& wireIDs = wireReadoutGeom.ChannelToWire(hit.Channel());
-
-      // Loop to find match
-      for (const auto& wireID : wireIDs) {
-        if (wireID.Plane == plane && wireID.TPC == rawOpt->fTPC &&
-            wireID.Cryostat == rawOpt->fCryostat)
-          hits.push_back(&hit);
-      }
-    }
+    // the index already lists the hits on all the wires of their channel
+    HitIndex::Range_t const planeHits =
+      hitIndex.Plane(geo::PlaneID(rawOpt->fCryostat, rawOpt->fTPC, plane));
+    hits.reserve(planeHits.size());
+    for (HitIndex::HitEntry_t const& entry : planeHits)
+      hits.push_back(entry.hit);
 
     return hits.size();
   }
@@ -3971,25 +4062,6 @@ namespace evd {
     return event.size();
   }
 
-  //......................................................................
-  int RecoBaseDrawer::CountHits(const art::Event& evt,
-                                const art::InputTag& which,
-                                unsigned int cryostat,
-                                unsigned int tpc,
-                                unsigned int plane)
-  {
-    int NumberOfHitsBeforeThisPlane = 0;
-    auto const& hits = evt.getProduct<std::vector<recob::Hit>>(which);
-    //hits.size() = total number of hits for this event (number of all hits in all Cryostats, TPC's, planes and wires)
-    for (recob::Hit const& hit : hits) {
-      if (hit.WireID().Cryostat == cryostat && hit.WireID().TPC == tpc &&
-          hit.WireID().Plane == plane)
-        break;
-      NumberOfHitsBeforeThisPlane++;
-    }
-    return NumberOfHitsBeforeThisPlane;
-  }
-
   //......................................................................
   void RecoBaseDrawer::FillTQHisto(const art::Event& evt,
                                    unsigned int plane,
@@ -4026,10 +4098,14 @@ namespace evd {
         }
         if (!goodWID) continue;
 
-        std::vector<float> wirSig = wires[i]->Signal();
-        for (unsigned int ii = 0; ii < wirSig.size(); ++ii) {
-          minSig = std::min(minSig, wirSig[ii]);
-          maxSig = std::max(maxSig, wirSig[ii]);
+        WireSignalView const signal(*wires[i]);
+        signal.forEachROISample([&minSig, &maxSig](size_t, float sig) {
+          minSig = std::min(minSig, sig);
+          maxSig = std::max(maxSig, sig);
+        });
+        if (signal.nZeroSamples() > 0) {
+          minSig = std::min(minSig, 0.F);
+          maxSig = std::max(maxSig, 0.F);
         }
 
         setLimits = true;
@@ -4071,9 +4147,9 @@ namespace evd {
             goodWID = true;
         }
         if (!goodWID) continue;
-        std::vector<float> wirSig = wires[i]->Signal();
-        for (unsigned int ii = 0; ii < wirSig.size(); ++ii)
-          histo->Fill(wirSig[ii]);
+        WireSignalView const signal(*wires[i]);
+        signal.forEachROISample([histo](size_t, float sig) { histo->Fill(sig); });
+        FillZeros(*histo, signal.nZeroSamples());
 
       } //end loop over raw hits
     }   //end loop over Wire modules
@@ -4121,9 +4197,10 @@ namespace evd {
 
         if (!goodWID) continue;
 
-        std::vector<float> wirSig = wires[i]->Signal();
-        for (unsigned int ii = 0; ii < wirSig.size(); ++ii)
-          histo->Fill(1. * ii, wirSig[ii]);
+        // samples out of the regions of interest have no weight
+        WireSignalView const signal(*wires[i]);
+        signal.forEachROISample([histo](size_t ii, float sig) { histo->Fill(1. * ii, sig); });
+        histo->SetEntries(histo->GetEntries() + signal.nZeroSamples());
         break;
       } //end loop over wires
     }   //end loop over wire modules
@@ -4131,26 +4208,24 @@ namespace evd {
     for (size_t imod = 0; imod < recoOpt->fHitLabels.size(); ++imod) {
       art::InputTag const which = recoOpt->fHitLabels[imod];
 
-      std::vector<const recob::Hit*> hits;
-      GetHits(evt, which, hits, plane);
+      HitIndex const& hitIndex = HitIndex::Get(evt, which);
+      if (!hitIndex.isValid()) continue;
 
       auto hitResults = anab::FVectorReader<recob::Hit, 4>::create(evt, "dprawhit");
       const auto& fitParams = hitResults->vectors();
 
-      int FitParamsOffset = CountHits(evt, which, rawOpt->fCryostat, rawOpt->fTPC, plane);
-
-      for (size_t i = 0; i < hits.size(); ++i) {
-        // check for correct wire. Plane, cryostat and tpc were checked in GetHits
-        if (hits[i]->WireID().Wire != wire) continue;
-
-        hpeaktimes.push_back(fitParams[FitParamsOffset + i][0]);
-        htau1.push_back(fitParams[FitParamsOffset + i][1]);
-        htau2.push_back(fitParams[FitParamsOffset + i][2]);
-        hitamplitudes.push_back(fitParams[FitParamsOffset + i][3]);
-        hstartT.push_back(hits[i]->StartTick());
-        hendT.push_back(hits[i]->EndTick());
-        hNMultiHit.push_back(hits[i]->Multiplicity());
-        hLocalHitIndex.push_back(hits[i]->LocalIndex());
+      // the fit parameters are parallel to the hit collection
+      geo::WireID const wireID(rawOpt->fCryostat, rawOpt->fTPC, plane, wire);
+      for (HitIndex::HitEntry_t const& entry : hitIndex.Wire(wireID)) {
+        // the index is sorted by peak time, the hit collection might not be
+        hpeaktimes.push_back(fitParams[entry.index][0]);
+        htau1.push_back(fitParams[entry.index][1]);
+        htau2.push_back(fitParams[entry.index][2]);
+        hitamplitudes.push_back(fitParams[entry.index][3]);
+        hstartT.push_back(entry->StartTick());
+        hendT.push_back(entry->EndTick());
+        hNMultiHit.push_back(entry->Multiplicity());
+        hLocalHitIndex.push_back(entry->LocalIndex());
       } //end loop over reco hits
     }   //end loop over HitFinding modules
   }
@@ -5,6 +5,7 @@
 #define EVD_RECOBASEDRAWER_H
 
 #include <array>
+#include <map>
 #include <memory> // std::unique_ptr<>
 #include <vector>
 
@@ -57,16 +58,37 @@ namespace anab {
 
 class TVector3;
 class TH1F;
+class TVirtualPad;
 
 namespace evd {
 
+  namespace details {
+    class CellGridClass;
+  }
+  class PrimitiveBatches2D;
+
   /// Aid in the rendering of RecoBase objects
   class RecoBaseDrawer {
   public:
     RecoBaseDrawer();
     ~RecoBaseDrawer();
 
+    /**
+     * @brief Draws calibrated wire content in 2D wire plane representation
+     * @param evt source for the wires
+     * @param view target rendered object
+     * @param plane number of the plane to be drawn
+     *
+     * As for `RawDataDrawer::RawDigit2D()`, the signal is aggregated into a
+     * grid of cells matching the viewport set by `ExtractRange()`, and at most
+     * one box is sent to the view for each cell. The region of interest
+     * (`GetRegionOfInterest()`) is extracted from the whole plane in the same
+     * pass.
+     */
     void Wire2D(const art::Event& evt, evdb::View2D* view, unsigned int plane);
+
+    /// Fills the viewport information from the specified pad
+    void ExtractRange(TVirtualPad* pPad, std::vector<double> const* zoom = nullptr);
     int Hit2D(const art::Event& evt,
               detinfo::DetectorPropertiesData const& detProp,
               evdb::View2D* view,
@@ -79,6 +101,21 @@ namespace evd {
               int lineWidth = 1);
     int Hit2D(std::vector<const recob::Hit*> hits, evdb::View2D* view, float cosmicscore);
 
+    /**
+     * @brief Returns the batched primitives drawn by this drawer into `view`
+     *
+     * The boxes and lines of the hits (`Hit2D()`, and so `Cluster2D()`,
+     * `Prong2D()`...) are not added to the view but to these batches, one for
+     * each color and line style. The owner of the view must clear them
+     * together with the view, draw them after `evdb::View2D::Draw()`, and
+     * release them with `ReleaseBatches()` when the view is destroyed, since
+     * another view may later take its address.
+     */
+    PrimitiveBatches2D& Batches(evdb::View2D const* view);
+
+    /// Drops the batched primitives of `view`, which is going to be destroyed
+    void ReleaseBatches(evdb::View2D const* view);
+
     void EndPoint2D(const art::Event& evt, evdb::View2D* view, unsigned int plane);
     void OpFlash2D(const art::Event& evt,
                    detinfo::DetectorClocksData const& clockData,
@@ -315,12 +352,6 @@ namespace evd {
                                                 const TVector3& axisDir,
                                                 const double& radius);
 
-    int CountHits(const art::Event& evt,
-                  const art::InputTag& which,
-                  unsigned int cryostat,
-                  unsigned int tpc,
-                  unsigned int plane);
-
   private:
     using ISpacePointDrawerPtr = std::unique_ptr<evdb_tool::ISpacePoints3D>;
 
@@ -334,6 +365,11 @@ namespace evd {
 
     std::vector<double> fRawCharge;       ///< Sum of Raw Charge
     std::vector<double> fConvertedCharge; ///< Sum of Charge Converted using Birks' formula
+
+    std::unique_ptr<details::CellGridClass> fDrawingRange; ///< information about the viewport
+
+    /// Batched primitives for each view this drawer draws into
+    std::map<evdb::View2D const*, std::unique_ptr<PrimitiveBatches2D>> fBatches;
   };
 }
 
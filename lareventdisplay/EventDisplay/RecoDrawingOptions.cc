@@ -6,6 +6,9 @@
 /// LArSoft includes
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
 
+#include <functional> // std::hash
+#include <string>
+
 namespace evd {
 
   //......................................................................
@@ -18,6 +21,7 @@ namespace evd {
   //......................................................................
   void RecoDrawingOptions::reconfigure(fhicl::ParameterSet const& pset)
   {
+    fConfigHash = std::hash<std::string>{}(pset.id().to_string());
     fDrawHits = pset.get<int>("DrawHits");
     fDrawClusters = pset.get<int>("DrawClusters");
     fDrawSlices = pset.get<int>("DrawSlices", 0);
@@ -72,6 +76,8 @@ namespace evd {
     fWireLabels = pset.get<std::vector<art::InputTag>>("WireModuleLabels");
     fColorProngsByLabel = pset.get<int>("ColorProngsByLabel");
     fColorSpacePointsByChisq = pset.get<int>("ColorSpacePointsByChisq");
+    fSpacePoint3DCellPixels = pset.get<double>("SpacePoint3DCellPixels", 0.);
+    fSpacePoint3DMaxPerCell = pset.get<unsigned int>("SpacePoint3DMaxPerCell", 1);
     fCaloPSet = pset.get<fhicl::ParameterSet>("CalorimetryAlgorithm");
     //   fSeedPSet = pset.get< fhicl::ParameterSet >("SeedAlgorithm");
 
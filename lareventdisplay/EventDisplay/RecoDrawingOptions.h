@@ -7,6 +7,7 @@
 #ifndef RECODRAWINGOPTIONS_H
 #define RECODRAWINGOPTIONS_H
 #ifndef __CINT__
+#include <cstddef> // std::size_t
 #include <string>
 #include <vector>
 
@@ -88,6 +89,9 @@ namespace evd {
     int fColorProngsByLabel;      ///< Generate prong colors by label or id?
     int fColorSpacePointsByChisq; ///< Generate space point colors by chisquare?
 
+    double fSpacePoint3DCellPixels;       ///< side of the cells merging 3D space points [pixel]
+    unsigned int fSpacePoint3DMaxPerCell; ///< space points in a cell drawn without merging
+
     double fFlashMinPE; ///< Minimal PE for a flash to be displayed.
     double fFlashTMin;  ///< Minimal time for a flash to be displayed.
     double fFlashTMax;  ///< Maximum time for a flash to be displayed.
@@ -99,6 +103,8 @@ namespace evd {
     fhicl::ParameterSet fAllSpacePointDrawerParams; ///< FHICL parameters for SpacePoint drawing
 
     fhicl::ParameterSet f3DDrawerParams; ///< FHICL paramegers for the 3D drawers
+
+    std::size_t fConfigHash; ///< hash of the configuration last applied by `reconfigure()`
   };
 } //namespace
 #endif // __CINT__
@@ -3,16 +3,10 @@
 /// \author T. Usher
 ////////////////////////////////////////////////////////////////////////
 
-#include "larcore/Geometry/Geometry.h"
-#include "lardata/DetectorInfoServices/DetectorClocksService.h"
-#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
-#include "lardataalg/DetectorInfo/DetectorProperties.h"
 #include "lareventdisplay/EventDisplay/SimDrawers/ISim3DDrawer.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SimulationPayload.h"
 #include "lareventdisplay/EventDisplay/Style.h"
-#include "larsim/Simulation/LArVoxelData.h"
-#include "larsim/Simulation/LArVoxelList.h"
-#include "larsim/Simulation/SimListUtils.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -21,7 +15,6 @@
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Utilities/ToolMacros.h"
-#include "canvas/Persistency/Common/Ptr.h"
 #include "cetlib_except/exception.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
@@ -55,56 +48,34 @@ namespace evdb_tool {
     // If the option is turned off, there's nothing to do
     if (!drawOpt->fShowMCTruthTrajectories) return;
 
-    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
-    art::ServiceHandle<geo::Geometry const> geom;
+    // The particles, their trajectories and the true energy deposition locations (from the
+    // LArVoxelList) are collected once per event and shared with the other views
+    evd::SimulationPayload& payload = evd::SimulationPayload::Instance();
+    payload.Update(evt);
+    std::vector<simb::MCParticle> const& particles = payload.Particles();
 
-    // Recover a handle to the collection of MCParticles
-    art::Handle<std::vector<simb::MCParticle>> mcParticleHandle;
-
-    evt.getByLabel(drawOpt->fG4ModuleLabel, mcParticleHandle);
-
-    if (!mcParticleHandle.isValid()) return;
+    if (particles.empty()) return;
 
     // Define a couple of colors for neutrals and if we gray it out...
     int neutralColor(12);
     int grayedColor(15);
     int neutrinoColor(38);
 
-    // Use the LArVoxelList to get the true energy deposition locations as opposed to using MCTrajectories
-    const sim::LArVoxelList voxels =
-      sim::SimListUtils::GetLArVoxelList(evt, drawOpt->fSimChannelLabel.encode());
-
     mf::LogDebug("SimulationDrawer")
-      << "Starting loop over " << mcParticleHandle->size() << " McParticles, voxel list size is "
-      << voxels.size() << std::endl;
-
-    // Using the voxel information can be slow (see previous implementation of this code).
-    // In order to speed things up we have modified the strategy:
-    // 1) Make one pass through the list of voxels
-    // 2) For each voxel, keep track of the MCParticle contributing energy to it and it's position
-    //    which is done by keeping a map between the MCParticle and a vector of positions
-    // 3) Then loop through the map to draw the particle trajectories.
-    // One caveat is the need for MCParticles... and the voxels contain the track ids. So we'll need one
-    // more loop to make a map of track id's and MCParticles.
-
-    // First up is to build the map between track id's and associated MCParticles so we can recover when looping over voxels
-    std::map<int, const simb::MCParticle*> trackToMcParticleMap;
+      << "Starting loop over " << particles.size() << " McParticles, with " << payload.NDeposits()
+      << " energy deposits" << std::endl;
 
     // Should we display the trajectories too?
     double minPartEnergy(0.01);
 
-    for (size_t p = 0; p < mcParticleHandle->size(); ++p) {
-      art::Ptr<simb::MCParticle> mcParticle(mcParticleHandle, p);
+    // buffer of the positions to draw, shifted according to the particle timing
+    std::vector<double> hitPositions;
 
-      trackToMcParticleMap[mcParticle->TrackId()] = mcParticle.get();
+    for (size_t p = 0; p < particles.size(); ++p) {
+      const simb::MCParticle* mcParticle = &particles[p];
 
       // Quick loop through to draw trajectories...
       if (drawOpt->fShowMCTruthTrajectories) {
-        // Is there an associated McTrajectory?
-        const simb::MCTrajectory& mcTraj = mcParticle->Trajectory();
-
         int pdgCode(mcParticle->PdgCode());
         int colorIdx(evd::Style::ColorFromPDG(mcParticle->PdgCode()));
         TParticlePDG* partPDG(TDatabasePDG::Instance()->GetParticle(pdgCode));
@@ -113,47 +84,35 @@ namespace evdb_tool {
 
         if (!drawOpt->fShowMCTruthColors) colorIdx = grayedColor;
 
-        if (!mcTraj.empty() && partEnergy > minPartEnergy && mcParticle->TrackId() < 100000000) {
-          double g4Ticks(clockData.TPCG4Time2Tick(mcParticle->T()) - trigger_offset(clockData));
-          double xOffset(0.);
-          double xPosMinTick = 0.;
-          double xPosMaxTick = std::numeric_limits<double>::max();
+        // collect the points from this particle
+        int numTrajPoints = payload.NTrajectoryPoints(p);
 
-          // collect the points from this particle
-          int numTrajPoints = mcTraj.size();
+        if (numTrajPoints > 0 && partEnergy > minPartEnergy && mcParticle->TrackId() < 100000000) {
+          double g4Ticks(payload.G4Ticks(p));
 
-          std::unique_ptr<double[]> hitPositions(new double[3 * numTrajPoints]);
+          hitPositions.resize(3 * numTrajPoints);
           int hitCount(0);
 
-          for (int hitIdx = 0; hitIdx < numTrajPoints; hitIdx++) {
-            double xPos = mcTraj.X(hitIdx);
-            double yPos = mcTraj.Y(hitIdx);
-            double zPos = mcTraj.Z(hitIdx);
+          // If we have cosmic rays then we need to get the offset which allows translating from
+          // when they were generated vs when they were tracked, which depends on the TPC.
+          // Note that this also explicitly checks that they are in a TPC volume
+          double const* trajPoints = payload.TrajectoryPoints(p);
+          evd::SimulationPayload::TPCInfo_t const* const* pointTPCs = payload.TrajectoryTPCs(p);
 
-            // If we have cosmic rays then we need to get the offset which allows translating from
-            // when they were generated vs when they were tracked.
-            // Note that this also explicitly checks that they are in a TPC volume
-            geo::Point_t hitLocation(xPos, yPos, zPos);
-
-            try {
-              geo::TPCID tpcID = geom->PositionToTPCID(hitLocation);
-              geo::PlaneID planeID(tpcID, 0);
+          for (int hitIdx = 0; hitIdx < numTrajPoints; hitIdx++) {
+            evd::TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[hitIdx];
 
-              xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-              xPosMaxTick = detProp.ConvertTicksToX(detProp.NumberTimeSamples(), planeID);
-              xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
+            if (!tpc) continue;
 
-              if (xPosMaxTick < xPosMinTick) std::swap(xPosMinTick, xPosMaxTick);
-            }
-            catch (...) {
-              continue;
-            }
+            double xPos = trajPoints[3 * hitIdx];
+            double yPos = trajPoints[3 * hitIdx + 1];
+            double zPos = trajPoints[3 * hitIdx + 2];
 
             // Now move the hit position to correspond to the timing
-            xPos += xOffset;
+            xPos += tpc->TickToX(g4Ticks) - tpc->xAtTick0;
 
             // Check fiducial limits
-            if (xPos > xPosMinTick && xPos < xPosMaxTick) {
+            if (xPos > tpc->driftMinX && xPos < tpc->driftMaxX) {
               hitPositions[3 * hitCount] = xPos;
               hitPositions[3 * hitCount + 1] = yPos;
               hitPositions[3 * hitCount + 2] = zPos;
@@ -169,50 +128,22 @@ namespace evdb_tool {
             pl.SetLineStyle(3);
             pl.SetLineWidth(1);
           }
-          pl.SetPolyLine(hitCount, hitPositions.get(), "");
+          pl.SetPolyLine(hitCount, hitPositions.data(), "");
         }
       }
     }
 
-    // Now we set up and build the map between MCParticles and a vector of positions obtained from the voxels
-    std::map<const simb::MCParticle*, std::vector<std::vector<double>>> partToPosMap;
-
-    sim::LArVoxelList::const_iterator vxitr;
-    for (vxitr = voxels.begin(); vxitr != voxels.end(); vxitr++) {
-      const sim::LArVoxelData& vxd = (*vxitr).second;
-
-      for (size_t partIdx = 0; partIdx < vxd.NumberParticles(); partIdx++) {
-        if (vxd.Energy(partIdx) > drawOpt->fMinEnergyDeposition) {
-          int trackId = vxd.TrackID(partIdx);
+    // Finally ready for the main event! Simply loop through the MCParticles and the positions
+    // of their energy deposits to draw the trajectories
+    for (size_t mcPartIdx = 0; mcPartIdx < particles.size(); mcPartIdx++) {
+      // Maybe no points to plot
+      size_t const numPositions = payload.NDeposits(mcPartIdx);
+      if (numPositions == 0) continue;
 
-          // It can be in some instances that mcPart here could be zero.
-          const simb::MCParticle* mcPart = trackToMcParticleMap[trackId];
-
-          partToPosMap[mcPart].push_back(std::vector<double>(3));
-
-          partToPosMap[mcPart].back()[0] = vxd.VoxelID().X();
-          partToPosMap[mcPart].back()[1] = vxd.VoxelID().Y();
-          partToPosMap[mcPart].back()[2] = vxd.VoxelID().Z();
-        }
-      } // end if this track id is in the current voxel
-    }   // end loop over voxels
-
-    // Finally ready for the main event! Simply loop through the map between MCParticle and positions to
-    // draw the trajectories
-    std::map<const simb::MCParticle*, std::vector<std::vector<double>>>::iterator partToPosMapItr;
-
-    for (partToPosMapItr = partToPosMap.begin(); partToPosMapItr != partToPosMap.end();
-         partToPosMapItr++) {
       // Recover the McParticle, we'll need to access several data members so may as well dereference it
-      const simb::MCParticle* mcPart = partToPosMapItr->first;
-
-      // Apparently, it can happen that we get a null pointer here or maybe no points to plot
-      if (!mcPart || partToPosMapItr->second.empty()) continue;
+      const simb::MCParticle* mcPart = &particles[mcPartIdx];
 
-      double g4Ticks(clockData.TPCG4Time2Tick(mcPart->T()) - trigger_offset(clockData));
-      double xOffset = 0.;
-      double xPosMinTick = 0.;
-      double xPosMaxTick = std::numeric_limits<double>::max();
+      double g4Ticks(payload.G4Ticks(mcPartIdx));
 
       int colorIdx(evd::Style::ColorFromPDG(mcPart->PdgCode()));
       int markerIdx(kFullDotSmall);
@@ -224,35 +155,24 @@ namespace evdb_tool {
         markerSize = 1;
       }
 
-      std::unique_ptr<double[]> hitPositions(new double[3 * partToPosMapItr->second.size()]);
+      double const* positions = payload.Deposits(mcPartIdx);
+      evd::SimulationPayload::TPCInfo_t const* const* pointTPCs = payload.DepositTPCs(mcPartIdx);
+
+      hitPositions.resize(3 * numPositions);
       int hitCount(0);
 
       // Now loop over points and add to trajectory
-      for (size_t posIdx = 0; posIdx < partToPosMapItr->second.size(); posIdx++) {
-        const std::vector<double>& posVec = partToPosMapItr->second[posIdx];
-
-        // Check xOffset state and set if necessary
-        geo::Point_t hitLocation(posVec[0], posVec[1], posVec[2]);
-
-        try {
-          geo::TPCID tpcID = geom->PositionToTPCID(hitLocation);
-          geo::PlaneID planeID(tpcID, 0);
+      for (size_t posIdx = 0; posIdx < numPositions; posIdx++) {
+        const double* posVec = positions + 3 * posIdx;
+        evd::TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[posIdx];
 
-          xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-          xPosMaxTick = detProp.ConvertTicksToX(detProp.NumberTimeSamples(), planeID);
-          xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
-
-          if (xPosMaxTick < xPosMinTick) std::swap(xPosMinTick, xPosMaxTick);
-        }
-        catch (...) {
-          continue;
-        }
+        if (!tpc) continue;
 
-        double xCoord = posVec[0] + xOffset;
+        double xCoord = posVec[0] + tpc->TickToX(g4Ticks) - tpc->xAtTick0;
 
         // If a voxel records an energy deposit then must have been in the TPC
         // But because things get shifted still need to cut off if outside drift
-        if (xCoord > xPosMinTick && xCoord < xPosMaxTick) {
+        if (xCoord > tpc->driftMinX && xCoord < tpc->driftMaxX) {
           hitPositions[3 * hitCount] = xCoord;
           hitPositions[3 * hitCount + 1] = posVec[1];
           hitPositions[3 * hitCount + 2] = posVec[2];
@@ -261,7 +181,7 @@ namespace evdb_tool {
       }
 
       TPolyMarker3D& pm = view->AddPolyMarker3D(1, colorIdx, markerIdx, markerSize);
-      pm.SetPolyMarker(hitCount, hitPositions.get(), markerIdx);
+      pm.SetPolyMarker(hitCount, hitPositions.data(), markerIdx);
     }
 
     // Finally, let's see if we can draw the incoming particle from the MCTruth information
@@ -9,8 +9,10 @@
 #include "lardataalg/DetectorInfo/DetectorProperties.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 #include "lareventdisplay/EventDisplay/SimDrawers/ISim3DDrawer.h"
+#include "lareventdisplay/EventDisplay/SimDrawers/ParticleBuckets.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/Style.h"
+#include "lareventdisplay/EventDisplay/TPCDriftTable.h"
 
 #include "nuevdb/EventDisplayBase/View3D.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -72,13 +74,8 @@ namespace evdb_tool {
 
     if (!mcParticleHandle.isValid()) return;
 
-    // Create a mapping between track ID's and MCParticles
-    using TrackToMcParticleMap = std::map<int, const simb::MCParticle*>;
-
-    TrackToMcParticleMap trackToMcParticleMap;
-
-    for (const auto& mcParticle : *mcParticleHandle)
-      trackToMcParticleMap[mcParticle.TrackId()] = &mcParticle;
+    // Create an index of the MCParticles by track ID
+    evd::TrackIDIndex const trackIndex(*mcParticleHandle);
 
     // Now recover the simchannels
     art::Handle<std::vector<sim::SimEnergyDeposit>> simEnergyDepositHandle;
@@ -94,86 +91,84 @@ namespace evdb_tool {
         << "Starting loop over " << simEnergyDepositHandle->size() << " SimEnergyDeposits, "
         << std::endl;
 
-      art::ServiceHandle<geo::Geometry const> geom;
+      // If we have cosmic rays then we need to get the offset which allows translating from
+      // when they were generated vs when they were tracked, which depends on the TPC.
+      // Note that this also explicitly checks that they are in a TPC volume
+      evd::TPCDriftTable const tpcTable(*(art::ServiceHandle<geo::Geometry const>()), detProp);
+      std::vector<evd::TPCDriftTable::TPCInfo_t const*> depositTPCs;
 
-      // First step is to create a map between MCParticle and SimEnergyDeposit objects...
-      using MCPartToSimEnergyMap =
-        std::map<const simb::MCParticle*, std::vector<const sim::SimEnergyDeposit*>>;
+      tpcTable.Classify(
+        simEnergyDepositHandle->size(),
+        [&deposits = *simEnergyDepositHandle](std::size_t i) { return deposits[i].MidPoint(); },
+        depositTPCs);
 
-      MCPartToSimEnergyMap mcPartToSimEnergyMap;
+      // Would like to draw the deposits as markers with colors given by particle id
+      // So we make two passes: the first finds the color and the time-corrected position of
+      // each deposit and counts the deposits of each color, the second stores the positions
+      // grouped by color in a single buffer
+      constexpr std::size_t noColor = std::numeric_limits<std::size_t>::max();
 
-      // Go through the SimEnergyDeposits and populate the map
-      for (const auto& simEnergyDeposit : *simEnergyDepositHandle) {
-        TrackToMcParticleMap::const_iterator trackMCItr =
-          trackToMcParticleMap.find(simEnergyDeposit.TrackID());
+      std::vector<int> colors;
+      std::vector<std::size_t> depositColors(simEnergyDepositHandle->size(), noColor);
+      std::vector<double> depositXPos(simEnergyDepositHandle->size());
 
-        if (trackMCItr == trackToMcParticleMap.end()) continue;
+      for (size_t depIdx = 0; depIdx < simEnergyDepositHandle->size(); depIdx++) {
+        const sim::SimEnergyDeposit& simEnergyDeposit = (*simEnergyDepositHandle)[depIdx];
 
-        mcPartToSimEnergyMap[trackMCItr->second].push_back(&simEnergyDeposit);
-      }
+        evd::TPCDriftTable::TPCInfo_t const* tpc = depositTPCs[depIdx];
 
-      // Would like to draw the deposits as markers with colors given by particle id
-      // So we make two passes, first to fill a map with color the key and positions for the markers
-      std::map<int, std::vector<sim::SimEnergyDeposit::Point_t>> colorToPositionMap;
+        if (!tpc) continue;
+
+        std::size_t const mcPartIdx = trackIndex.Find(simEnergyDeposit.TrackID());
+
+        if (mcPartIdx == evd::TrackIDIndex::NoIndex) continue;
 
-      // Now we loop through and build the mapping of color to positions
-      for (const auto& mcPartToSimEnergy : mcPartToSimEnergyMap) {
         // The first task we need to take on is to find the offset for the
         // energy deposit This is for the case of "out of time" particles...
         // (e.g. cosmic rays)
-        double g4Ticks(clockData.TPCG4Time2Tick(mcPartToSimEnergy.first->T()) -
+        double g4Ticks(clockData.TPCG4Time2Tick((*mcParticleHandle)[mcPartIdx].T()) -
                        trigger_offset(clockData));
-        double xOffset(0.);
-        double xPosMinTick(0.);
-        double xPosMaxTick(std::numeric_limits<double>::max());
-
-        for (const auto& simEnergyDeposit : mcPartToSimEnergy.second) {
-          sim::SimEnergyDeposit::Point_t point = simEnergyDeposit->MidPoint();
-
-          // If we have cosmic rays then we need to get the offset which allows translating from
-          // when they were generated vs when they were tracked.
-          // Note that this also explicitly checks that they are in a TPC volume
-          try {
-            geo::TPCID tpcID = geom->PositionToTPCID(point);
-            geo::PlaneID planeID(tpcID, 0);
-
-            xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-            xPosMaxTick = detProp.ConvertTicksToX(detProp.NumberTimeSamples(), planeID);
-            xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
-
-            if (xPosMaxTick < xPosMinTick) std::swap(xPosMinTick, xPosMaxTick);
-          }
-          catch (...) {
-            continue;
-          }
-
-          colorToPositionMap[evd::Style::ColorFromPDG(simEnergyDeposit->PdgCode())].emplace_back(
-            sim::SimEnergyDeposit::Point_t(point.X() + xOffset, point.Y(), point.Z()));
-        }
+        double xOffset = tpc->TickToX(g4Ticks) - tpc->xAtTick0;
+
+        sim::SimEnergyDeposit::Point_t point = simEnergyDeposit.MidPoint();
+
+        // There are only a handful of colors, so a linear search is fine
+        int const colorIdx = evd::Style::ColorFromPDG(simEnergyDeposit.PdgCode());
+        std::size_t const colorSlot =
+          std::find(colors.begin(), colors.end(), colorIdx) - colors.begin();
+
+        if (colorSlot == colors.size()) colors.push_back(colorIdx);
+
+        depositColors[depIdx] = colorSlot;
+        depositXPos[depIdx] = point.X() + xOffset;
+      }
+
+      evd::PositionBuckets colorPositions(colors.size());
+
+      for (std::size_t colorSlot : depositColors) {
+        if (colorSlot != noColor) colorPositions.Count(colorSlot);
+      }
+
+      colorPositions.Allocate();
+
+      for (size_t depIdx = 0; depIdx < simEnergyDepositHandle->size(); depIdx++) {
+        if (depositColors[depIdx] == noColor) continue;
+
+        sim::SimEnergyDeposit::Point_t point = (*simEnergyDepositHandle)[depIdx].MidPoint();
+
+        colorPositions.Add(depositColors[depIdx], depositXPos[depIdx], point.Y(), point.Z());
       }
 
       // Now we can do some drawing
-      for (const auto& pair : colorToPositionMap) {
-        int colorIdx(pair.first);
+      for (size_t colorSlot = 0; colorSlot < colors.size(); colorSlot++) {
+        int colorIdx(colors[colorSlot]);
         int markerIdx(kFullDotMedium);
         int markerSize(2);
 
         TPolyMarker3D& pm = view->AddPolyMarker3D(1, colorIdx, markerIdx, markerSize);
 
-        // Import positions into an array
-        std::vector<double> posArrayVec;
-        int hitCount(0);
-
-        posArrayVec.resize(3 * pair.second.size());
-
-        for (const auto& point : pair.second) {
-          posArrayVec[3 * hitCount] = point.X();
-          posArrayVec[3 * hitCount + 1] = point.Y();
-          posArrayVec[3 * hitCount + 2] = point.Z();
-          hitCount++;
-        }
-
-        pm.SetPolyMarker(hitCount, posArrayVec.data(), markerIdx);
+        pm.SetPolyMarker(
+          colorPositions.Size(colorSlot), colorPositions.Positions(colorSlot), markerIdx);
       }
     }
 
@@ -202,32 +197,35 @@ namespace evdb_tool {
         art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
       auto const detProp =
         art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
-      art::ServiceHandle<geo::Geometry const> geom;
+      evd::TPCDriftTable const tpcTable(*(art::ServiceHandle<geo::Geometry const>()), detProp);
+      std::vector<evd::TPCDriftTable::TPCInfo_t const*> depositTPCs;
+
+      // If we have cosmic rays then we need to get the offset which allows translating from
+      // when they were generated vs when they were tracked, which depends on the TPC.
+      // Note that this also explicitly checks that they are in a TPC volume
+      tpcTable.Classify(
+        simEnergyDepositHandle->size(),
+        [&deposits = *simEnergyDepositHandle](std::size_t i) { return deposits[i].MidPoint(); },
+        depositTPCs);
 
       // Would like to draw the deposits as markers with colors given by particle id
       // So we make two passes, first to fill a map with color the key and positions for the markers
       std::map<int, std::vector<sim::SimEnergyDeposit::Point_t>> colorToPositionMap;
 
       // Go through the SimEnergyDeposits and populate the map
-      for (const auto& simEnergyDeposit : *simEnergyDepositHandle) {
-        // If we have cosmic rays then we need to get the offset which allows translating from
-        // when they were generated vs when they were tracked.
-        // Note that this also explicitly checks that they are in a TPC volume
-        try {
-          sim::SimEnergyDeposit::Point_t point = simEnergyDeposit.MidPoint();
-          double depTime = simEnergyDeposit.T();
-          geo::TPCID tpcID = geom->PositionToTPCID(point);
-          geo::PlaneID planeID(tpcID, 0);
-          double g4Ticks = clockData.TPCG4Time2Tick(depTime) - trigger_offset(clockData);
-          double xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-          double xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
-
-          colorToPositionMap[evd::Style::ColorFromPDG(simEnergyDeposit.PdgCode())].emplace_back(
-            sim::SimEnergyDeposit::Point_t(point.X() + xOffset, point.Y(), point.Z()));
-        }
-        catch (...) {
-          continue;
-        }
+      for (size_t depIdx = 0; depIdx < simEnergyDepositHandle->size(); depIdx++) {
+        const sim::SimEnergyDeposit& simEnergyDeposit = (*simEnergyDepositHandle)[depIdx];
+        evd::TPCDriftTable::TPCInfo_t const* tpc = depositTPCs[depIdx];
+
+        if (!tpc) continue;
+
+        sim::SimEnergyDeposit::Point_t point = simEnergyDeposit.MidPoint();
+        double depTime = simEnergyDeposit.T();
+        double g4Ticks = clockData.TPCG4Time2Tick(depTime) - trigger_offset(clockData);
+        double xOffset = tpc->TickToX(g4Ticks) - tpc->xAtTick0;
+
+        colorToPositionMap[evd::Style::ColorFromPDG(simEnergyDeposit.PdgCode())].emplace_back(
+          sim::SimEnergyDeposit::Point_t(point.X() + xOffset, point.Y(), point.Z()));
       }
 
       // Now we can do some drawing
@@ -0,0 +1,123 @@
+/**
+ * @file   ParticleBuckets.h
+ * @brief  Flat containers grouping simulated positions by particle or color
+ *
+ * The simulation drawers collect many positions (voxels, energy deposits)
+ * and draw them grouped by the particle which produced them or by color.
+ * Rather than one vector per group (or per position), the positions are
+ * grouped by a counting sort into a single buffer: a first pass counts the
+ * positions in each group, and a second one stores them into place.
+ */
+
+#ifndef EVD_SIMDRAWERS_PARTICLEBUCKETS_H
+#define EVD_SIMDRAWERS_PARTICLEBUCKETS_H
+
+// LArSoft libraries
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::lower_bound(), std::sort()
+#include <cstddef>   // std::size_t
+#include <limits>
+#include <numeric>   // std::partial_sum()
+#include <utility>   // std::pair
+#include <vector>
+
+namespace evd {
+
+  /// Index of the particles in their collection, sorted by track ID
+  class TrackIDIndex {
+  public:
+    /// Value returned by `Find()` for a track ID not in the collection
+    static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+    explicit TrackIDIndex(std::vector<simb::MCParticle> const& particles)
+    {
+      fIndex.reserve(particles.size());
+      for (std::size_t i = 0; i < particles.size(); ++i)
+        fIndex.emplace_back(particles[i].TrackId(), i);
+      std::sort(fIndex.begin(), fIndex.end());
+    }
+
+    /// Returns the index of the particle with `trackID`, or `NoIndex`
+    std::size_t Find(int trackID) const
+    {
+      auto const it = std::lower_bound(
+        fIndex.begin(), fIndex.end(), std::pair<int, std::size_t>(trackID, 0));
+      return ((it == fIndex.end()) || (it->first != trackID)) ? NoIndex : it->second;
+    }
+
+  private:
+    std::vector<std::pair<int, std::size_t>> fIndex; ///< track ID and index
+  }; // class TrackIDIndex
+
+  /**
+   * @brief Positions grouped into buckets, stored in one contiguous buffer
+   *
+   * The buckets are filled in two passes over the same positions:
+   *
+   *     PositionBuckets buckets(nParticles);
+   *     for (auto const& dep : deposits) buckets.Count(particleOf(dep));
+   *     buckets.Allocate();
+   *     for (auto const& dep : deposits) buckets.Add(particleOf(dep), dep.X(), dep.Y(), dep.Z());
+   *
+   * after which the coordinates of each bucket are contiguous, in the
+   * `x, y, z` format expected by `TPolyMarker3D::SetPolyMarker()`.
+   */
+  class PositionBuckets {
+  public:
+    explicit PositionBuckets(std::size_t nBuckets) : fOffsets(nBuckets + 1, 0) {}
+
+    /// Counts `n` more positions in `bucket` (first pass)
+    void Count(std::size_t bucket, std::size_t n = 1) { fOffsets[bucket + 1] += n; }
+
+    /// Sizes the buffer for the counted positions
+    void Allocate()
+    {
+      std::partial_sum(fOffsets.begin(), fOffsets.end(), fOffsets.begin());
+      fNext.assign(fOffsets.begin(), fOffsets.end() - 1);
+      fXYZ.resize(3 * fOffsets.back());
+    }
+
+    /// Stores a position into `bucket` (second pass)
+    void Add(std::size_t bucket, double x, double y, double z)
+    {
+      double* xyz = fXYZ.data() + 3 * fNext[bucket]++;
+      xyz[0] = x;
+      xyz[1] = y;
+      xyz[2] = z;
+    }
+
+    /// Returns the number of buckets
+    std::size_t NBuckets() const { return fOffsets.size() - 1; }
+
+    /// Returns the number of positions in `bucket`
+    std::size_t Size(std::size_t bucket) const
+    {
+      return fOffsets[bucket + 1] - fOffsets[bucket];
+    }
+
+    /// Returns the number of positions in all the buckets (after `Allocate()`)
+    std::size_t NPositions() const { return fOffsets.back(); }
+
+    /// Returns the index of the first position of `bucket` (after `Allocate()`)
+    std::size_t Offset(std::size_t bucket) const { return fOffsets[bucket]; }
+
+    /// Returns the coordinates of the positions in `bucket`
+    double* Positions(std::size_t bucket) { return fXYZ.data() + 3 * fOffsets[bucket]; }
+
+    /// Returns the coordinates of the positions in `bucket`
+    double const* Positions(std::size_t bucket) const
+    {
+      return fXYZ.data() + 3 * fOffsets[bucket];
+    }
+
+  private:
+    std::vector<std::size_t> fOffsets; ///< start of each bucket, and end of the last
+    std::vector<std::size_t> fNext;    ///< next free position of each bucket
+    std::vector<double> fXYZ;          ///< coordinates of all the positions
+  }; // class PositionBuckets
+
+} // namespace evd
+
+#endif // EVD_SIMDRAWERS_PARTICLEBUCKETS_H
@@ -25,7 +25,9 @@
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawer.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/SimulationPayload.h"
 #include "lareventdisplay/EventDisplay/Style.h"
+#include "lareventdisplay/EventDisplay/TPCDriftTable.h"
 #include "larevt/SpaceChargeServices/SpaceChargeService.h"
 #include "larsim/MCCheater/ParticleInventoryService.h"
 #include "larsim/Simulation/LArVoxelData.h"
@@ -49,6 +51,21 @@ namespace {
     mf::LogWarning("SimulationDrawer") << "SimulationDrawer::" << fcn << " failed with message:\n"
                                        << e;
   }
+
+  /// Returns a function extracting the `i`-th point of `traj`
+  auto trajPoint(simb::MCTrajectory const& traj)
+  {
+    return [&traj](std::size_t i) { return geo::Point_t(traj.X(i), traj.Y(i), traj.Z(i)); };
+  }
+
+  /// Returns a function extracting the `i`-th of the voxel `positions`
+  auto voxelPoint(std::vector<std::vector<double>> const& positions)
+  {
+    return [&positions](std::size_t i) {
+      std::vector<double> const& pos = positions[i];
+      return geo::Point_t(pos[0], pos[1], pos[2]);
+    };
+  }
 }
 
 namespace evd {
@@ -336,7 +353,8 @@ namespace evd {
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
-    art::ServiceHandle<geo::Geometry const> geom;
+    TPCDriftTable const tpcTable(*(art::ServiceHandle<geo::Geometry const>()), detProp);
+    std::vector<TPCDriftTable::TPCInfo_t const*> pointTPCs;
 
     // get the particles from the Geant4 step
     std::vector<const simb::MCParticle*> plist;
@@ -389,9 +407,6 @@ namespace evd {
 
         if (!mcTraj.empty() && partEnergy > minPartEnergy && mcPart->TrackId() < 100000000) {
           double g4Ticks(clockData.TPCG4Time2Tick(mcPart->T()) - trigger_offset(clockData));
-          double xOffset = 0.;
-          double xPosMinTick = 0.;
-          double xPosMaxTick = std::numeric_limits<double>::max();
 
           // collect the points from this particle
           int numTrajPoints = mcTraj.size();
@@ -399,35 +414,25 @@ namespace evd {
           std::unique_ptr<double[]> hitPositions(new double[3 * numTrajPoints]);
           int hitCount(0);
 
+          // If we have cosmic rays then we need to get the offset which allows translating from
+          // when they were generated vs when they were tracked, which depends on the TPC.
+          // Note that this also explicitly checks that they are in a TPC volume
+          tpcTable.Classify(numTrajPoints, trajPoint(mcTraj), pointTPCs);
+
           for (int hitIdx = 0; hitIdx < numTrajPoints; hitIdx++) {
+            TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[hitIdx];
+
+            if (!tpc) continue;
+
             double xPos = mcTraj.X(hitIdx);
             double yPos = mcTraj.Y(hitIdx);
             double zPos = mcTraj.Z(hitIdx);
 
-            // If we have cosmic rays then we need to get the offset which allows translating from
-            // when they were generated vs when they were tracked.
-            // Note that this also explicitly checks that they are in a TPC volume
-            geo::Point_t hitLocation(xPos, yPos, zPos);
-
-            try {
-              geo::TPCID tpcID = geom->PositionToTPCID(hitLocation);
-              geo::PlaneID planeID(tpcID, 0);
-
-              xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-              xPosMaxTick = detProp.ConvertTicksToX(detProp.NumberTimeSamples(), planeID);
-              xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
-
-              if (xPosMaxTick < xPosMinTick) std::swap(xPosMinTick, xPosMaxTick);
-            }
-            catch (...) {
-              continue;
-            }
-
             // Now move the hit position to correspond to the timing
-            xPos += xOffset;
+            xPos += tpc->TickToX(g4Ticks) - tpc->xAtTick0;
 
             // Check fiducial limits
-            if (xPos > xPosMinTick && xPos < xPosMaxTick) {
+            if (xPos > tpc->driftMinX && xPos < tpc->driftMaxX) {
               // Check for space charge offsets
               //                        if (spaceCharge->EnableSimEfieldSCE())
               //                        {
@@ -493,9 +498,6 @@ namespace evd {
       if (!mcPart || partToPosMapItr->second.empty()) continue;
 
       double g4Ticks(clockData.TPCG4Time2Tick(mcPart->T()) - trigger_offset(clockData));
-      double xOffset = 0.;
-      double xPosMinTick = 0.;
-      double xPosMaxTick = std::numeric_limits<double>::max();
 
       int colorIdx(evd::Style::ColorFromPDG(mcPart->PdgCode()));
       int markerIdx(kFullDotSmall);
@@ -510,32 +512,21 @@ namespace evd {
       std::unique_ptr<double[]> hitPositions(new double[3 * partToPosMapItr->second.size()]);
       int hitCount(0);
 
+      std::vector<std::vector<double>> const& positions = partToPosMapItr->second;
+      tpcTable.Classify(positions.size(), voxelPoint(positions), pointTPCs);
+
       // Now loop over points and add to trajectory
       for (size_t posIdx = 0; posIdx < partToPosMapItr->second.size(); posIdx++) {
         const std::vector<double>& posVec = partToPosMapItr->second[posIdx];
+        TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[posIdx];
 
-        // Check xOffset state and set if necessary
-        geo::Point_t hitLocation(posVec[0], posVec[1], posVec[2]);
-
-        try {
-          geo::TPCID tpcID = geom->PositionToTPCID(hitLocation);
-          geo::PlaneID planeID(tpcID, 0);
-
-          xPosMinTick = detProp.ConvertTicksToX(0, planeID);
-          xPosMaxTick = detProp.ConvertTicksToX(detProp.NumberTimeSamples(), planeID);
-          xOffset = detProp.ConvertTicksToX(g4Ticks, planeID) - xPosMinTick;
-
-          if (xPosMaxTick < xPosMinTick) std::swap(xPosMinTick, xPosMaxTick);
-        }
-        catch (...) {
-          continue;
-        }
+        if (!tpc) continue;
 
-        double xCoord = posVec[0] + xOffset;
+        double xCoord = posVec[0] + tpc->TickToX(g4Ticks) - tpc->xAtTick0;
 
         // If a voxel records an energy deposit then must have been in the TPC
         // But because things get shifted still need to cut off if outside drift
-        if (xCoord > xPosMinTick && xCoord < xPosMaxTick) {
+        if (xCoord > tpc->driftMinX && xCoord < tpc->driftMaxX) {
           hitPositions[3 * hitCount] = xCoord;
           hitPositions[3 * hitCount + 1] = posVec[1];
           hitPositions[3 * hitCount + 2] = posVec[2];
@@ -606,261 +597,139 @@ namespace evd {
     // If the option is turned off, there's nothing to do
     if (!drawopt->fShowMCTruthTrajectories) return;
 
-    geo::GeometryCore const* geom = lar::providerFrom<geo::Geometry>();
-    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
-
-    // get the particles from the Geant4 step
-    std::vector<const simb::MCParticle*> plist;
-    this->GetParticle(evt, plist);
+    // The particles, their trajectories and the true energy deposition locations (from the
+    // LArVoxelList) are collected once per event and shared by all the views: each view only
+    // applies the drift offset and its projection
+    SimulationPayload& payload = SimulationPayload::Instance();
+    payload.Update(evt);
+    std::vector<simb::MCParticle> const& particles = payload.Particles();
 
     // Useful variables
 
     double xMinimum(-1. * (maxx - minx));
     double xMaximum(2. * (maxx - minx));
 
-    // Use the LArVoxelList to get the true energy deposition locations as
-    // opposed to using MCTrajectories
-    // GetLarVoxelList should be adjusted to take an InputTag instead of strange.
-    const sim::LArVoxelList voxels =
-      sim::SimListUtils::GetLArVoxelList(evt, drawopt->fSimChannelLabel.encode());
-
     mf::LogDebug("SimulationDrawer")
-      << "Starting loop over " << plist.size() << " McParticles, voxel list size is "
-      << voxels.size() << std::endl;
+      << "Starting loop over " << particles.size() << " McParticles, with "
+      << payload.NDeposits() << " energy deposits" << std::endl;
 
-    // Using the voxel information can be slow (see previous implementation of this code).
-    // In order to speed things up we have modified the strategy:
-    // 1) Make one pass through the list of voxels
-    // 2) For each voxel, keep track of the MCParticle contributing energy to it and it's position
-    //    which is done by keeping a map between the MCParticle and a vector of positions
-    // 3) Then loop through the map to draw the particle trajectories.
-    // One caveat is the need for MCParticles... and the voxels contain the track ids. So we'll need one
-    // more loop to make a map of track id's and MCParticles.
+    // The following is meant to get the correct offset for drawing the particle trajectory.
+    // In particular, the cosmic rays will not be correctly placed without this.
+    // Returns whether the shifted position is in the readout window and within fiducial limits.
+    auto const shiftToTime =
+      [xMinimum, xMaximum](SimulationPayload::TPCInfo_t const* tpc, double g4Ticks, double& xPos) {
+        xPos += tpc->TickToX(g4Ticks + tpc->xTicksOffset);
 
-    // First up is to build the map between track id's and associated MCParticles so we can recover when looping over voxels
-    std::map<int, const simb::MCParticle*> trackToMcParticleMap;
+        bool inreadoutwindow = false;
+        if (tpc->xTicksCoefficient < 0) {
+          if ((xPos > tpc->readOutWindowX) && (xPos < tpc->max.X())) inreadoutwindow = true;
+        }
+        else if (tpc->xTicksCoefficient > 0) {
+          if ((xPos > tpc->min.X()) && (xPos < tpc->readOutWindowX)) inreadoutwindow = true;
+        }
+
+        return inreadoutwindow && (xPos > xMinimum) && (xPos < xMaximum);
+      };
 
     // Should we display the trajectories too?
     bool displayMcTrajectories(true);
     double minPartEnergy(0.025);
 
-    double tpcminx = 1.0;
-    double tpcmaxx = -1.0;
-    double xOffset = 0.0;
-    double g4Ticks = 0.0;
-    double coeff = 0.0;
-    double readoutwindowsize = 0.0;
-    for (size_t p = 0; p < plist.size(); ++p) {
-      trackToMcParticleMap[plist[p]->TrackId()] = plist[p];
-
+    for (size_t p = 0; p < particles.size(); ++p) {
       // Quick loop through to drawn trajectories...
-      if (displayMcTrajectories) {
-        // Is there an associated McTrajectory?
-        const simb::MCParticle* mcPart = plist[p];
-        const simb::MCTrajectory& mcTraj = mcPart->Trajectory();
+      if (!displayMcTrajectories) break;
 
-        int pdgCode(mcPart->PdgCode());
-        TParticlePDG* partPDG(TDatabasePDG::Instance()->GetParticle(pdgCode));
-        double partCharge = partPDG ? partPDG->Charge() : 0.;
-        double partEnergy = mcPart->E();
+      const simb::MCParticle* mcPart = &particles[p];
 
-        if (!mcTraj.empty() && partEnergy > minPartEnergy && mcPart->TrackId() < 100000000) {
-          // collect the points from this particle
-          int numTrajPoints = mcTraj.size();
+      int pdgCode(mcPart->PdgCode());
+      TParticlePDG* partPDG(TDatabasePDG::Instance()->GetParticle(pdgCode));
+      double partCharge = partPDG ? partPDG->Charge() : 0.;
+      double partEnergy = mcPart->E();
 
-          std::unique_ptr<double[]> hitPosX(new double[numTrajPoints]);
-          std::unique_ptr<double[]> hitPosY(new double[numTrajPoints]);
-          std::unique_ptr<double[]> hitPosZ(new double[numTrajPoints]);
-          int hitCount(0);
+      // collect the points from this particle
+      int numTrajPoints = payload.NTrajectoryPoints(p);
 
-          double xPos = mcTraj.X(0);
-          double yPos = mcTraj.Y(0);
-          double zPos = mcTraj.Z(0);
+      if (numTrajPoints == 0 || partEnergy <= minPartEnergy || mcPart->TrackId() >= 100000000)
+        continue;
 
-          tpcminx = 1.0;
-          tpcmaxx = -1.0;
-          xOffset = 0.0;
-          g4Ticks = 0.0;
-          coeff = 0.0;
-          readoutwindowsize = 0.0;
-          for (int hitIdx = 0; hitIdx < numTrajPoints; hitIdx++) {
-            xPos = mcTraj.X(hitIdx);
-            yPos = mcTraj.Y(hitIdx);
-            zPos = mcTraj.Z(hitIdx);
-
-            // If the original simulated hit did not occur in the TPC volume then don't draw it
-            if (xPos < minx || xPos > maxx || yPos < miny || yPos > maxy || zPos < minz ||
-                zPos > maxz)
-              continue;
-
-            if ((xPos < tpcminx) || (xPos > tpcmaxx)) {
-              geo::Point_t const vtx{xPos, yPos, zPos};
-              geo::TPCID tpcid = geom->FindTPCAtPosition(vtx);
-              unsigned int cryo = geom->PositionToCryostatID(vtx).Cryostat;
-
-              if (tpcid.isValid) {
-                unsigned int tpc = tpcid.TPC;
-                const geo::TPCGeo& tpcgeo = geom->GetElement(tpcid);
-                tpcminx = tpcgeo.MinX();
-                tpcmaxx = tpcgeo.MaxX();
-
-                coeff = detProp.GetXTicksCoefficient(tpc, cryo);
-                readoutwindowsize =
-                  detProp.ConvertTicksToX(detProp.ReadOutWindowSize(), 0, tpc, cryo);
-
-                // The following is meant to get the correct offset for drawing
-                // the particle trajectory In particular, the cosmic rays will
-                // not be correctly placed without this
-                g4Ticks = clockData.TPCG4Time2Tick(mcPart->T()) +
-                          detProp.GetXTicksOffset(0, tpc, cryo) - trigger_offset(clockData);
-
-                xOffset = detProp.ConvertTicksToX(g4Ticks, 0, tpc, cryo);
-              }
-              else {
-                xOffset = 0;
-                tpcminx = 1.0;
-                tpcmaxx = -1.0;
-                coeff = 0.0;
-                readoutwindowsize = 0.0;
-              }
-            }
+      std::unique_ptr<double[]> hitPosX(new double[numTrajPoints]);
+      std::unique_ptr<double[]> hitPosY(new double[numTrajPoints]);
+      std::unique_ptr<double[]> hitPosZ(new double[numTrajPoints]);
+      int hitCount(0);
 
-            // Now move the hit position to correspond to the timing
-            xPos += xOffset;
+      double const g4Ticks = payload.G4Ticks(p);
+      double const* trajPoints = payload.TrajectoryPoints(p);
+      SimulationPayload::TPCInfo_t const* const* pointTPCs = payload.TrajectoryTPCs(p);
 
-            bool inreadoutwindow = false;
-            if (coeff < 0) {
-              if ((xPos > readoutwindowsize) && (xPos < tpcmaxx)) inreadoutwindow = true;
-            }
-            else if (coeff > 0) {
-              if ((xPos > tpcminx) && (xPos < readoutwindowsize)) inreadoutwindow = true;
-            }
+      for (int hitIdx = 0; hitIdx < numTrajPoints; hitIdx++) {
+        double xPos = trajPoints[3 * hitIdx];
+        double yPos = trajPoints[3 * hitIdx + 1];
+        double zPos = trajPoints[3 * hitIdx + 2];
 
-            if (!inreadoutwindow) continue;
+        // If the original simulated hit did not occur in the TPC volume then don't draw it
+        if (xPos < minx || xPos > maxx || yPos < miny || yPos > maxy || zPos < minz ||
+            zPos > maxz)
+          continue;
 
-            // Check fiducial limits
-            if (xPos > xMinimum && xPos < xMaximum) {
-              hitPosX[hitCount] = xPos;
-              hitPosY[hitCount] = yPos;
-              hitPosZ[hitCount] = zPos;
-              hitCount++;
-            }
-          }
+        TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[hitIdx];
 
-          TPolyLine& pl = view->AddPolyLine(
-            1, evd::Style::ColorFromPDG(mcPart->PdgCode()), 1, 1); //kFullCircle, msize);
+        if (!tpc) continue;
 
-          // Draw neutrals as a gray dotted line to help fade into background a bit...
-          if (partCharge == 0.) {
-            pl.SetLineColor(13);
-            pl.SetLineStyle(3);
-            pl.SetLineWidth(1);
-          }
+        // Now move the hit position to correspond to the timing
+        if (!shiftToTime(tpc, g4Ticks, xPos)) continue;
 
-          if (proj == evd::kXY)
-            pl.SetPolyLine(hitCount, hitPosX.get(), hitPosY.get(), "");
-          else if (proj == evd::kXZ)
-            pl.SetPolyLine(hitCount, hitPosZ.get(), hitPosX.get(), "");
-          else if (proj == evd::kYZ)
-            pl.SetPolyLine(hitCount, hitPosZ.get(), hitPosY.get(), "");
-        }
+        hitPosX[hitCount] = xPos;
+        hitPosY[hitCount] = yPos;
+        hitPosZ[hitCount] = zPos;
+        hitCount++;
       }
-    }
-
-    // Now we set up and build the map between MCParticles and a vector of positions obtained from the voxels
-    std::map<const simb::MCParticle*, std::vector<std::vector<double>>> partToPosMap;
 
-    sim::LArVoxelList::const_iterator vxitr;
-    for (vxitr = voxels.begin(); vxitr != voxels.end(); vxitr++) {
-      const sim::LArVoxelData& vxd = (*vxitr).second;
+      TPolyLine& pl = view->AddPolyLine(
+        1, evd::Style::ColorFromPDG(mcPart->PdgCode()), 1, 1); //kFullCircle, msize);
 
-      for (size_t partIdx = 0; partIdx < vxd.NumberParticles(); partIdx++) {
-        if (vxd.Energy(partIdx) > drawopt->fMinEnergyDeposition) {
-          int trackId = vxd.TrackID(partIdx);
-
-          // It can be in some instances that mcPart here could be zero.
-          const simb::MCParticle* mcPart = trackToMcParticleMap[trackId];
+      // Draw neutrals as a gray dotted line to help fade into background a bit...
+      if (partCharge == 0.) {
+        pl.SetLineColor(13);
+        pl.SetLineStyle(3);
+        pl.SetLineWidth(1);
+      }
 
-          partToPosMap[mcPart].push_back(std::vector<double>(3));
+      if (proj == evd::kXY)
+        pl.SetPolyLine(hitCount, hitPosX.get(), hitPosY.get(), "");
+      else if (proj == evd::kXZ)
+        pl.SetPolyLine(hitCount, hitPosZ.get(), hitPosX.get(), "");
+      else if (proj == evd::kYZ)
+        pl.SetPolyLine(hitCount, hitPosZ.get(), hitPosY.get(), "");
+    }
 
-          partToPosMap[mcPart].back()[0] = vxd.VoxelID().X();
-          partToPosMap[mcPart].back()[1] = vxd.VoxelID().Y();
-          partToPosMap[mcPart].back()[2] = vxd.VoxelID().Z();
-        }
-      } // end if this track id is in the current voxel
-    }   // end loop over voxels
+    // Finally ready for the main event! Simply loop through the MCParticles and the positions
+    // of their energy deposits to draw the trajectories
+    std::vector<std::array<double, 3>> posVecCorr;
 
-    // Finally ready for the main event! Simply loop through the map between MCParticle and positions to
-    // draw the trajectories
-    std::map<const simb::MCParticle*, std::vector<std::vector<double>>>::iterator partToPosMapItr;
+    for (size_t p = 0; p < particles.size(); ++p) {
+      // Maybe no points to plot
+      size_t const numPositions = payload.NDeposits(p);
+      if (numPositions == 0) continue;
 
-    for (partToPosMapItr = partToPosMap.begin(); partToPosMapItr != partToPosMap.end();
-         partToPosMapItr++) {
       // Recover the McParticle, we'll need to access several data members so may as well dereference it
-      const simb::MCParticle* mcPart = partToPosMapItr->first;
+      const simb::MCParticle* mcPart = &particles[p];
 
-      // Apparently, it can happen that we get a null pointer here or maybe no points to plot
-      if (!mcPart || partToPosMapItr->second.empty()) continue;
+      posVecCorr.clear();
 
-      tpcminx = 1.0;
-      tpcmaxx = -1.0;
-      xOffset = 0.0;
-      g4Ticks = 0.0;
-      std::vector<std::array<double, 3>> posVecCorr;
-      posVecCorr.reserve(partToPosMapItr->second.size());
-      coeff = 0.0;
-      readoutwindowsize = 0.0;
+      double const g4Ticks = payload.G4Ticks(p);
+      double const* positions = payload.Deposits(p);
+      SimulationPayload::TPCInfo_t const* const* pointTPCs = payload.DepositTPCs(p);
 
       // Now loop over points and add to trajectory
-      for (size_t posIdx = 0; posIdx < partToPosMapItr->second.size(); posIdx++) {
-        const std::vector<double>& posVec = partToPosMapItr->second[posIdx];
-
-        if ((posVec[0] < tpcminx) || (posVec[0] > tpcmaxx)) {
-          geo::Point_t const vtx{posVec[0], posVec[1], posVec[2]};
-          geo::TPCID tpcid = geom->FindTPCAtPosition(vtx);
-          unsigned int cryo = geom->PositionToCryostatID(vtx).Cryostat;
-
-          if (tpcid.isValid) {
-            unsigned int tpc = tpcid.TPC;
-
-            const geo::TPCGeo& tpcgeo = geom->GetElement(tpcid);
-            tpcminx = tpcgeo.MinX();
-            tpcmaxx = tpcgeo.MaxX();
+      for (size_t posIdx = 0; posIdx < numPositions; posIdx++) {
+        const double* posVec = positions + 3 * posIdx;
+        TPCDriftTable::TPCInfo_t const* tpc = pointTPCs[posIdx];
 
-            coeff = detProp.GetXTicksCoefficient(tpc, cryo);
-            readoutwindowsize = detProp.ConvertTicksToX(detProp.ReadOutWindowSize(), 0, tpc, cryo);
-            // The following is meant to get the correct offset for drawing the
-            // particle trajectory In particular, the cosmic rays will not be
-            // correctly placed without this
-            g4Ticks = clockData.TPCG4Time2Tick(mcPart->T()) +
-                      detProp.GetXTicksOffset(0, tpc, cryo) - trigger_offset(clockData);
+        if (!tpc) continue;
 
-            xOffset = detProp.ConvertTicksToX(g4Ticks, 0, tpc, cryo);
-          }
-          else {
-            xOffset = 0;
-            tpcminx = 1.0;
-            tpcmaxx = -1.0;
-            coeff = 0.0;
-            readoutwindowsize = 0.0;
-          }
-        }
-
-        double xCoord = posVec[0] + xOffset;
-
-        bool inreadoutwindow = false;
-        if (coeff < 0) {
-          if ((xCoord > readoutwindowsize) && (xCoord < tpcmaxx)) inreadoutwindow = true;
-        }
-        else if (coeff > 0) {
-          if ((xCoord > tpcminx) && (xCoord < readoutwindowsize)) inreadoutwindow = true;
-        }
-
-        if (inreadoutwindow && (xCoord > xMinimum && xCoord < xMaximum)) {
+        double xCoord = posVec[0];
+        if (shiftToTime(tpc, g4Ticks, xCoord))
           posVecCorr.push_back({{xCoord, posVec[1], posVec[2]}});
-        }
       }
 
       TPolyMarker& pm = view->AddPolyMarker(posVecCorr.size(),
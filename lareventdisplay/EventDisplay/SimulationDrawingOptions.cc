@@ -6,6 +6,9 @@
 /// LArSoft includes
 #include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
 
+#include <functional> // std::hash
+#include <string>
+
 namespace evd {
 
   //......................................................................
@@ -18,6 +21,7 @@ namespace evd {
   //......................................................................
   void SimulationDrawingOptions::reconfigure(fhicl::ParameterSet const& pset)
   {
+    fConfigHash = std::hash<std::string>{}(pset.id().to_string());
     fShowMCTruthText = pset.get<bool>("ShowMCTruthText", true);
     try {
       fShowMCTruthVectors = pset.get<unsigned short>("ShowMCTruthVectors", 0);
@@ -7,6 +7,7 @@
 #ifndef SIMULATIONDRAWINGOPTIONS_H
 #define SIMULATIONDRAWINGOPTIONS_H
 #ifndef __CINT__
+#include <cstddef> // std::size_t
 #include <string>
 #include <vector>
 
@@ -40,6 +41,8 @@ namespace evd {
     art::InputTag fSimPhotonLabel;  ///< and for SimPhotons
 
     fhicl::ParameterSet f3DDrawerParams; ///< FHICL paramegers for the 3D drawers
+
+    std::size_t fConfigHash; ///< hash of the configuration last applied by `reconfigure()`
   };
 
 } //namespace
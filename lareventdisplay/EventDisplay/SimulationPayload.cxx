@@ -0,0 +1,169 @@
+/**
+ * @file   SimulationPayload.cxx
+ * @brief  Per-event cache of the simulated positions drawn by the simulation drawers
+ * @see    SimulationPayload.h
+ */
+
+#include "lareventdisplay/EventDisplay/SimulationPayload.h"
+
+// LArSoft libraries
+#include "larcore/CoreUtils/ServiceUtil.h"
+#include "larcore/Geometry/Geometry.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
+#include "larsim/Simulation/LArVoxelData.h"
+#include "larsim/Simulation/LArVoxelList.h"
+#include "larsim/Simulation/SimListUtils.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace {
+
+  /// Assigns each of the positions in `buckets` to its TPC
+  void ClassifyPositions(evd::TPCDriftTable const& tpcTable,
+                         evd::PositionBuckets const& buckets,
+                         std::vector<evd::TPCDriftTable::TPCInfo_t const*>& tpcs)
+  {
+    double const* xyz = buckets.Positions(0);
+    tpcTable.Classify(
+      buckets.NPositions(),
+      [xyz](std::size_t i) { return geo::Point_t(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]); },
+      tpcs);
+  } // ClassifyPositions()
+
+} // local namespace
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  SimulationPayload& SimulationPayload::Instance()
+  {
+    static SimulationPayload payload;
+    return payload;
+  } // SimulationPayload::Instance()
+
+  //----------------------------------------------------------------------------
+  std::vector<simb::MCParticle> const& SimulationPayload::Particles() const
+  {
+    static std::vector<simb::MCParticle> const NoParticles;
+    return fParticles ? *fParticles : NoParticles;
+  } // SimulationPayload::Particles()
+
+  //----------------------------------------------------------------------------
+  void SimulationPayload::Clear()
+  {
+    fEvent.clear();
+    fConfigHash = 0;
+    fParticles = nullptr;
+    fTPCs.reset();
+    fG4Ticks.clear();
+    fTrajectories = PositionBuckets(0);
+    fTrajectoryTPCs.clear();
+    fDeposits = PositionBuckets(0);
+    fDepositTPCs.clear();
+  } // SimulationPayload::Clear()
+
+  //----------------------------------------------------------------------------
+  void SimulationPayload::Update(art::Event const& evt)
+  {
+    art::ServiceHandle<evd::SimulationDrawingOptions const> drawopt;
+
+    // the event may have been read anew, with the particles at a new address
+    auto const particles = evt.getHandle<std::vector<simb::MCParticle>>(drawopt->fG4ModuleLabel);
+    std::vector<simb::MCParticle> const* product =
+      particles.isValid() ? particles.product() : nullptr;
+
+    bool const newEvent = fEvent.update(util::EventChangeTracker_t(evt));
+    if (!newEvent && (fConfigHash == drawopt->fConfigHash) && (fParticles == product)) return;
+
+    fConfigHash = drawopt->fConfigHash;
+    fParticles = product;
+    Fill(evt);
+  } // SimulationPayload::Update()
+
+  //----------------------------------------------------------------------------
+  void SimulationPayload::Fill(art::Event const& evt)
+  {
+    art::ServiceHandle<evd::SimulationDrawingOptions const> drawopt;
+    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
+    fTPCs.emplace(*lar::providerFrom<geo::Geometry>(), detProp);
+
+    std::vector<simb::MCParticle> const& particles = Particles();
+    std::size_t const nParticles = particles.size();
+
+    // the time of each particle, which the drift correction is based on,
+    // and the points of the trajectories, grouped by particle in one buffer
+    fG4Ticks.clear();
+    fG4Ticks.reserve(nParticles);
+    fTrajectories = PositionBuckets(nParticles);
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+      simb::MCParticle const& mcPart = particles[iPart];
+      fG4Ticks.push_back(clockData.TPCG4Time2Tick(mcPart.T()) - trigger_offset(clockData));
+      fTrajectories.Count(iPart, mcPart.NumberTrajectoryPoints());
+    }
+    fTrajectories.Allocate();
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+      simb::MCTrajectory const& mcTraj = particles[iPart].Trajectory();
+      for (std::size_t iPoint = 0; iPoint < mcTraj.size(); ++iPoint)
+        fTrajectories.Add(iPart, mcTraj.X(iPoint), mcTraj.Y(iPoint), mcTraj.Z(iPoint));
+    }
+    ClassifyPositions(*fTPCs, fTrajectories, fTrajectoryTPCs);
+
+    // the energy deposits are the voxels each particle contributed to;
+    // the particle index of each contribution is kept from the counting pass,
+    // so that the track ID is looked up once
+    fDeposits = PositionBuckets(nParticles);
+    std::size_t nVoxels = 0;
+    if (nParticles > 0) {
+      sim::LArVoxelList const voxels =
+        sim::SimListUtils::GetLArVoxelList(evt, drawopt->fSimChannelLabel.encode());
+      nVoxels = voxels.size();
+
+      TrackIDIndex const trackIndex(particles);
+      std::vector<std::size_t> contribParticles;
+      for (auto const& voxel : voxels) {
+        sim::LArVoxelData const& vxd = voxel.second;
+        for (std::size_t partIdx = 0; partIdx < vxd.NumberParticles(); ++partIdx) {
+          if (vxd.Energy(partIdx) <= drawopt->fMinEnergyDeposition) continue;
+
+          // it can be in some instances that there is no MCParticle with this track id
+          std::size_t const mcPartIdx = trackIndex.Find(vxd.TrackID(partIdx));
+          contribParticles.push_back(mcPartIdx);
+          if (mcPartIdx != TrackIDIndex::NoIndex) fDeposits.Count(mcPartIdx);
+        }
+      }
+
+      fDeposits.Allocate();
+
+      auto contribParticle = contribParticles.cbegin();
+      for (auto const& voxel : voxels) {
+        sim::LArVoxelData const& vxd = voxel.second;
+        for (std::size_t partIdx = 0; partIdx < vxd.NumberParticles(); ++partIdx) {
+          if (vxd.Energy(partIdx) <= drawopt->fMinEnergyDeposition) continue;
+
+          std::size_t const mcPartIdx = *(contribParticle++);
+          if (mcPartIdx == TrackIDIndex::NoIndex) continue;
+
+          fDeposits.Add(mcPartIdx, vxd.VoxelID().X(), vxd.VoxelID().Y(), vxd.VoxelID().Z());
+        }
+      }
+    }
+    else {
+      fDeposits.Allocate();
+    }
+    ClassifyPositions(*fTPCs, fDeposits, fDepositTPCs);
+
+    MF_LOG_DEBUG("SimulationPayload")
+      << "Simulation payload for " << fEvent << ": " << nParticles << " particles with "
+      << fTrajectories.NPositions() << " trajectory points, " << NDeposits()
+      << " energy deposits from " << nVoxels << " voxels";
+  } // SimulationPayload::Fill()
+
+} // namespace evd
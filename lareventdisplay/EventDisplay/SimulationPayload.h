@@ -0,0 +1,133 @@
+/**
+ * @file   SimulationPayload.h
+ * @brief  Per-event cache of the simulated positions drawn by the simulation drawers
+ * @see    SimulationPayload.cxx
+ *
+ * `SimulationDrawer::MCTruthOrtho()` is called by each `Ortho3DPad`, and the
+ * `DrawLArVoxel3D` tool by `Display3DPad`. Each of those calls read the voxel
+ * list from the `sim::SimChannel` data, grouped the voxels by particle and
+ * found the TPC of each trajectory point and voxel. `SimulationPayload` does
+ * all that once per event, and the drawers only apply their drift correction
+ * and projection.
+ */
+
+#ifndef EVD_SIMULATIONPAYLOAD_H
+#define EVD_SIMULATIONPAYLOAD_H
+
+// LArSoft libraries
+#include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::EventChangeTracker_t
+#include "lareventdisplay/EventDisplay/SimDrawers/ParticleBuckets.h"
+#include "lareventdisplay/EventDisplay/TPCDriftTable.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+// framework libraries
+#include "art/Framework/Principal/fwd.h"
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <optional>
+#include <vector>
+
+namespace evd {
+
+  /**
+   * @brief Simulated trajectories and energy deposits of the current event
+   *
+   * For each `simb::MCParticle` of the `G4ModuleLabel` data product, the
+   * payload holds:
+   * * the time of the particle in TPC ticks (`G4Ticks()`), from which the
+   *   drawers compute the drift correction;
+   * * the points of its trajectory;
+   * * the positions of the voxels where it deposited more than
+   *   `MinimumEnergyDeposition`, from the `SimChannelLabel` data product.
+   *
+   * The positions are in flat `x, y, z` arrays, one per particle, each with
+   * the TPC of its points (`nullptr` for the points outside all TPCs).
+   * The payload is rebuilt when the event or the simulation drawing options
+   * change.
+   *
+   * Example:
+   *
+   *     evd::SimulationPayload& payload = evd::SimulationPayload::Instance();
+   *     payload.Update(evt);
+   *     for (std::size_t i = 0; i < payload.Particles().size(); ++i) {
+   *       double const* xyz = payload.Deposits(i);
+   *       evd::SimulationPayload::TPCInfo_t const* const* tpcs = payload.DepositTPCs(i);
+   *       for (std::size_t iPos = 0; iPos < payload.NDeposits(i); ++iPos, xyz += 3) {
+   *         // ...
+   *       }
+   *     }
+   *
+   * The cache is meant to be used by the drawers in the main thread only.
+   */
+  class SimulationPayload {
+  public:
+    using TPCInfo_t = TPCDriftTable::TPCInfo_t;
+
+    /// Makes the payload describe `evt`, rebuilding it if needed
+    void Update(art::Event const& evt);
+
+    /// Returns the simulated particles (empty if not available)
+    std::vector<simb::MCParticle> const& Particles() const;
+
+    /// Returns the time of the particle in TPC ticks, including the trigger offset
+    double G4Ticks(std::size_t iPart) const { return fG4Ticks[iPart]; }
+
+    /// Returns the number of trajectory points of the particle
+    std::size_t NTrajectoryPoints(std::size_t iPart) const { return fTrajectories.Size(iPart); }
+
+    /// Returns the coordinates of the trajectory points of the particle
+    double const* TrajectoryPoints(std::size_t iPart) const
+    {
+      return fTrajectories.Positions(iPart);
+    }
+
+    /// Returns the TPC of each trajectory point of the particle
+    TPCInfo_t const* const* TrajectoryTPCs(std::size_t iPart) const
+    {
+      return fTrajectoryTPCs.data() + fTrajectories.Offset(iPart);
+    }
+
+    /// Returns the number of energy deposits of the particle
+    std::size_t NDeposits(std::size_t iPart) const { return fDeposits.Size(iPart); }
+
+    /// Returns the total number of energy deposits of all the particles
+    std::size_t NDeposits() const { return fDeposits.NPositions(); }
+
+    /// Returns the coordinates of the energy deposits of the particle
+    double const* Deposits(std::size_t iPart) const { return fDeposits.Positions(iPart); }
+
+    /// Returns the TPC of each energy deposit of the particle
+    TPCInfo_t const* const* DepositTPCs(std::size_t iPart) const
+    {
+      return fDepositTPCs.data() + fDeposits.Offset(iPart);
+    }
+
+    /// Removes all the content
+    void Clear();
+
+    /// Returns the instance shared by all drawers
+    static SimulationPayload& Instance();
+
+  private:
+    util::EventChangeTracker_t fEvent;                         ///< event of the payload
+    std::size_t fConfigHash = 0;                               ///< simulation options used
+    std::vector<simb::MCParticle> const* fParticles = nullptr; ///< particles of the event
+
+    std::optional<TPCDriftTable> fTPCs; ///< TPC boundaries and drift of the event
+
+    std::vector<double> fG4Ticks; ///< time of each particle [ticks]
+
+    PositionBuckets fTrajectories{0};              ///< trajectory points, by particle
+    std::vector<TPCInfo_t const*> fTrajectoryTPCs; ///< TPC of each trajectory point
+    PositionBuckets fDeposits{0};                  ///< energy deposits, by particle
+    std::vector<TPCInfo_t const*> fDepositTPCs;    ///< TPC of each energy deposit
+
+    /// Fills the payload from `evt`
+    void Fill(art::Event const& evt);
+
+  }; // class SimulationPayload
+
+} // namespace evd
+
+#endif // EVD_SIMULATIONPAYLOAD_H
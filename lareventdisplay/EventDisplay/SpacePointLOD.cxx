@@ -0,0 +1,172 @@
+/**
+ * @file   SpacePointLOD.cxx
+ * @brief  Level-of-detail reduction of the space points in the 3D display
+ * @see    SpacePointLOD.h
+ */
+
+#include "lareventdisplay/EventDisplay/SpacePointLOD.h"
+
+// LArSoft libraries
+#include "lardataobj/RecoBase/SpacePoint.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::clamp()
+#include <cmath>     // std::isnan(), std::log2(), std::floor()
+
+namespace {
+
+  /// Bits of the fine cell index on each axis
+  constexpr unsigned int kCellBits = 21;
+
+  /// Largest fine cell index on each axis
+  constexpr std::int64_t kMaxCellIndex = (std::int64_t(1) << kCellBits) - 1;
+
+  /// Spreads the lowest 21 bits of `v` so that they are 3 bits apart
+  std::uint64_t SpreadBits(std::uint64_t v)
+  {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffff;
+    v = (v | (v << 16)) & 0x1f0000ff0000ff;
+    v = (v | (v << 8)) & 0x100f00f00f00f00f;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+    v = (v | (v << 2)) & 0x1249249249249249;
+    return v;
+  } // SpreadBits()
+
+} // local namespace
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  SpacePointLOD& SpacePointLOD::Instance()
+  {
+    static SpacePointLOD lod;
+    return lod;
+  } // SpacePointLOD::Instance()
+
+  //----------------------------------------------------------------------------
+  void SpacePointLOD::Clear()
+  {
+    fOrders.clear();
+    fUncachedOrder.clear();
+    fEvent.clear();
+  } // SpacePointLOD::Clear()
+
+  //----------------------------------------------------------------------------
+  void SpacePointLOD::Update(art::Event const& evt, double cellSize, unsigned int maxPerCell)
+  {
+    fCellSize = cellSize;
+    fMaxPerCell = std::max(maxPerCell, 1U);
+    if (!fEvent.update(util::EventChangeTracker_t(evt))) return;
+    MF_LOG_DEBUG("SpacePointLOD")
+      << "Dropping " << fOrders.size() << " space point orderings for " << fEvent;
+    fOrders.clear();
+  } // SpacePointLOD::Update()
+
+  //----------------------------------------------------------------------------
+  std::vector<SpacePointLOD::Point_t> SpacePointLOD::Decimate(
+    std::vector<art::Ptr<recob::SpacePoint>> const& spts,
+    std::vector<float> const& values)
+  {
+    std::vector<Point_t> points;
+    if (spts.empty()) return points;
+
+    auto const asPoint = [&spts, &values](std::size_t i) {
+      double const* xyz = spts[i]->XYZ();
+      return Point_t{float(xyz[0]), float(xyz[1]), float(xyz[2]), values[i], 1U};
+    };
+
+    if (fCellSize <= 0.) {
+      points.reserve(spts.size());
+      for (std::size_t i = 0; i < spts.size(); ++i) {
+        if (!std::isnan(values[i])) points.push_back(asPoint(i));
+      }
+      return points;
+    }
+
+    // cells are 2^level fine cells wide, and share the code bits above 3 level
+    int const level = int(std::floor(std::log2(fCellSize / kFineCellSize)));
+    unsigned int const shift = 3 * unsigned(std::clamp(level, 0, int(kCellBits)));
+
+    std::vector<CodedPoint_t> const& order = Order(spts);
+    auto cellBegin = order.begin();
+    while (cellBegin != order.end()) {
+      std::uint64_t const cell = cellBegin->first >> shift;
+      auto cellEnd = cellBegin;
+      Point_t merged{0.f, 0.f, 0.f, 0.f, 0U};
+      double x = 0., y = 0., z = 0., value = 0.;
+      for (; (cellEnd != order.end()) && ((cellEnd->first >> shift) == cell); ++cellEnd) {
+        std::size_t const i = cellEnd->second;
+        if (std::isnan(values[i])) continue;
+        double const* xyz = spts[i]->XYZ();
+        x += xyz[0];
+        y += xyz[1];
+        z += xyz[2];
+        value += values[i];
+        ++merged.n;
+      }
+
+      if (merged.n > fMaxPerCell) {
+        merged.x = float(x / merged.n);
+        merged.y = float(y / merged.n);
+        merged.z = float(z / merged.n);
+        merged.value = float(value / merged.n);
+        points.push_back(merged);
+      }
+      else {
+        for (auto it = cellBegin; it != cellEnd; ++it) {
+          if (!std::isnan(values[it->second])) points.push_back(asPoint(it->second));
+        }
+      }
+      cellBegin = cellEnd;
+    }
+
+    MF_LOG_DEBUG("SpacePointLOD") << spts.size() << " space points drawn as " << points.size()
+                                  << " in cells of " << fCellSize << " cm";
+    return points;
+  } // SpacePointLOD::Decimate()
+
+  //----------------------------------------------------------------------------
+  std::vector<SpacePointLOD::CodedPoint_t> const& SpacePointLOD::Order(
+    std::vector<art::Ptr<recob::SpacePoint>> const& spts)
+  {
+    // only a contiguous range of keys of one product is identified by its ends;
+    // any other selection (e.g. from associations) is sorted every time
+    art::ProductID const id = spts.front().id();
+    std::size_t const firstKey = spts.front().key();
+    bool contiguous = true;
+    for (std::size_t i = 1; contiguous && (i < spts.size()); ++i)
+      contiguous = (spts[i].id() == id) && (spts[i].key() == firstKey + i);
+
+    std::vector<CodedPoint_t>* pOrder = &fUncachedOrder;
+    if (contiguous) {
+      pOrder = &(fOrders[Key_t{id, firstKey, spts.back().key(), spts.size()}]);
+      if (!pOrder->empty()) return *pOrder;
+    }
+
+    std::vector<CodedPoint_t>& order = *pOrder;
+    order.clear();
+    order.reserve(spts.size());
+    for (std::size_t i = 0; i < spts.size(); ++i)
+      order.emplace_back(CellCode(spts[i]->XYZ()), i);
+    std::sort(order.begin(), order.end());
+    return order;
+  } // SpacePointLOD::Order()
+
+  //----------------------------------------------------------------------------
+  std::uint64_t SpacePointLOD::CellCode(double const* xyz)
+  {
+    // the fine grid is centred on the origin of the detector coordinates
+    auto const index = [](double coord) {
+      auto const i = std::int64_t(std::floor(coord / kFineCellSize + 0.5 * (kMaxCellIndex + 1)));
+      return std::uint64_t(std::clamp<std::int64_t>(i, 0, kMaxCellIndex));
+    };
+    return SpreadBits(index(xyz[0])) | (SpreadBits(index(xyz[1])) << 1) |
+           (SpreadBits(index(xyz[2])) << 2);
+  } // SpacePointLOD::CellCode()
+
+} // namespace evd
@@ -0,0 +1,131 @@
+/**
+ * @file   SpacePointLOD.h
+ * @brief  Level-of-detail reduction of the space points in the 3D display
+ * @see    SpacePointLOD.cxx
+ *
+ * The `ISpacePoints3D` tools add one marker per `recob::SpacePoint`, and
+ * events with millions of them make the 3D display unusable. `SpacePointLOD`
+ * merges the space points falling in the same cell of a regular grid into a
+ * single representative point, carrying the average of the quantity the
+ * point color is derived from. The cell size is chosen by the 3D pad to match
+ * a few pixels of the current view.
+ */
+
+#ifndef EVD_SPACEPOINTLOD_H
+#define EVD_SPACEPOINTLOD_H
+
+// LArSoft libraries
+#include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::EventChangeTracker_t
+
+// framework libraries
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <map>
+#include <tuple>
+#include <utility> // std::pair
+#include <vector>
+
+namespace art {
+  class Event;
+}
+namespace recob {
+  class SpacePoint;
+}
+
+namespace evd {
+
+  /**
+   * @brief Merges the space points sharing a cell of the 3D view
+   *
+   * The grid is a linear octree: each space point is assigned the Morton code
+   * of its cell in a fine grid (`kFineCellSize` wide), and the points of each
+   * collection are sorted by that code. The points of any coarser cell, with
+   * a side `2^k` times the fine one, are then contiguous in that order, so the
+   * cells of whatever size the view requires are found in a single pass
+   * without sorting again. The order of a collection spanning a contiguous
+   * range of keys of one data product is computed only the first time it is
+   * drawn in an event; other collections (e.g. associated subsets of points)
+   * are sorted every time.
+   *
+   * `Decimate()` emits all the points of a cell if they are no more than
+   * `MaxPerCell()`, and otherwise a single point at their centroid with the
+   * average of their values. A cell size of `0` disables the merging.
+   *
+   * Example (in a `ISpacePoints3D` tool):
+   *
+   *     std::vector<float> charges; // one per space point, NaN to skip it
+   *     // ...
+   *     for (auto const& point : evd::SpacePointLOD::Instance().Decimate(spts, charges))
+   *       markers[colorOf(point.value)].push_back(point);
+   *
+   * The cache is meant to be used by the drawers in the main thread only.
+   */
+  class SpacePointLOD {
+  public:
+    /// Side of the cells of the finest grid [cm]
+    static constexpr double kFineCellSize = 1. / 16.;
+
+    /// A point representing one or more space points
+    struct Point_t {
+      float x;         ///< centroid of the merged space points [cm]
+      float y;         ///< centroid of the merged space points [cm]
+      float z;         ///< centroid of the merged space points [cm]
+      float value;     ///< average of the values of the merged space points
+      unsigned int n;  ///< number of merged space points
+    }; // Point_t
+
+    /// Sets up the drawing of `evt`, merging in cells of `cellSize` [cm]
+    void Update(art::Event const& evt, double cellSize, unsigned int maxPerCell);
+
+    /**
+     * @brief Returns the points representing `spts`
+     * @param spts the space points to be drawn
+     * @param values the quantity setting the color of each point, `NaN` to skip it
+     * @return the representative points, in cell order
+     */
+    std::vector<Point_t> Decimate(std::vector<art::Ptr<recob::SpacePoint>> const& spts,
+                                  std::vector<float> const& values);
+
+    /// Side of the cells the space points are currently merged in [cm]
+    double CellSize() const { return fCellSize; }
+
+    /// Most points in a cell which are drawn individually
+    unsigned int MaxPerCell() const { return fMaxPerCell; }
+
+    /// Removes all the cached orderings
+    void Clear();
+
+    /// Returns the instance shared by all drawers
+    static SpacePointLOD& Instance();
+
+  private:
+    /// Morton code of the fine cell and index of the space point in the collection
+    using CodedPoint_t = std::pair<std::uint64_t, std::size_t>;
+
+    /// Product, first and last key, and size of a contiguous range of space points
+    using Key_t = std::tuple<art::ProductID, std::size_t, std::size_t, std::size_t>;
+
+    util::EventChangeTracker_t fEvent; ///< event of the cached orderings
+    double fCellSize = 0.;             ///< side of the merging cells [cm]
+    unsigned int fMaxPerCell = 1;      ///< most points drawn individually per cell
+
+    std::map<Key_t, std::vector<CodedPoint_t>> fOrders; ///< space points sorted by cell
+    std::vector<CodedPoint_t> fUncachedOrder;           ///< order of the last uncached points
+
+    /// Returns the points of `spts` sorted by cell, sorting them if needed
+    /// (valid until the next call)
+    std::vector<CodedPoint_t> const& Order(
+      std::vector<art::Ptr<recob::SpacePoint>> const& spts);
+
+    /// Returns the Morton code of the fine cell containing the specified point
+    static std::uint64_t CellCode(double const* xyz);
+
+  }; // class SpacePointLOD
+
+} // namespace evd
+
+#endif // EVD_SPACEPOINTLOD_H
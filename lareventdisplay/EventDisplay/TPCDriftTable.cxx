@@ -0,0 +1,54 @@
+/**
+ * @file   TPCDriftTable.cxx
+ * @brief  Boundaries and drift conversion of all the TPCs, for the drawers
+ * @see    TPCDriftTable.h
+ */
+
+#include "lareventdisplay/EventDisplay/TPCDriftTable.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+
+// C/C++ standard libraries
+#include <utility> // std::swap()
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  TPCDriftTable::TPCDriftTable(geo::GeometryCore const& geom,
+                               detinfo::DetectorPropertiesData const& detProp)
+  {
+    for (geo::TPCGeo const& tpcGeo : geom.Iterate<geo::TPCGeo>()) {
+      geo::TPCID const& tpcid = tpcGeo.ID();
+      geo::PlaneID const planeID(tpcid, 0);
+
+      TPCInfo_t info;
+      info.id = tpcid;
+      info.min = geo::Point_t(tpcGeo.MinX(), tpcGeo.MinY(), tpcGeo.MinZ());
+      info.max = geo::Point_t(tpcGeo.MaxX(), tpcGeo.MaxY(), tpcGeo.MaxZ());
+      info.xAtTick0 = detProp.ConvertTicksToX(0, planeID);
+      info.xTicksCoefficient = detProp.GetXTicksCoefficient(tpcid.TPC, tpcid.Cryostat);
+      info.xTicksOffset = detProp.GetXTicksOffset(0, tpcid.TPC, tpcid.Cryostat);
+      info.driftMinX = info.xAtTick0;
+      info.driftMaxX = info.TickToX(detProp.NumberTimeSamples());
+      if (info.driftMaxX < info.driftMinX) std::swap(info.driftMinX, info.driftMaxX);
+      info.readOutWindowX = info.TickToX(detProp.ReadOutWindowSize());
+
+      fTPCs.push_back(info);
+    }
+  } // TPCDriftTable::TPCDriftTable()
+
+  //----------------------------------------------------------------------------
+  TPCDriftTable::TPCInfo_t const* TPCDriftTable::Find(geo::Point_t const& pos,
+                                                      TPCInfo_t const* hint) const
+  {
+    if (hint && hint->Contains(pos)) return hint;
+    for (TPCInfo_t const& info : fTPCs) {
+      if (info.Contains(pos)) return &info;
+    }
+    return nullptr;
+  } // TPCDriftTable::Find()
+
+} // namespace evd
@@ -0,0 +1,116 @@
+/**
+ * @file   TPCDriftTable.h
+ * @brief  Boundaries and drift conversion of all the TPCs, for the drawers
+ * @see    TPCDriftTable.cxx
+ *
+ * The simulation drawers shift each trajectory point and energy deposit by
+ * the drift distance matching the time of its particle, which requires the
+ * TPC it lies in. `geo::GeometryCore::PositionToTPCID()` throws an exception
+ * for each point outside all TPCs, and the tick-to-x conversion of
+ * `detinfo::DetectorPropertiesData` was repeated for each point.
+ * `TPCDriftTable` collects both once per drawing.
+ */
+
+#ifndef EVD_TPCDRIFTTABLE_H
+#define EVD_TPCDRIFTTABLE_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"   // geo::TPCID
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <vector>
+
+namespace detinfo {
+  class DetectorPropertiesData;
+}
+namespace geo {
+  class GeometryCore;
+}
+
+namespace evd {
+
+  /**
+   * @brief Table of the boundaries and drift coefficients of the TPCs
+   *
+   * The conversion from ticks to drift coordinate is linear on each TPC:
+   * `TickToX()` reproduces `detinfo::DetectorPropertiesData::ConvertTicksToX()`
+   * on the first plane of the TPC.
+   *
+   * `Find()` and `Classify()` never throw: points outside all TPCs are
+   * assigned no TPC (`nullptr`). `Classify()` assigns all the points of a
+   * trajectory at once, trying first the TPC of the previous point, which is
+   * the right one for most of the points of a trajectory.
+   *
+   * Example:
+   *
+   *     evd::TPCDriftTable const tpcTable(*geom, detProp);
+   *     std::vector<evd::TPCDriftTable::TPCInfo_t const*> tpcs;
+   *     auto const trajPoint = [&mcTraj](std::size_t i) {
+   *       return geo::Point_t(mcTraj.X(i), mcTraj.Y(i), mcTraj.Z(i));
+   *     };
+   *     tpcTable.Classify(mcTraj.size(), trajPoint, tpcs);
+   */
+  class TPCDriftTable {
+  public:
+    /// Boundaries and drift information of a TPC
+    struct TPCInfo_t {
+      geo::TPCID id;                 ///< ID of the TPC
+      geo::Point_t min;              ///< lower corner of the TPC box [cm]
+      geo::Point_t max;              ///< upper corner of the TPC box [cm]
+      double xAtTick0 = 0.;          ///< drift coordinate of tick 0 on the first plane [cm]
+      double xTicksCoefficient = 0.; ///< drift coordinate per tick [cm]
+      double xTicksOffset = 0.;      ///< tick offset of the first plane
+      double driftMinX = 0.;         ///< lower drift coordinate of the recorded ticks [cm]
+      double driftMaxX = 0.;         ///< upper drift coordinate of the recorded ticks [cm]
+      double readOutWindowX = 0.;    ///< drift coordinate of the end of the readout window [cm]
+
+      /// Returns the drift coordinate of `ticks` on the first plane [cm]
+      double TickToX(double ticks) const { return xAtTick0 + xTicksCoefficient * ticks; }
+
+      /// Returns whether `pos` is in the TPC box
+      bool Contains(geo::Point_t const& pos) const
+      {
+        return (pos.X() >= min.X()) && (pos.X() <= max.X()) && (pos.Y() >= min.Y()) &&
+               (pos.Y() <= max.Y()) && (pos.Z() >= min.Z()) && (pos.Z() <= max.Z());
+      }
+    }; // TPCInfo_t
+
+    TPCDriftTable(geo::GeometryCore const& geom, detinfo::DetectorPropertiesData const& detProp);
+
+    /// Returns the TPC containing `pos`, or `nullptr` if none does
+    TPCInfo_t const* Find(geo::Point_t const& pos) const { return Find(pos, nullptr); }
+
+    /**
+     * @brief Assigns each of `n` points to its TPC
+     * @param n number of points
+     * @param point `point(i)` returns the `i`-th point, as `geo::Point_t`
+     * @param[out] tpcs the TPC of each point (`nullptr` if outside all TPCs)
+     */
+    template <typename PointOf>
+    void Classify(std::size_t n, PointOf point, std::vector<TPCInfo_t const*>& tpcs) const
+    {
+      tpcs.resize(n);
+      TPCInfo_t const* last = nullptr;
+      for (std::size_t i = 0; i < n; ++i) {
+        TPCInfo_t const* const tpc = Find(point(i), last);
+        tpcs[i] = tpc;
+        if (tpc) last = tpc;
+      }
+    }
+
+    /// Returns the number of TPCs in the table
+    std::size_t size() const { return fTPCs.size(); }
+
+  private:
+    std::vector<TPCInfo_t> fTPCs; ///< all the TPCs of the detector
+
+    /// Returns the TPC containing `pos`, trying `hint` first
+    TPCInfo_t const* Find(geo::Point_t const& pos, TPCInfo_t const* hint) const;
+
+  }; // class TPCDriftTable
+
+} // namespace evd
+
+#endif // EVD_TPCDRIFTTABLE_H
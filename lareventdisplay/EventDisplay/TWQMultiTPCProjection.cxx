@@ -24,6 +24,7 @@
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/DrawTimer.h"
 #include "lareventdisplay/EventDisplay/EvdLayoutOptions.h"
 #include "lareventdisplay/EventDisplay/HeaderPad.h"
 #include "lareventdisplay/EventDisplay/MCBriefPad.h"
@@ -353,11 +354,14 @@ namespace evd {
   {
     fPrevZoomOpt.clear();
 
+    DrawTimer timer("TWQMultiTPCProjectionView", evdb::EventHolder::Instance()->GetEvent());
+
     evdb::Canvas::fCanvas->cd();
     zoom_opt = 0;
     fHeaderPad->Draw();
     fMC->Draw();
     fWireQ->Draw();
+    timer.Lap("header, MC and wire pads");
 
     art::ServiceHandle<evd::EvdLayoutOptions const> evdlayoutopt;
 
@@ -369,12 +373,19 @@ namespace evd {
     // Reset current zooming plane - since it's not currently zooming.
     curr_zooming_plane = -1;
 
+    // the data of all the planes is processed in parallel first;
+    // the graphic objects are then created one plane at a time
+    TWireProjPad::PrepareDraw(fPlanes);
+    timer.Lap("PrepareDraw");
+
     //  double Charge=0, ConvCharge=0;
     for (size_t i = 0; i < fPlanes.size(); ++i) {
       fPlanes[i]->Draw(opt);
       fPlanes[i]->Pad()->Update();
       fPlanes[i]->Pad()->GetFrame()->SetBit(TPad::kCannotMove, true);
+      timer.Lap("plane " + std::to_string(i));
       fPlaneQ[i]->Draw();
+      timer.Lap("charge of plane " + std::to_string(i));
       std::vector<double> ZoomParams = fPlanes[i]->GetCurrentZoom();
       fZoomOpt.wmin[i] = ZoomParams[0];
       fZoomOpt.wmax[i] = ZoomParams[1];
@@ -388,6 +399,7 @@ namespace evd {
     if (fAngleInfo) fAngleInfo->SetForegroundColor(kBlack);
 
     evdb::Canvas::fCanvas->Update();
+    timer.Lap("canvas update");
   }
 
   //......................................................................
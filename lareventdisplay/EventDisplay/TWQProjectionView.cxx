@@ -338,13 +338,6 @@ namespace evd {
     delete fLastEvent;
   }
 
-  //......................................................................
-  void TWQProjectionView::ResetRegionsOfInterest()
-  {
-    for (TWireProjPad* planePad : fPlanes)
-      planePad->RawDataDraw()->ResetRegionOfInterest();
-  } // TWQProjectionView::ResetRegionsOfInterest()
-
   //......................................................................
   void TWQProjectionView::DrawPads(const char* /*opt*/)
   {
@@ -397,6 +390,10 @@ namespace evd {
 
     unsigned int const nPlanes = fPlanes.size();
     MF_LOG_DEBUG("TWQProjectionView") << "Start drawing " << nPlanes << " planes";
+    // the data of all the planes is processed in parallel first;
+    // the graphic objects are then created one plane at a time
+    TWireProjPad::PrepareDraw(fPlanes);
+
     //  double Charge=0, ConvCharge=0;
     for (unsigned int i = 0; i < nPlanes; ++i) {
       TWireProjPad* planePad = fPlanes[i];
@@ -1589,8 +1586,8 @@ namespace evd {
       rawOpt.fCryostat = NewTPC.Cryostat;
       rawOpt.fTPC = NewTPC.TPC;
 
-      // redraw the content
-      ResetRegionsOfInterest();
+      // redraw the content; the drawers recover the regions of interest
+      // they have already found in the new TPC
       DrawPads();
       //  evdb::Canvas::fCanvas->cd();
       //  evdb::Canvas::fCanvas->Modified();
@@ -92,8 +92,6 @@ namespace evd {
     void SetUpPositionFind();
     void SetZoom(int plane, int wirelow, int wirehi, int timelo, int timehi, bool StoreZoom = true);
     void ZoomInterest(bool flag = true);
-    /// Clear all the regions of interest
-    void ResetRegionsOfInterest();
 
     void ZoomBack(); // Revert to the previous zoom setting
     void SetClusterInterest();
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <initializer_list>
 
 #include "TCanvas.h"
 #include "TClass.h"
@@ -20,22 +21,32 @@
 #include "larcore/Geometry/WireReadout.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/Utilities/PxUtils.h"
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RecoBase/Wire.h"
+#include "lareventdisplay/EventDisplay/ChangeTrackers.h" // util::DrawLayerChangeTracker_t
+#include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/DrawTimer.h"
 #include "lareventdisplay/EventDisplay/EvdLayoutOptions.h"
 #include "lareventdisplay/EventDisplay/HitSelector.h"
+#include "lareventdisplay/EventDisplay/PrimitiveBatch2D.h"
 #include "lareventdisplay/EventDisplay/RawDataDrawer.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RecoBaseDrawer.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/SimulationDrawer.h"
+#include "lareventdisplay/EventDisplay/SimulationDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/Style.h"
 #include "lareventdisplay/EventDisplay/TWireProjPad.h"
 #include "nuevdb/EventDisplayBase/EventHolder.h"
 #include "nuevdb/EventDisplayBase/View2D.h"
 
-#include "art/Framework/Principal/fwd.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include "tbb/parallel_for_each.h"
+
 namespace {
 
   template <typename Stream>
@@ -89,10 +100,94 @@ namespace {
     delete pIter;
   } // DumpPadsInCanvas()
 
+  /// Layers of `TWireProjPad`, in drawing order
+  enum DrawLayerIndex_t : std::size_t {
+    kMCTruthLayer,
+    kRawDigitLayer,
+    kWireLayer,
+    kHitLayer,
+    kSliceLayer,
+    kClusterLayer,
+    kEndPointLayer,
+    kProngLayer,
+    kVertexLayer,
+    kSeedLayer,
+    kOpFlashLayer,
+    kEventLayer,
+    kTrackVertexLayer,
+    kNDrawLayers
+  }; // DrawLayerIndex_t
+
+  /// Combines the hash of `value` into `seed`
+  template <typename T>
+  void HashCombine(std::size_t& seed, T const& value)
+  {
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  /// Combines the identity (ID and address) of the products with `labels` into `seed`
+  template <typename T>
+  void HashProducts(std::size_t& seed,
+                    art::Event const& evt,
+                    std::vector<art::InputTag> const& labels)
+  {
+    for (art::InputTag const& label : labels) {
+      art::Handle<std::vector<T>> handle;
+      if (!evt.getByLabel(label, handle)) continue;
+      HashCombine(seed, handle.id().value());
+      HashCombine(seed, static_cast<void const*>(handle.product()));
+    }
+  } // HashProducts()
+
+  /**
+   * @brief Returns the hash of the identity of the products the pads are drawn from
+   *
+   * The raw digits and the calibrated wires which are drawn stand for the
+   * whole event: when an event is loaded, even one with the same ID as the
+   * previous one, they are read anew, and all the layers are redrawn.
+   */
+  std::size_t InputProductsHash(art::Event const& evt)
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
+    std::size_t hash = 0;
+    if (rawOpt->fDrawRawDataOrCalibWires != 1)
+      HashProducts<raw::RawDigit>(hash, evt, rawOpt->fRawDataLabels);
+    if (rawOpt->fDrawRawDataOrCalibWires != 0) {
+      art::ServiceHandle<evd::RecoDrawingOptions const> recoOpt;
+      HashProducts<recob::Wire>(hash, evt, recoOpt->fWireLabels);
+    }
+    return hash;
+  } // InputProductsHash()
+
+  /// Returns the hash of the raw data options, including the ones set by the GUI
+  std::size_t RawOptionsHash()
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
+    std::size_t rawHash = rawOpt->fConfigHash;
+    HashCombine(rawHash, rawOpt->fDrawRawDataOrCalibWires);
+    HashCombine(rawHash, rawOpt->fMinSignal);
+    return rawHash;
+  } // RawOptionsHash()
+
+  /// Returns the hash of the color options, including the ones set by the GUI
+  std::size_t ColorOptionsHash()
+  {
+    art::ServiceHandle<evd::ColorDrawingOptions const> colorOpt;
+    std::size_t colorHash = colorOpt->fConfigHash;
+    HashCombine(colorHash, colorOpt->fColorOrGray);
+    return colorHash;
+  } // ColorOptionsHash()
+
 } // local namespace
 
 namespace evd {
 
+  //......................................................................
+  struct TWireProjPad::DrawLayer_t {
+    evdb::View2D view;                    ///< the graphic objects of the layer
+    util::DrawLayerChangeTracker_t input; ///< what the objects were drawn from
+  };
+
   ///
   /// Create a pad showing a single X-Z or Y-Z projection of the detector
   /// \param nm : Name of the pad
@@ -191,6 +286,8 @@ namespace evd {
     fHisto->Draw("AB");
 
     fView = new evdb::View2D();
+    for (std::size_t iLayer = 0; iLayer < kNDrawLayers; ++iLayer)
+      fLayers.push_back(std::make_unique<DrawLayer_t>());
   }
 
   //......................................................................
@@ -204,8 +301,97 @@ namespace evd {
       delete fView;
       fView = 0;
     }
+    // the batches of the layers go together with their views
+    if (fRecoBaseDraw) {
+      for (auto const& layer : fLayers)
+        fRecoBaseDraw->ReleaseBatches(&layer->view);
+    }
   }
 
+  //......................................................................
+  void TWireProjPad::DrawLayer(std::size_t iLayer,
+                               util::DrawLayerChangeTracker_t const& input,
+                               std::function<void(evdb::View2D*)> const& draw)
+  {
+    DrawLayer_t& layer = *fLayers[iLayer];
+    if (layer.input == input) return; // the retained objects are still good
+
+    MF_LOG_DEBUG("TWireProjPad") << "Redrawing layer #" << iLayer << " of plane " << fPlane
+                                 << " for " << input;
+    layer.input.clear(); // in case drawing fails half way
+    layer.view.Clear();
+    RecoBaseDraw()->Batches(&layer.view).Clear();
+    draw(&layer.view);
+    layer.input = input;
+  } // TWireProjPad::DrawLayer()
+
+  //......................................................................
+  std::size_t TWireProjPad::ZoomHash() const
+  {
+    std::size_t zoomHash = 0;
+    for (double const limit : GetCurrentZoom())
+      HashCombine(zoomHash, limit);
+    HashCombine(zoomHash, fPad->UtoPixel(1.0));
+    HashCombine(zoomHash, fPad->VtoPixel(0.0));
+    HashCombine(zoomHash, GetDrawOptions().bZoom2DdrawToRoI);
+    return zoomHash;
+  } // TWireProjPad::ZoomHash()
+
+  //......................................................................
+  util::DrawLayerChangeTracker_t TWireProjPad::LayerInput(
+    art::Event const& evt,
+    std::size_t productsHash,
+    std::initializer_list<std::size_t> hashes) const
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
+    std::size_t hash = 0;
+    for (std::size_t const h : hashes)
+      HashCombine(hash, h);
+    return {evt, productsHash, geo::PlaneID(rawOpt->CurrentTPC(), fPlane), hash};
+  } // TWireProjPad::LayerInput()
+
+  //......................................................................
+  util::DrawLayerChangeTracker_t TWireProjPad::RawDigitLayerInput(art::Event const& evt,
+                                                                  std::size_t productsHash) const
+  {
+    return LayerInput(evt, productsHash, {RawOptionsHash(), ColorOptionsHash(), ZoomHash()});
+  } // TWireProjPad::RawDigitLayerInput()
+
+  //......................................................................
+  void TWireProjPad::PrepareDraw(std::vector<TWireProjPad*> const& pads)
+  {
+    art::Event const* evtPtr = evdb::EventHolder::Instance()->GetEvent();
+    if (!evtPtr) return;
+    auto const& evt = *evtPtr;
+
+    art::ServiceHandle<evd::RawDrawingOptions const> rawopt;
+    if (rawopt->fDrawRawDataOrCalibWires == 1) return;
+
+    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
+
+    // reading the event and the pad geometry must happen on this thread;
+    // the pads whose raw digit layer is still good will not redraw it
+    std::size_t const productsHash = InputProductsHash(evt);
+    std::vector<TWireProjPad*> toPrepare;
+    for (TWireProjPad* pad : pads) {
+      if (pad->fLayers[kRawDigitLayer]->input == pad->RawDigitLayerInput(evt, productsHash))
+        continue;
+      pad->RawDataDraw()->ExtractRange(pad->fPad, &pad->GetCurrentZoom());
+      if (pad->RawDataDraw()->StartRawDigit2D(evt, detProp, pad->fPlane)) toPrepare.push_back(pad);
+    }
+
+    MF_LOG_DEBUG("TWireProjPad") << "Preparing " << toPrepare.size() << "/" << pads.size()
+                                 << " planes in parallel";
+
+    tbb::parallel_for_each(
+      toPrepare.begin(), toPrepare.end(), [&evt, &detProp](TWireProjPad* pad) {
+        pad->RawDataDraw()->PrepareRawDigit2D(
+          evt, detProp, pad->fPlane, pad->GetDrawOptions().bZoom2DdrawToRoI);
+      });
+  } // TWireProjPad::PrepareDraw()
+
   //......................................................................
   void TWireProjPad::Draw(const char* opt)
   {
@@ -218,6 +404,7 @@ namespace evd {
 
     // grab the singleton holding the art::Event
     art::Event const* evtPtr = evdb::EventHolder::Instance()->GetEvent();
+    DrawTimer timer("TWireProjPad plane " + std::to_string(fPlane), evtPtr);
     if (evtPtr) {
       auto const& evt = *evtPtr;
       auto const clockData =
@@ -225,30 +412,99 @@ namespace evd {
       auto const detProp =
         art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
       art::ServiceHandle<evd::RecoDrawingOptions const> recoOpt;
+      art::ServiceHandle<evd::SimulationDrawingOptions const> simOpt;
+
+      // each layer is redrawn only if the event, its data products, the plane
+      // or the options it depends on have changed; besides the configuration,
+      // a few options are changed directly by the GUI
+      std::size_t const productsHash = InputProductsHash(evt);
+      std::size_t const rawHash = RawOptionsHash();
+      std::size_t const colorHash = ColorOptionsHash();
+      std::size_t simHash = simOpt->fConfigHash;
+      HashCombine(simHash, simOpt->fShowMCTruthVectors);
+      std::size_t const zoomHash = ZoomHash();
+      std::vector<const recob::Hit*> selectedHits;
+      std::size_t selectedHash = 0;
+      if (recoOpt->fUseHitSelector) {
+        selectedHits = HitSelectorGet()->GetSelectedHits(fPlane);
+        for (const recob::Hit* hit : selectedHits)
+          HashCombine(selectedHash, hit);
+      }
 
-      SimulationDraw()->MCTruthVectors2D(evt, fView, fPlane);
+      auto const layerInput = [&](std::initializer_list<std::size_t> hashes) {
+        return LayerInput(evt, productsHash, hashes);
+      };
+      std::size_t const recoHash = recoOpt->fConfigHash;
+
+      timer.Lap("setup");
+
+      DrawLayer(kMCTruthLayer, layerInput({rawHash, simHash}), [&](evdb::View2D* view) {
+        SimulationDraw()->MCTruthVectors2D(evt, view, fPlane);
+      });
+      timer.Lap("MCTruthVectors2D");
 
       // the 2D pads have too much detail to be rendered on screen;
       // to act smarter, RawDataDrawer needs to know the range being plotted
-      RawDataDraw()->ExtractRange(fPad, &GetCurrentZoom());
-      RawDataDraw()->RawDigit2D(evt, detProp, fView, fPlane, GetDrawOptions().bZoom2DdrawToRoI);
-
-      RecoBaseDraw()->Wire2D(evt, fView, fPlane);
-      RecoBaseDraw()->Hit2D(evt, detProp, fView, fPlane);
-
-      if (recoOpt->fUseHitSelector)
-        RecoBaseDraw()->Hit2D(
-          HitSelectorGet()->GetSelectedHits(fPlane), kSelectedColor, fView, true);
-
-      RecoBaseDraw()->Slice2D(evt, detProp, fView, fPlane);
-      RecoBaseDraw()->Cluster2D(evt, clockData, detProp, fView, fPlane);
-      RecoBaseDraw()->EndPoint2D(evt, fView, fPlane);
-      RecoBaseDraw()->Prong2D(evt, clockData, detProp, fView, fPlane);
-      RecoBaseDraw()->Vertex2D(evt, detProp, fView, fPlane);
-      RecoBaseDraw()->Seed2D(evt, detProp, fView, fPlane);
-      RecoBaseDraw()->OpFlash2D(evt, clockData, detProp, fView, fPlane);
-      RecoBaseDraw()->Event2D(evt, fView, fPlane);
-      RecoBaseDraw()->DrawTrackVertexAssns2D(evt, clockData, detProp, fView, fPlane);
+      DrawLayer(
+        kRawDigitLayer, RawDigitLayerInput(evt, productsHash), [&](evdb::View2D* view) {
+          RawDataDraw()->ExtractRange(fPad, &GetCurrentZoom());
+          RawDataDraw()->RawDigit2D(evt, detProp, view, fPlane, GetDrawOptions().bZoom2DdrawToRoI);
+        });
+      timer.Lap("RawDigit2D");
+
+      DrawLayer(kWireLayer,
+                layerInput({rawHash, recoHash, colorHash, zoomHash}),
+                [&](evdb::View2D* view) {
+                  RecoBaseDraw()->ExtractRange(fPad, &GetCurrentZoom());
+                  RecoBaseDraw()->Wire2D(evt, view, fPlane);
+                });
+      timer.Lap("Wire2D");
+
+      DrawLayer(
+        kHitLayer, layerInput({rawHash, recoHash, selectedHash}), [&](evdb::View2D* view) {
+          RecoBaseDraw()->Hit2D(evt, detProp, view, fPlane);
+          if (recoOpt->fUseHitSelector)
+            RecoBaseDraw()->Hit2D(selectedHits, kSelectedColor, view, true);
+        });
+      timer.Lap("Hit2D");
+
+      auto const recoInput = layerInput({rawHash, recoHash});
+      DrawLayer(kSliceLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Slice2D(evt, detProp, view, fPlane);
+      });
+      timer.Lap("Slice2D");
+      DrawLayer(kClusterLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Cluster2D(evt, clockData, detProp, view, fPlane);
+      });
+      timer.Lap("Cluster2D");
+      DrawLayer(kEndPointLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->EndPoint2D(evt, view, fPlane);
+      });
+      timer.Lap("EndPoint2D");
+      DrawLayer(kProngLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Prong2D(evt, clockData, detProp, view, fPlane);
+      });
+      timer.Lap("Prong2D");
+      DrawLayer(kVertexLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Vertex2D(evt, detProp, view, fPlane);
+      });
+      timer.Lap("Vertex2D");
+      DrawLayer(kSeedLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Seed2D(evt, detProp, view, fPlane);
+      });
+      timer.Lap("Seed2D");
+      DrawLayer(kOpFlashLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->OpFlash2D(evt, clockData, detProp, view, fPlane);
+      });
+      timer.Lap("OpFlash2D");
+      DrawLayer(kEventLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->Event2D(evt, view, fPlane);
+      });
+      timer.Lap("Event2D");
+      DrawLayer(kTrackVertexLayer, recoInput, [&](evdb::View2D* view) {
+        RecoBaseDraw()->DrawTrackVertexAssns2D(evt, clockData, detProp, view, fPlane);
+      });
+      timer.Lap("DrawTrackVertexAssns2D");
 
       UpdatePad();
     } // if (evt)
@@ -284,8 +540,19 @@ namespace evd {
     if (opt == 0 && evtPtr) { ShowFull(); }
 
     MF_LOG_DEBUG("TWireProjPad") << "Started rendering plane " << fPlane;
+    timer.Lap("pad setup");
 
+    if (evtPtr) {
+      // the batched hit boxes and lines go below the other primitives of their
+      // layer (markers of vertices, end points, seeds...), as they used to
+      for (auto const& layer : fLayers) {
+        RecoBaseDraw()->Batches(&layer->view).Draw();
+        layer->view.Draw();
+      }
+    }
     fView->Draw();
+    timer.Lap("View2D::Draw");
+    if (timer.isEnabled()) timer.SetPrimitives(fPad->GetListOfPrimitives()->GetSize());
 
     MF_LOG_DEBUG("TWireProjPad") << "Drawing of plane " << fPlane << " completed";
   }
@@ -9,16 +9,24 @@
 #ifndef EVD_TWIREPROJPAD_H
 #define EVD_TWIREPROJPAD_H
 #include "lareventdisplay/EventDisplay/DrawingPad.h"
+#include <cstddef> // std::size_t
+#include <functional>
+#include <initializer_list>
+#include <memory>
 #include <vector>
 
 class TH1F;
 
+namespace art {
+  class Event;
+}
 namespace evdb {
   class View2D;
 }
 
 namespace util {
   class PxLine;
+  class DrawLayerChangeTracker_t;
 }
 
 namespace evd {
@@ -39,6 +47,16 @@ namespace evd {
                  unsigned int plane);
     ~TWireProjPad();
     void Draw(const char* opt = 0);
+
+    /**
+     * @brief Prepares the content of the pads for the next `Draw()`
+     * @param pads the pads to be prepared
+     *
+     * The processing of the raw data that does not involve graphic objects is
+     * run for all the pads in parallel; each pad `Draw()` will then only need
+     * to send the result to its view. Call it from the main thread only.
+     */
+    static void PrepareDraw(std::vector<TWireProjPad*> const& pads);
     void GetWireRange(int* i1, int* i2) const;
     void SetWireRange(int i1, int i2);
 
@@ -85,13 +103,45 @@ namespace evd {
   private:
     /*     void AutoZoom(); */
 
+    /// Graphic objects of one layer of the pad, and what they were drawn from
+    struct DrawLayer_t;
+
+    /**
+     * @brief Redraws a layer with `draw`, unless it was already drawn from `input`
+     * @param iLayer index of the layer in `fLayers`
+     * @param input event, plane and options the layer is going to be drawn from
+     * @param draw function adding the graphic objects to the view of the layer
+     */
+    void DrawLayer(std::size_t iLayer,
+                   util::DrawLayerChangeTracker_t const& input,
+                   std::function<void(evdb::View2D*)> const& draw);
+
+    /// Returns the hash of the current zoom and pad size
+    std::size_t ZoomHash() const;
+
+    /**
+     * @brief Returns the input of a layer of this pad
+     * @param evt the event the layer is drawn from
+     * @param productsHash hash of the identity of the input data products
+     * @param hashes hashes of the options the layer depends on
+     */
+    util::DrawLayerChangeTracker_t LayerInput(art::Event const& evt,
+                                              std::size_t productsHash,
+                                              std::initializer_list<std::size_t> hashes) const;
+
+    /// Returns the input the raw digit layer would be drawn from now
+    util::DrawLayerChangeTracker_t RawDigitLayerInput(art::Event const& evt,
+                                                      std::size_t productsHash) const;
+
   private:
     std::vector<double> fCurrentZoom;
     DrawOptions_t fDrawOpts; ///< set of current draw options
 
     unsigned int fPlane; ///< Which plane in the detector
     TH1F* fHisto;        ///< Histogram to draw object on
-    evdb::View2D* fView; ///< Collection of graphics objects to render
+    evdb::View2D* fView; ///< Graphics objects not in any layer (e.g. lines from the user)
+
+    std::vector<std::unique_ptr<DrawLayer_t>> fLayers; ///< Retained layers, in drawing order
 
     double fXLo; ///< Low  value of x axis
     double fXHi; ///< High value of x axis
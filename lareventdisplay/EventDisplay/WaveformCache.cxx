@@ -0,0 +1,242 @@
+/**
+ * @file   WaveformCache.cxx
+ * @brief  Memory-bounded cache of uncompressed and dense waveforms
+ * @see    WaveformCache.h
+ */
+
+#include "lareventdisplay/EventDisplay/WaveformCache.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/raw.h"
+#include "lardataobj/RecoBase/Wire.h"
+#include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::none_of()
+#include <unordered_set>
+#include <utility> // std::move()
+
+namespace evd {
+
+  //----------------------------------------------------------------------------
+  WaveformCache::SourceID_t WaveformCache::Source(art::EventID const& event,
+                                                  art::ProductID const& product,
+                                                  Kind_t kind)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    SourceInfo_t const info{event, product, kind};
+    auto const iSource = fSources.find(info);
+    if (iSource != fSources.end()) return iSource->second;
+
+    // the sources of old events stay as long as some of their waveforms do
+    PruneSources();
+
+    // the kind of waveform is encoded in the lowest bits of the identifier
+    SourceID_t const newSource = (fNSources++ << 2) | static_cast<SourceID_t>(kind);
+    fSources.emplace(info, newSource);
+    return newSource;
+  } // WaveformCache::Source()
+
+  //----------------------------------------------------------------------------
+  WaveformCache::RawSamplesPtr_t WaveformCache::RawDigitSamples(SourceID_t source,
+                                                                raw::RawDigit const& digit)
+  {
+    // uncompressed data does not need any work: point to it
+    if (digit.Compression() == raw::kNone)
+      return RawSamplesPtr_t(std::shared_ptr<void>(), &digit.ADCs());
+
+    Key_t const key{source, digit.Channel()};
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (Entry_t const* entry = Find(key)) return entry->rawSamples;
+    }
+    bool const withPedestal = (KindOf(source) == Kind_t::RawDigitWithPedestal);
+
+    // the uncompression happens without holding the lock
+    auto samples = std::make_shared<RawSamples_t>(digit.Samples());
+    if (withPedestal)
+      raw::Uncompress(digit.ADCs(), *samples, (int)digit.GetPedestal(), digit.Compression());
+    else
+      raw::Uncompress(digit.ADCs(), *samples, digit.Compression());
+
+    Entry_t entry;
+    entry.key = key;
+    entry.rawSamples = samples;
+    entry.bytes = samples->size() * sizeof(RawSamples_t::value_type);
+    Insert(std::move(entry));
+    return samples;
+  } // WaveformCache::RawDigitSamples()
+
+  //----------------------------------------------------------------------------
+  WaveformCache::RawSamplesPtr_t WaveformCache::FindRawDigitSamples(SourceID_t source,
+                                                                    raw::ChannelID_t channel)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    Entry_t const* entry = Find({source, channel});
+    return entry ? entry->rawSamples : nullptr;
+  } // WaveformCache::FindRawDigitSamples()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::StoreRawDigitSamples(SourceID_t source,
+                                           raw::ChannelID_t channel,
+                                           RawSamplesPtr_t samples)
+  {
+    if (!samples) return;
+    Entry_t entry;
+    entry.key = {source, channel};
+    entry.bytes = samples->size() * sizeof(RawSamples_t::value_type);
+    entry.rawSamples = std::move(samples);
+    Insert(std::move(entry));
+  } // WaveformCache::StoreRawDigitSamples()
+
+  //----------------------------------------------------------------------------
+  WaveformCache::RawSamplesPtr_t WaveformCache::RawDigitSamples(
+    art::Event const& evt,
+    art::Handle<std::vector<raw::RawDigit>> const& digits,
+    raw::RawDigit const& digit,
+    bool withPedestal /* = false */)
+  {
+    Configure();
+    Kind_t const kind = withPedestal ? Kind_t::RawDigitWithPedestal : Kind_t::RawDigit;
+    return RawDigitSamples(Source(evt.id(), digits.id(), kind), digit);
+  } // WaveformCache::RawDigitSamples()
+
+  //----------------------------------------------------------------------------
+  WaveformCache::SignalPtr_t WaveformCache::WireSignal(
+    art::Event const& evt,
+    art::Handle<std::vector<recob::Wire>> const& wires,
+    recob::Wire const& wire)
+  {
+    Configure();
+    Key_t const key{Source(evt.id(), wires.id(), Kind_t::Wire), wire.Channel()};
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (Entry_t const* entry = Find(key)) return entry->signal;
+    }
+
+    auto signal = std::make_shared<Signal_t const>(wire.Signal());
+
+    Entry_t entry;
+    entry.key = key;
+    entry.signal = signal;
+    entry.bytes = signal->size() * sizeof(Signal_t::value_type);
+    Insert(std::move(entry));
+    return signal;
+  } // WaveformCache::WireSignal()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::Configure()
+  {
+    evd::RawDrawingOptions const& rawopt = *art::ServiceHandle<evd::RawDrawingOptions const>();
+    if (fConfigured && (rawopt.fConfigHash == fConfigHash)) return;
+
+    SetMaxBytes(std::size_t(rawopt.fWaveformCacheSize) << 20);
+    fConfigHash = rawopt.fConfigHash;
+    fConfigured = true;
+  } // WaveformCache::Configure()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::SetMaxBytes(std::size_t maxBytes)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (maxBytes == fMaxBytes) return;
+    fMaxBytes = maxBytes;
+    Shrink();
+  } // WaveformCache::SetMaxBytes()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::Clear()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    DropSources();
+  } // WaveformCache::Clear()
+
+  //----------------------------------------------------------------------------
+  WaveformCache& WaveformCache::Instance()
+  {
+    static WaveformCache cache;
+    return cache;
+  } // WaveformCache::Instance()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::DropSources()
+  {
+    if (!fEntries.empty()) {
+      MF_LOG_DEBUG("WaveformCache") << "Dropping " << fEntries.size() << " waveforms from "
+                                    << fSources.size() << " sources";
+    }
+    fIndex.clear();
+    fEntries.clear();
+    fSources.clear();
+    fUsedBytes = 0;
+  } // WaveformCache::DropSources()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::PruneSources()
+  {
+    std::unordered_set<SourceID_t> used;
+    for (Entry_t const& entry : fEntries)
+      used.insert(entry.key.source);
+    for (auto iSource = fSources.begin(); iSource != fSources.end();) {
+      if (used.count(iSource->second) == 0)
+        iSource = fSources.erase(iSource);
+      else
+        ++iSource;
+    } // for
+  } // WaveformCache::PruneSources()
+
+  //----------------------------------------------------------------------------
+  WaveformCache::Entry_t const* WaveformCache::Find(Key_t const& key)
+  {
+    auto const iEntry = fIndex.find(key);
+    if (iEntry == fIndex.end()) return nullptr;
+    // this is now the most recently used
+    fEntries.splice(fEntries.begin(), fEntries, iEntry->second);
+    return &*(iEntry->second);
+  } // WaveformCache::Find()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::Insert(Entry_t&& entry)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (entry.bytes > fMaxBytes) return; // would not fit anyway
+    if (fIndex.count(entry.key) > 0) return; // another thread was faster
+
+    // the source might have been dropped in the meanwhile (e.g. by `Clear()`)
+    auto const isSource = [source = entry.key.source](auto const& s) {
+      return s.second == source;
+    };
+    if (std::none_of(fSources.begin(), fSources.end(), isSource)) return;
+
+    fUsedBytes += entry.bytes;
+    fEntries.push_front(std::move(entry));
+    fIndex.emplace(fEntries.front().key, fEntries.begin());
+    Shrink();
+  } // WaveformCache::Insert()
+
+  //----------------------------------------------------------------------------
+  void WaveformCache::Shrink()
+  {
+    unsigned int nRemoved = 0;
+    while (fUsedBytes > fMaxBytes) {
+      Entry_t const& oldest = fEntries.back();
+      fUsedBytes -= oldest.bytes;
+      fIndex.erase(oldest.key);
+      fEntries.pop_back();
+      ++nRemoved;
+    } // while
+    if (nRemoved > 0) {
+      MF_LOG_DEBUG("WaveformCache") << "Dropped " << nRemoved << " waveforms; " << fEntries.size()
+                                    << " left, using " << fUsedBytes << "/" << fMaxBytes
+                                    << " bytes";
+    }
+  } // WaveformCache::Shrink()
+
+} // namespace evd
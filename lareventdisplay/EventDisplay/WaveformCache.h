@@ -0,0 +1,206 @@
+/**
+ * @file   WaveformCache.h
+ * @brief  Memory-bounded cache of uncompressed and dense waveforms
+ * @see    WaveformCache.cxx
+ *
+ * Raw digits need to be uncompressed and calibrated wires need their regions
+ * of interest expanded into a dense vector before they can be drawn.
+ * The 2D views, the charge histograms and the waveform tools all do that,
+ * and they do it again every time the user clicks on a wire or redraws a
+ * plane. `WaveformCache` keeps the results for all the drawers and tools,
+ * also across events, within a configurable memory budget, dropping the least
+ * recently used waveforms first.
+ */
+
+#ifndef EVD_WAVEFORMCACHE_H
+#define EVD_WAVEFORMCACHE_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "lardataobj/RawData/RawDigit.h"
+
+// framework libraries
+#include "art/Framework/Principal/fwd.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <list>
+#include <map>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace recob {
+  class Wire;
+}
+
+namespace evd {
+
+  /**
+   * @brief Cache of waveforms, keyed by event, data product and channel
+   *
+   * Waveforms are returned as shared pointers, which stay valid even after
+   * the cache drops them. When the memory used by the cached waveforms exceeds
+   * the budget (`RawDrawingOptions` parameter `WaveformCacheSize`), the least
+   * recently used ones are removed from the cache.
+   *
+   * A data product is identified by its event and its product ID: when the
+   * event display reads an event anew, its products hold the same data, and
+   * their waveforms are still good. Waveforms are dropped only when the
+   * memory budget is exceeded, so that going back to an event already seen
+   * does not uncompress its waveforms again.
+   *
+   * The cache is shared (`Instance()`) and can be used from multiple threads,
+   * except for `Configure()` and the methods taking an event, which need
+   * services and must be called on the main thread.
+   */
+  class WaveformCache {
+  public:
+    using RawSamples_t = raw::RawDigit::ADCvector_t; ///< uncompressed raw digit
+    using Signal_t = std::vector<float>;             ///< dense wire signal
+
+    using RawSamplesPtr_t = std::shared_ptr<RawSamples_t const>;
+    using SignalPtr_t = std::shared_ptr<Signal_t const>;
+
+    /// Identifier of an (event, data product, kind of waveform) combination
+    using SourceID_t = std::size_t;
+
+    /// Which kind of waveform a source provides
+    enum class Kind_t {
+      RawDigit,             ///< raw digits, uncompressed without pedestal
+      RawDigitWithPedestal, ///< raw digits, uncompressed with their pedestal
+      Wire                  ///< dense signal of calibrated wires
+    };
+
+    /**
+     * @brief Returns the identifier of the waveforms from the specified product
+     * @param event the event the product belongs to
+     * @param product the ID of the data product
+     * @param kind the kind of waveforms extracted from the product
+     * @return the identifier of the source
+     *
+     * The sources whose waveforms have all been dropped are forgotten when a
+     * new source is added.
+     */
+    SourceID_t Source(art::EventID const& event, art::ProductID const& product, Kind_t kind);
+
+    /**
+     * @brief Returns the uncompressed samples of a raw digit
+     * @param source the data product the digit comes from (from `Source()`)
+     * @param digit the raw digit
+     * @return a pointer to the uncompressed samples
+     *
+     * Samples of digits that are not compressed are not copied nor cached: the
+     * returned pointer refers to the digit itself and is valid only as long as
+     * the digit is.
+     */
+    RawSamplesPtr_t RawDigitSamples(SourceID_t source, raw::RawDigit const& digit);
+
+    /// Returns the cached samples of the raw digit on `channel`, nullptr if none
+    RawSamplesPtr_t FindRawDigitSamples(SourceID_t source, raw::ChannelID_t channel);
+
+    /// Adds to the cache samples of a raw digit uncompressed elsewhere
+    void StoreRawDigitSamples(SourceID_t source, raw::ChannelID_t channel, RawSamplesPtr_t samples);
+
+    /// Returns the uncompressed samples of a raw digit from the `digits` product
+    RawSamplesPtr_t RawDigitSamples(art::Event const& evt,
+                                    art::Handle<std::vector<raw::RawDigit>> const& digits,
+                                    raw::RawDigit const& digit,
+                                    bool withPedestal = false);
+
+    /// Returns the dense signal of a calibrated wire from the `wires` product
+    SignalPtr_t WireSignal(art::Event const& evt,
+                           art::Handle<std::vector<recob::Wire>> const& wires,
+                           recob::Wire const& wire);
+
+    /// Applies the memory budget from `RawDrawingOptions`, if it changed
+    void Configure();
+
+    /// Sets the memory budget of the cache, in bytes (0 disables caching)
+    void SetMaxBytes(std::size_t maxBytes);
+
+    /// Returns the memory budget of the cache, in bytes
+    std::size_t MaxBytes() const { return fMaxBytes; }
+
+    /// Returns the memory used by the cached waveforms, in bytes
+    std::size_t UsedBytes() const { return fUsedBytes; }
+
+    /// Removes all the waveforms from the cache
+    void Clear();
+
+    /// Returns the cache shared by all drawers
+    static WaveformCache& Instance();
+
+  private:
+    /// Identifier of a cached waveform; the source includes the product identity
+    struct Key_t {
+      SourceID_t source;
+      raw::ChannelID_t channel;
+
+      bool operator==(Key_t const& other) const
+      {
+        return (source == other.source) && (channel == other.channel);
+      }
+    }; // Key_t
+
+    struct KeyHash_t {
+      std::size_t operator()(Key_t const& key) const
+      {
+        return std::hash<std::size_t>()(key.source * 0x9E3779B97F4A7C15ULL ^ key.channel);
+      }
+    }; // KeyHash_t
+
+    /// A cached waveform; only one of the pointers is set
+    struct Entry_t {
+      Key_t key;
+      RawSamplesPtr_t rawSamples;
+      SignalPtr_t signal;
+      std::size_t bytes = 0;
+    }; // Entry_t
+
+    using LRUlist_t = std::list<Entry_t>; ///< most recently used first
+
+    /// What a source is made of: event, product ID, kind
+    using SourceInfo_t = std::tuple<art::EventID, art::ProductID, Kind_t>;
+
+    bool fConfigured = false;    ///< whether `Configure()` has been called
+    std::size_t fConfigHash = 0; ///< hash of the configuration applied by `Configure()`
+
+    mutable std::mutex fMutex; ///< protects all the following
+
+    std::size_t fMaxBytes = 0;  ///< memory budget
+    std::size_t fUsedBytes = 0; ///< memory used by the cached waveforms
+
+    LRUlist_t fEntries; ///< all cached waveforms
+    std::unordered_map<Key_t, LRUlist_t::iterator, KeyHash_t> fIndex; ///< waveform look-up
+
+    std::map<SourceInfo_t, SourceID_t> fSources; ///< identifiers of the known sources
+    std::size_t fNSources = 0;                   ///< number of sources ever created
+
+    /// Returns the kind of waveforms of the source (it is encoded in its ID)
+    static Kind_t KindOf(SourceID_t source) { return static_cast<Kind_t>(source & 0x3); }
+
+    /// Drops all the sources and their waveforms
+    void DropSources();
+
+    /// Forgets the sources without any cached waveform
+    void PruneSources();
+
+    /// Returns the cached entry with the key (moving it to front), or nullptr
+    Entry_t const* Find(Key_t const& key);
+
+    /// Adds an entry to the cache and makes room for it within the budget
+    void Insert(Entry_t&& entry);
+
+    /// Removes the least recently used entries until the budget is met
+    void Shrink();
+
+  }; // class WaveformCache
+
+} // namespace evd
+
+#endif // EVD_WAVEFORMCACHE_H
@@ -0,0 +1,133 @@
+/**
+ * @file   WireSignalView.h
+ * @brief  Access to the signal of a calibrated wire without expanding it
+ *
+ * `recob::Wire::Signal()` returns a new, zero-padded vector with one entry per
+ * tick, even if the wire stores only its regions of interest (ROI).
+ * Drawers that only care about the samples in the ROIs, or that can treat the
+ * zero samples in bulk, can use `WireSignalView` to iterate the ROIs directly.
+ */
+
+#ifndef EVD_WIRESIGNALVIEW_H
+#define EVD_WIRESIGNALVIEW_H
+
+// LArSoft libraries
+#include "lardataobj/RecoBase/Wire.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max()
+#include <cstddef>   // std::size_t
+
+namespace evd {
+
+  /**
+   * @brief Read-only view of the signal of a `recob::Wire`
+   *
+   * The view refers to the wire, which must stay valid for as long as the
+   * view is used. Ticks are indices in the full (zero-padded) signal.
+   *
+   * Example: maximum signal in the ticks between 100 and 200:
+   *
+   *     float maxSignal = 0.;
+   *     evd::WireSignalView(wire).forEachROISample(
+   *       [&maxSignal](std::size_t, float value) { maxSignal = std::max(maxSignal, value); },
+   *       100, 200);
+   *
+   */
+  class WireSignalView {
+  public:
+    using RegionsOfInterest_t = recob::Wire::RegionsOfInterest_t;
+
+    explicit WireSignalView(recob::Wire const& wire) : fROIs(wire.SignalROI()) {}
+
+    /// Returns the number of ticks in the full signal
+    std::size_t size() const { return fROIs.size(); }
+
+    /// Returns the regions of interest
+    RegionsOfInterest_t const& ROIs() const { return fROIs; }
+
+    /// Returns the signal at the specified tick (0 out of the ROIs)
+    float operator[](std::size_t tick) const { return fROIs[tick]; }
+
+    /// Returns the number of ticks in [`begin`, `end`) within a ROI
+    std::size_t nROISamples(std::size_t begin = 0, std::size_t end = NoTick) const
+    {
+      std::size_t n = 0;
+      forEachROIRange([&n](std::size_t b, std::size_t e, float const*) { n += e - b; },
+                      begin,
+                      end);
+      return n;
+    }
+
+    /// Returns the number of ticks in [`begin`, `end`) out of any ROI
+    std::size_t nZeroSamples(std::size_t begin = 0, std::size_t end = NoTick) const
+    {
+      end = std::min(end, size());
+      return (begin < end) ? (end - begin - nROISamples(begin, end)) : 0;
+    }
+
+    /**
+     * @brief Calls `op(begin, end, values)` for each ROI in the tick range
+     * @param op callable with `std::size_t`, `std::size_t` and `float const*`
+     * @param begin first tick to include
+     * @param end tick after the last one to include (default: all)
+     *
+     * The ROIs are clipped to the tick range, and `values` points to the
+     * signal at the `begin` tick of the clipped ROI.
+     */
+    template <typename Op>
+    void forEachROIRange(Op&& op, std::size_t begin = 0, std::size_t end = NoTick) const
+    {
+      end = std::min(end, size());
+      for (auto const& range : fROIs.get_ranges()) {
+        std::size_t const rangeBegin = range.begin_index();
+        if (rangeBegin >= end) break;
+        std::size_t const b = std::max(rangeBegin, begin);
+        std::size_t const e = std::min<std::size_t>(range.end_index(), end);
+        if (b >= e) continue;
+        op(b, e, &*range.begin() + (b - rangeBegin));
+      } // for
+    }
+
+    /// Calls `op(tick, value)` for each tick in the range within a ROI
+    template <typename Op>
+    void forEachROISample(Op&& op, std::size_t begin = 0, std::size_t end = NoTick) const
+    {
+      forEachROIRange(
+        [&op](std::size_t b, std::size_t e, float const* values) {
+          for (std::size_t tick = b; tick < e; ++tick)
+            op(tick, *(values++));
+        },
+        begin,
+        end);
+    }
+
+    /// Calls `op(tick, value)` for each tick in the range, including zeros
+    template <typename Op>
+    void forEachSample(Op&& op, std::size_t begin = 0, std::size_t end = NoTick) const
+    {
+      std::size_t tick = begin;
+      forEachROIRange(
+        [&op, &tick](std::size_t b, std::size_t e, float const* values) {
+          for (; tick < b; ++tick)
+            op(tick, 0.F);
+          for (; tick < e; ++tick)
+            op(tick, *(values++));
+        },
+        begin,
+        end);
+      for (end = std::min(end, size()); tick < end; ++tick)
+        op(tick, 0.F);
+    }
+
+    /// Value for the end of tick ranges meaning "up to the end of the signal"
+    static constexpr std::size_t NoTick = static_cast<std::size_t>(-1);
+
+  private:
+    RegionsOfInterest_t const& fROIs; ///< the signal of the wire
+
+  }; // class WireSignalView
+
+} // namespace evd
+
+#endif // EVD_WIRESIGNALVIEW_H
@@ -5,7 +5,9 @@
 
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Wire.h"
+#include "lareventdisplay/EventDisplay/HitIndex.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WireSignalView.h"
 #include "lareventdisplay/EventDisplay/wfHitDrawers/IWFHitDrawer.h"
 
 #include "nuevdb/EventDisplayBase/EventHolder.h"
@@ -16,8 +18,6 @@
 #include "art/Utilities/ToolMacros.h"
 #include "canvas/Persistency/Common/FindManyP.h"
 #include "canvas/Persistency/Common/PtrVector.h"
-#include "cetlib_except/exception.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "TF1.h"
 #include "TPolyLine.h"
@@ -92,40 +92,26 @@ namespace evdb_tool {
       // Step one is to recover the hits for this label that match the input channel
       art::InputTag const which = recoOpt->fHitLabels[imod];
 
-      art::Handle<std::vector<recob::Hit>> hitVecHandle;
-      event->getByLabel(which, hitVecHandle);
+      evd::HitIndex const& hitIndex = evd::HitIndex::Get(*event, which);
 
-      // Get a container for the subset of hits we are drawing
+      // Get a container for the subset of hits we are drawing;
+      // the index sorts them by peak time, since apparently you cannot trust
+      // some hit producers to put the hits in the correct order!
       art::PtrVector<recob::Hit> hitPtrVec;
 
-      try {
-        for (size_t hitIdx = 0; hitIdx < hitVecHandle->size(); hitIdx++) {
-          art::Ptr<recob::Hit> hit(hitVecHandle, hitIdx);
-
-          if (hit->Channel() == channel) hitPtrVec.push_back(hit);
-        }
-      }
-      catch (cet::exception& e) {
-        mf::LogWarning("DrawGausHits") << "DrawGausHits"
-                                       << " failed with message:\n"
-                                       << e;
-      }
+      for (evd::HitIndex::HitEntry_t const& entry : hitIndex.Channel(channel))
+        hitPtrVec.push_back(hitIndex.Ptr(entry));
 
       if (hitPtrVec.empty()) continue;
 
-      // Apparently you cannot trust some hit producers to put the hits in the correct order!
-      std::sort(hitPtrVec.begin(), hitPtrVec.end(), [](const auto& left, const auto& right) {
-        return left->PeakTime() < right->PeakTime();
-      });
-
       // Get associations to wires
       art::FindManyP<recob::Wire> wireAssnsVec(hitPtrVec, *event, which);
-      std::vector<float> wireDataVec;
+      art::Ptr<recob::Wire> hitWire;
 
-      // Recover the full (zero-padded outside ROI's) deconvolved waveform for this wire
+      // Recover the deconvolved waveform for this wire (read in place, no zero padding)
       if (wireAssnsVec.isValid() && wireAssnsVec.size() > 0) {
         auto hwafp = wireAssnsVec.at(0).front();
-        if (!hwafp.isNull() && hwafp.isAvailable()) { wireDataVec = hwafp->Signal(); }
+        if (!hwafp.isNull() && hwafp.isAvailable()) { hitWire = hwafp; }
       }
 
       // Now go through and process the hits back into the hit parameters
@@ -177,7 +163,10 @@ namespace evdb_tool {
         // Include a baseline
         float baseline(0.);
 
-        if (fFloatBaseline && !wireDataVec.empty()) baseline = wireDataVec.at(roiStart);
+        if (fFloatBaseline && hitWire) {
+          evd::WireSignalView const wireData(*hitWire);
+          if (roiStart < wireData.size()) baseline = wireData[size_t(roiStart)];
+        }
 
         funcString += "+" + std::to_string(baseline);
 
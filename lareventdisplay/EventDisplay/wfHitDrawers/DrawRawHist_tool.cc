@@ -5,9 +5,9 @@
 
 #include "larcore/Geometry/WireReadout.h"
 #include "lardataobj/RawData/RawDigit.h"
-#include "lardataobj/RawData/raw.h"
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WaveformCache.h"
 #include "lareventdisplay/EventDisplay/wfHitDrawers/IWaveformDrawer.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalService.h"
@@ -102,8 +102,9 @@ namespace evdb_tool {
             << ".  Pedestals not subtracted.";
         }
 
-        std::vector<short> uncompressed(rawDigit->Samples());
-        raw::Uncompress(rawDigit->ADCs(), uncompressed, rawDigit->Compression());
+        evd::WaveformCache::RawSamplesPtr_t const samples =
+          evd::WaveformCache::Instance().RawDigitSamples(*event, rawDigitVecHandle, *rawDigit);
+        std::vector<short> const& uncompressed = *samples;
 
         TH1F* histPtr = fRawDigitHist.get();
 
@@ -8,6 +8,7 @@
 #include "larcore/Geometry/Geometry.h"
 #include "lardata/ArtDataHelper/MVAReader.h"
 #include "lardataobj/RecoBase/Hit.h"
+#include "lareventdisplay/EventDisplay/HitIndex.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/wfHitDrawers/IWFHitDrawer.h"
@@ -18,7 +19,6 @@
 #include "art/Framework/Principal/Handle.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Utilities/ToolMacros.h"
-#include "canvas/Persistency/Common/PtrVector.h"
 
 #include "TPolyLine.h"
 
@@ -76,30 +76,12 @@ namespace evdb_tool {
     for (size_t imod = 0; imod < recoOpt->fHitLabels.size(); ++imod) {
       art::InputTag const which = recoOpt->fHitLabels[imod];
 
-      art::Handle<std::vector<recob::Hit>> hitVecHandle;
-      event->getByLabel(which, hitVecHandle);
-
-      // Get a container for the subset of hits we are working with and setup to fill it
-      art::PtrVector<recob::Hit> hitPtrVec;
-      bool stillSearching(true);
-      int fitParamsOffset(0);
-
-      // Loop through all hits and find those on the channel in question, also count up to the start of these hits
-      for (size_t hitIdx = 0; hitIdx < hitVecHandle->size(); hitIdx++) {
-        art::Ptr<recob::Hit> hit(hitVecHandle, hitIdx);
-
-        if (hit->Channel() == channel) {
-          hitPtrVec.push_back(hit);
-          stillSearching = false;
-        }
-        else if (!stillSearching)
-          break;
-
-        if (stillSearching) fitParamsOffset++;
-      }
+      // The hits on the channel in question, sorted by peak time
+      evd::HitIndex const& hitIndex = evd::HitIndex::Get(*event, which);
+      evd::HitIndex::Range_t const channelHits = hitIndex.Channel(channel);
 
       // No hits no work
-      if (hitPtrVec.empty()) continue;
+      if (channelHits.empty()) continue;
 
       // The fit parameters will be returned in an auxiliary object
       auto hitResults = anab::FVectorReader<recob::Hit, 4>::create(*event, "dprawhit");
@@ -116,9 +98,9 @@ namespace evdb_tool {
       std::vector<int> hitLocalIdxVec;
 
       // Ok, loop through the hits for this channnel and recover the parameters
-      for (size_t idx = 0; idx < hitPtrVec.size(); ++idx) {
-        const auto& fitParams = fitParamVecs[fitParamsOffset + idx];
-        const auto& hit = hitPtrVec[idx];
+      for (const auto& hit : channelHits) {
+        // the fit parameters are parallel to the hit collection
+        const auto& fitParams = fitParamVecs[hit.index];
 
         hitPeakTimeVec.push_back(fitParams[0]);
         hitTau1Vec.push_back(fitParams[1]);
@@ -5,6 +5,7 @@
 
 #include "lardataobj/RecoBase/Wire.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WaveformCache.h"
 #include "lareventdisplay/EventDisplay/wfHitDrawers/IWaveformDrawer.h"
 
 #include "nuevdb/EventDisplayBase/EventHolder.h"
@@ -83,7 +84,9 @@ namespace evdb_tool {
 
         // Recover a full wire version of the deconvolved wire data
         // (the ROIs don't tend to display well)
-        std::vector<float> signal = wire->Signal();
+        evd::WaveformCache::SignalPtr_t const signalPtr =
+          evd::WaveformCache::Instance().WireSignal(*event, wireVecHandle, *wire);
+        std::vector<float> const& signal = *signalPtr;
 
         TPolyLine& wireWaveform =
           view2D.AddPolyLine(signal.size(), fColorMap[imod % fColorMap.size()], 2, 1);
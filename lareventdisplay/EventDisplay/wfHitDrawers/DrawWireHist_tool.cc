@@ -8,6 +8,7 @@
 #include "lareventdisplay/EventDisplay/ColorDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
 #include "lareventdisplay/EventDisplay/RecoDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/WaveformCache.h"
 #include "lareventdisplay/EventDisplay/wfHitDrawers/IWaveformDrawer.h"
 
 #include "nuevdb/EventDisplayBase/EventHolder.h"
@@ -94,7 +95,9 @@ namespace evdb_tool {
 
         if (wire->Channel() != channel) continue;
 
-        const std::vector<float>& signalVec = wire->Signal();
+        evd::WaveformCache::SignalPtr_t const signal =
+          evd::WaveformCache::Instance().WireSignal(*event, wireVecHandle, *wire);
+        const std::vector<float>& signalVec = *signal;
 
         TH1F* histPtr = fRecoHistMap.at(which.encode()).get();
 
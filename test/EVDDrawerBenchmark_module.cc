@@ -0,0 +1,245 @@
+/**
+ * @file   EVDDrawerBenchmark_module.cc
+ * @brief  Headless benchmark of the 2D drawers of the event display
+ *
+ * For each event, all the planes of the configured TPC are drawn into an
+ * offscreen canvas by the raw data and reconstruction drawers, and each
+ * drawer is timed separately. At the end of the job a summary reports, for
+ * each drawer, the wall time of the first (cold) and of the following (warm)
+ * drawings, the growth of the heap and the number of graphic primitives sent
+ * to the view.
+ *
+ * The drawers take their configuration (data product labels included) from
+ * the usual event display services.
+ */
+
+// LArSoft libraries
+#include "larcore/Geometry/WireReadout.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lareventdisplay/EventDisplay/RawDataDrawer.h"
+#include "lareventdisplay/EventDisplay/PrimitiveBatch2D.h"
+#include "lareventdisplay/EventDisplay/RawDrawingOptions.h"
+#include "lareventdisplay/EventDisplay/RecoBaseDrawer.h"
+#include "nuevdb/EventDisplayBase/View2D.h"
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// ROOT libraries
+#include "TCanvas.h"
+#include "TList.h"
+#include "TROOT.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+  /// Returns the number of bytes currently allocated on the heap
+  long long HeapBytes()
+  {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    return static_cast<long long>(mallinfo2().uordblks);
+#elif defined(__GLIBC__)
+    return static_cast<long long>(mallinfo().uordblks);
+#else
+    return 0; // not supported
+#endif
+  } // HeapBytes()
+
+} // namespace
+
+namespace evd {
+
+  class EVDDrawerBenchmark : public art::EDAnalyzer {
+  public:
+    explicit EVDDrawerBenchmark(fhicl::ParameterSet const& pset);
+
+    void beginJob() override;
+    void analyze(art::Event const& evt) override;
+    void endJob() override;
+
+  private:
+    /// Statistics of one drawer
+    struct DrawerStats_t {
+      unsigned int nCold = 0;       ///< number of first drawings of an event
+      unsigned int nWarm = 0;       ///< number of repeated drawings
+      double coldTime = 0.;         ///< total wall time of first drawings [ms]
+      double warmTime = 0.;         ///< total wall time of repeated drawings [ms]
+      long long heapBytes = 0;      ///< total heap growth [bytes]
+      unsigned long primitives = 0; ///< total graphic primitives
+    }; // DrawerStats_t
+
+    using DrawFunc_t = std::function<void(evdb::View2D*)>;
+
+    unsigned int fRepeat;       ///< how many times each plane is drawn
+    unsigned int fCanvasWidth;  ///< width of the offscreen canvas [pixel]
+    unsigned int fCanvasHeight; ///< height of the offscreen canvas [pixel]
+
+    std::unique_ptr<TCanvas> fCanvas;          ///< the offscreen canvas
+    std::unique_ptr<RawDataDrawer> fRawDraw;   ///< the raw data drawer
+    std::unique_ptr<RecoBaseDrawer> fRecoDraw; ///< the reconstruction drawer
+
+    std::vector<std::string> fDrawerNames;       ///< drawers in order of use
+    std::map<std::string, DrawerStats_t> fStats; ///< statistics by drawer
+
+    /// Sets up the canvas covering the whole plane, and the drawing ranges
+    void SetupCanvas(unsigned int nWires, double startTick, double nTicks);
+
+    /// Draws with `draw` into a new view, and records the statistics
+    void Measure(std::string const& name, bool cold, DrawFunc_t const& draw);
+
+  }; // class EVDDrawerBenchmark
+
+  //----------------------------------------------------------------------------
+  EVDDrawerBenchmark::EVDDrawerBenchmark(fhicl::ParameterSet const& pset)
+    : EDAnalyzer{pset}
+    , fRepeat(pset.get<unsigned int>("Repeat", 3))
+    , fCanvasWidth(pset.get<unsigned int>("CanvasWidth", 1200))
+    , fCanvasHeight(pset.get<unsigned int>("CanvasHeight", 800))
+  {}
+
+  //----------------------------------------------------------------------------
+  void EVDDrawerBenchmark::beginJob()
+  {
+    gROOT->SetBatch(kTRUE);
+    fCanvas =
+      std::make_unique<TCanvas>("EVDDrawerBenchmark", "", (int)fCanvasWidth, (int)fCanvasHeight);
+    fRawDraw = std::make_unique<RawDataDrawer>();
+    fRecoDraw = std::make_unique<RecoBaseDrawer>();
+  } // EVDDrawerBenchmark::beginJob()
+
+  //----------------------------------------------------------------------------
+  void EVDDrawerBenchmark::analyze(art::Event const& evt)
+  {
+    art::ServiceHandle<evd::RawDrawingOptions const> rawOpt;
+    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
+    auto const clockData =
+      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
+
+    geo::TPCID const tpcid(rawOpt->fCryostat, rawOpt->fTPC);
+    for (unsigned int plane = 0; plane < wireReadoutGeom.Nplanes(tpcid); ++plane) {
+      SetupCanvas(wireReadoutGeom.Nwires(geo::PlaneID(tpcid, plane)),
+                  rawOpt->fStartTick,
+                  rawOpt->fTicks);
+
+      for (unsigned int iDraw = 0; iDraw < fRepeat; ++iDraw) {
+        bool const cold = (iDraw == 0);
+
+        // the raw digit drawing split in data preparation and graphics
+        Measure("RawDigit2D (prepare)", cold, [&](evdb::View2D*) {
+          if (fRawDraw->StartRawDigit2D(evt, detProp, plane))
+            fRawDraw->PrepareRawDigit2D(evt, detProp, plane);
+        });
+        Measure("RawDigit2D (QueueDrawingBoxes)", cold, [&](evdb::View2D* view) {
+          fRawDraw->RawDigit2D(evt, detProp, view, plane);
+        });
+        Measure("RawDigit2D", cold, [&](evdb::View2D* view) {
+          fRawDraw->RawDigit2D(evt, detProp, view, plane);
+        });
+        Measure("Wire2D", cold, [&](evdb::View2D* view) { fRecoDraw->Wire2D(evt, view, plane); });
+        Measure(
+          "Hit2D", cold, [&](evdb::View2D* view) { fRecoDraw->Hit2D(evt, detProp, view, plane); });
+        Measure("Cluster2D", cold, [&](evdb::View2D* view) {
+          fRecoDraw->Cluster2D(evt, clockData, detProp, view, plane);
+        });
+      } // for repetitions
+    }   // for planes
+  }     // EVDDrawerBenchmark::analyze()
+
+  //----------------------------------------------------------------------------
+  void EVDDrawerBenchmark::endJob()
+  {
+    mf::LogInfo log("EVDDrawerBenchmark");
+    log << "Drawer benchmark (" << fCanvasWidth << "x" << fCanvasHeight << " pixels, " << fRepeat
+        << " drawings per plane):\n"
+        << std::setw(32) << std::left << "drawer" << std::right << std::setw(14) << "cold [ms]"
+        << std::setw(14) << "warm [ms]" << std::setw(14) << "heap [kB]" << std::setw(14)
+        << "primitives";
+    for (std::string const& name : fDrawerNames) {
+      DrawerStats_t const& stats = fStats.at(name);
+      unsigned int const n = stats.nCold + stats.nWarm;
+      log << "\n"
+          << std::setw(32) << std::left << name << std::right << std::fixed << std::setprecision(3)
+          << std::setw(14) << (stats.nCold ? stats.coldTime / stats.nCold : 0.) << std::setw(14)
+          << (stats.nWarm ? stats.warmTime / stats.nWarm : 0.) << std::setw(14)
+          << (n ? stats.heapBytes / 1024. / n : 0.) << std::setw(14)
+          << (n ? stats.primitives / n : 0UL);
+    } // for
+    log << "\n(averages per drawing of one plane; heap is the growth of allocated memory)";
+
+    fRecoDraw.reset();
+    fRawDraw.reset();
+    fCanvas.reset();
+  } // EVDDrawerBenchmark::endJob()
+
+  //----------------------------------------------------------------------------
+  void EVDDrawerBenchmark::SetupCanvas(unsigned int nWires, double startTick, double nTicks)
+  {
+    fCanvas->cd();
+    fCanvas->Clear();
+    fCanvas->DrawFrame(0., startTick, double(nWires), startTick + nTicks);
+    fCanvas->Update();
+    fRawDraw->ExtractRange(fCanvas.get());
+    fRecoDraw->ExtractRange(fCanvas.get());
+  } // EVDDrawerBenchmark::SetupCanvas()
+
+  //----------------------------------------------------------------------------
+  void EVDDrawerBenchmark::Measure(std::string const& name, bool cold, DrawFunc_t const& draw)
+  {
+    auto [iStats, bNew] = fStats.try_emplace(name);
+    if (bNew) fDrawerNames.push_back(name);
+    DrawerStats_t& stats = iStats->second;
+
+    evdb::View2D view;
+    PrimitiveBatches2D& batches = fRecoDraw->Batches(&view);
+
+    long long const heapBefore = HeapBytes();
+    auto const start = std::chrono::steady_clock::now();
+    draw(&view);
+    auto const stop = std::chrono::steady_clock::now();
+    stats.heapBytes += HeapBytes() - heapBefore;
+
+    double const elapsed = std::chrono::duration<double, std::milli>(stop - start).count();
+    if (cold) {
+      ++stats.nCold;
+      stats.coldTime += elapsed;
+    }
+    else {
+      ++stats.nWarm;
+      stats.warmTime += elapsed;
+    }
+
+    // count what the view and the batches actually send to the pad
+    fCanvas->cd();
+    TList* padPrimitives = fCanvas->GetListOfPrimitives();
+    int const nBefore = padPrimitives->GetSize();
+    view.Draw();
+    batches.Draw();
+    stats.primitives += padPrimitives->GetSize() - nBefore;
+    while (padPrimitives->GetSize() > nBefore) // the view and the drawer still own them
+      padPrimitives->RemoveLast();
+    fRecoDraw->ReleaseBatches(&view); // the next view may have the same address
+  } // EVDDrawerBenchmark::Measure()
+
+} // namespace evd
+
+DEFINE_ART_MODULE(evd::EVDDrawerBenchmark)
@@ -0,0 +1,275 @@
+/**
+ * @file   EVDSyntheticTPCData_module.cc
+ * @brief  Producer of synthetic TPC data for the event display benchmarks
+ *
+ * One raw digit is produced for each channel of the configured geometry, with
+ * gaussian noise on a pedestal and a random number of gaussian pulses.
+ * The pulses (without noise) also become the regions of interest of the
+ * calibrated wires and one hit each; consecutive hits on the same plane are
+ * grouped into clusters.
+ * The result is reproducible for a given seed and event number.
+ */
+
+// LArSoft libraries
+#include "larcore/Geometry/WireReadout.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardata/ArtDataHelper/HitCreator.h"
+#include "lardata/ArtDataHelper/WireCreator.h"
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RawData/raw.h"
+#include "lardataobj/RecoBase/Cluster.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// framework libraries
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/PtrMaker.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace evd {
+
+  class EVDSyntheticTPCData : public art::EDProducer {
+  public:
+    explicit EVDSyntheticTPCData(fhicl::ParameterSet const& pset);
+
+    void produce(art::Event& evt) override;
+
+  private:
+    /// A pulse on a channel
+    struct Pulse_t {
+      float peak;      ///< peak time [ticks]
+      float width;     ///< gaussian width [ticks]
+      float amplitude; ///< peak amplitude [ADC]
+    };
+
+    unsigned int fNTicks;         ///< number of samples per channel
+    float fPedestal;              ///< pedestal of all channels [ADC]
+    float fNoiseRMS;              ///< gaussian noise on each sample [ADC]
+    float fOccupancy;             ///< fraction of channels with pulses
+    unsigned int fMaxPulses;      ///< maximum number of pulses on a channel
+    float fPulseAmplitude;        ///< average amplitude of the pulses [ADC]
+    float fPulseWidth;            ///< average width of the pulses [ticks]
+    unsigned int fHitsPerCluster; ///< hits grouped in each cluster
+    raw::Compress_t fCompression; ///< compression of the raw digits
+    unsigned int fSeed;           ///< seed of the random generator
+
+    /// Returns the compression from its configuration name
+    static raw::Compress_t ParseCompression(std::string const& name);
+
+  }; // class EVDSyntheticTPCData
+
+  //----------------------------------------------------------------------------
+  EVDSyntheticTPCData::EVDSyntheticTPCData(fhicl::ParameterSet const& pset)
+    : EDProducer{pset}
+    , fNTicks(pset.get<unsigned int>("NTicks"))
+    , fPedestal(pset.get<float>("Pedestal", 400.))
+    , fNoiseRMS(pset.get<float>("NoiseRMS", 2.5))
+    , fOccupancy(pset.get<float>("Occupancy"))
+    , fMaxPulses(pset.get<unsigned int>("MaxPulsesPerChannel", 3))
+    , fPulseAmplitude(pset.get<float>("PulseAmplitude", 40.))
+    , fPulseWidth(pset.get<float>("PulseWidth", 4.))
+    , fHitsPerCluster(pset.get<unsigned int>("HitsPerCluster", 20))
+    , fCompression(ParseCompression(pset.get<std::string>("Compression", "huffman")))
+    , fSeed(pset.get<unsigned int>("Seed", 12345))
+  {
+    produces<std::vector<raw::RawDigit>>();
+    produces<std::vector<recob::Wire>>();
+    produces<std::vector<recob::Hit>>();
+    produces<std::vector<recob::Cluster>>();
+    produces<art::Assns<recob::Cluster, recob::Hit>>();
+  } // EVDSyntheticTPCData::EVDSyntheticTPCData()
+
+  //----------------------------------------------------------------------------
+  void EVDSyntheticTPCData::produce(art::Event& evt)
+  {
+    auto const& wireReadoutGeom = art::ServiceHandle<geo::WireReadout const>()->Get();
+
+    std::mt19937 rand(fSeed + evt.event());
+    std::normal_distribution<float> noise(0., fNoiseRMS);
+    std::uniform_real_distribution<float> uniform(0., 1.);
+
+    auto digits = std::make_unique<std::vector<raw::RawDigit>>();
+    auto wires = std::make_unique<std::vector<recob::Wire>>();
+    auto hits = std::make_unique<std::vector<recob::Hit>>();
+    auto clusters = std::make_unique<std::vector<recob::Cluster>>();
+    auto clusterHits = std::make_unique<art::Assns<recob::Cluster, recob::Hit>>();
+
+    unsigned int const nChannels = wireReadoutGeom.Nchannels();
+    digits->reserve(nChannels);
+    wires->reserve(nChannels);
+
+    std::vector<float> signal(fNTicks);
+    std::vector<bool> inROI(fNTicks);
+    std::vector<Pulse_t> pulses;
+    for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+      std::vector<geo::WireID> const wireIDs = wireReadoutGeom.ChannelToWire(channel);
+      if (wireIDs.empty()) continue;
+
+      pulses.clear();
+      if (uniform(rand) < fOccupancy) {
+        unsigned int const nPulses = 1 + (unsigned int)(uniform(rand) * fMaxPulses);
+        for (unsigned int iPulse = 0; iPulse < nPulses; ++iPulse) {
+          pulses.push_back({uniform(rand) * fNTicks,
+                            fPulseWidth * (0.5F + uniform(rand)),
+                            fPulseAmplitude * (0.5F + uniform(rand))});
+        }
+        std::sort(pulses.begin(), pulses.end(), [](Pulse_t const& a, Pulse_t const& b) {
+          return a.peak < b.peak;
+        });
+      } // if pulses
+
+      // the noise-free signal, and the regions of interest 3 widths around pulses
+      std::fill(signal.begin(), signal.end(), 0.F);
+      std::fill(inROI.begin(), inROI.end(), false);
+      for (Pulse_t const& pulse : pulses) {
+        long int const first = std::max(0L, std::lround(pulse.peak - 3.F * pulse.width));
+        long int const last =
+          std::min<long int>(fNTicks, std::lround(pulse.peak + 3.F * pulse.width) + 1);
+        for (long int tick = first; tick < last; ++tick) {
+          float const z = (tick - pulse.peak) / pulse.width;
+          signal[tick] += pulse.amplitude * std::exp(-0.5F * z * z);
+          inROI[tick] = true;
+        }
+      } // for pulses
+
+      raw::RawDigit::ADCvector_t adcs(fNTicks);
+      for (unsigned int tick = 0; tick < fNTicks; ++tick)
+        adcs[tick] = (short)std::lround(fPedestal + signal[tick] + noise(rand));
+      raw::Compress(adcs, fCompression);
+      digits->emplace_back(channel, fNTicks, adcs, fCompression);
+      digits->back().SetPedestal(fPedestal, fNoiseRMS);
+      raw::RawDigit const& digit = digits->back();
+
+      recob::Wire::RegionsOfInterest_t rois(fNTicks);
+      for (unsigned int tick = 0; tick < fNTicks;) {
+        if (!inROI[tick]) {
+          ++tick;
+          continue;
+        }
+        unsigned int const begin = tick;
+        while ((tick < fNTicks) && inROI[tick])
+          ++tick;
+        rois.add_range(begin, signal.begin() + begin, signal.begin() + tick);
+      } // for ticks
+      wires->push_back(recob::WireCreator(std::move(rois), digit).move());
+
+      short int localIndex = 0;
+      for (Pulse_t const& pulse : pulses) {
+        float const integral = pulse.amplitude * pulse.width * std::sqrt(2.F * float(M_PI));
+        raw::TDCtick_t const startTick = std::max(0L, std::lround(pulse.peak - pulse.width));
+        raw::TDCtick_t const endTick =
+          std::min<long int>(fNTicks, std::lround(pulse.peak + pulse.width));
+        hits->push_back(recob::HitCreator(digit,
+                                          wireIDs.front(),
+                                          startTick,
+                                          endTick,
+                                          pulse.width,         // rms
+                                          pulse.peak,          // peak_time
+                                          1.,                  // sigma_peak_time
+                                          pulse.amplitude,     // peak_amplitude
+                                          fNoiseRMS,           // sigma_peak_amplitude
+                                          integral,            // hit_integral
+                                          std::sqrt(integral), // hit_sigma_integral
+                                          integral,            // summedADC
+                                          pulses.size(),       // multiplicity
+                                          localIndex++,        // local_index
+                                          1.,                  // goodness_of_fit
+                                          1)                   // dof
+                          .move());
+      } // for pulses
+    }   // for channels
+
+    // clusters: groups of hits on consecutive wires of the same plane
+    std::vector<std::size_t> hitOrder(hits->size());
+    std::iota(hitOrder.begin(), hitOrder.end(), 0U);
+    std::sort(hitOrder.begin(), hitOrder.end(), [&hits](std::size_t a, std::size_t b) {
+      return (*hits)[a].WireID() < (*hits)[b].WireID();
+    });
+
+    art::PtrMaker<recob::Hit> const makeHitPtr(evt);
+    art::PtrMaker<recob::Cluster> const makeClusterPtr(evt);
+    std::size_t const clusterSize = std::max(fHitsPerCluster, 1U);
+    for (std::size_t iFirst = 0; iFirst < hitOrder.size();) {
+      geo::PlaneID const planeID = (*hits)[hitOrder[iFirst]].WireID().planeID();
+      std::size_t iEnd = iFirst;
+      while ((iEnd < hitOrder.size()) && (iEnd - iFirst < clusterSize) &&
+             ((*hits)[hitOrder[iEnd]].WireID().planeID() == planeID))
+        ++iEnd;
+
+      recob::Hit const& first = (*hits)[hitOrder[iFirst]];
+      recob::Hit const& last = (*hits)[hitOrder[iEnd - 1]];
+      float integral = 0.;
+      for (std::size_t i = iFirst; i < iEnd; ++i)
+        integral += (*hits)[hitOrder[i]].Integral();
+
+      clusters->emplace_back(first.WireID().Wire,    // start_wire
+                             0.,                     // sigma_start_wire
+                             first.PeakTime(),       // start_tick
+                             first.SigmaPeakTime(),  // sigma_start_tick
+                             first.Integral(),       // start_charge
+                             0.,                     // start_angle
+                             0.,                     // start_opening
+                             last.WireID().Wire,     // end_wire
+                             0.,                     // sigma_end_wire
+                             last.PeakTime(),        // end_tick
+                             last.SigmaPeakTime(),   // sigma_end_tick
+                             last.Integral(),        // end_charge
+                             0.,                     // end_angle
+                             0.,                     // end_opening
+                             integral,               // integral
+                             0.,                     // integral_stddev
+                             integral,               // summedADC
+                             0.,                     // summedADC_stddev
+                             iEnd - iFirst,          // n_hits
+                             1.,                     // multiple_hit_density
+                             1.,                     // width
+                             clusters->size(),       // ID
+                             wireReadoutGeom.Plane(planeID).View(),
+                             planeID);
+
+      art::Ptr<recob::Cluster> const clusterPtr = makeClusterPtr(clusters->size() - 1);
+      for (std::size_t i = iFirst; i < iEnd; ++i)
+        clusterHits->addSingle(clusterPtr, makeHitPtr(hitOrder[i]));
+      iFirst = iEnd;
+    } // for clusters
+
+    mf::LogInfo("EVDSyntheticTPCData")
+      << "Event " << evt.id() << ": " << digits->size() << " raw digits with " << fNTicks
+      << " ticks, " << hits->size() << " hits, " << clusters->size() << " clusters";
+
+    evt.put(std::move(digits));
+    evt.put(std::move(wires));
+    evt.put(std::move(hits));
+    evt.put(std::move(clusters));
+    evt.put(std::move(clusterHits));
+  } // EVDSyntheticTPCData::produce()
+
+  //----------------------------------------------------------------------------
+  raw::Compress_t EVDSyntheticTPCData::ParseCompression(std::string const& name)
+  {
+    if (name == "none") return raw::kNone;
+    if (name == "huffman") return raw::kHuffman;
+    throw cet::exception("EVDSyntheticTPCData")
+      << "Compression '" << name << "' not supported (use 'none' or 'huffman')\n";
+  } // EVDSyntheticTPCData::ParseCompression()
+
+} // namespace evd
+
+DEFINE_ART_MODULE(evd::EVDSyntheticTPCData)